@@ -10,11 +10,13 @@
 #include "FileData.h"
 #include "FileFilterIndex.h"
 #include "Gamelist.h"
+#include "GamelistWriter.h"
 #include "Log.h"
 #include "Settings.h"
 #include "SystemData.h"
 #include "ThemeData.h"
 #include <pugixml.hpp>
+#include <chrono>
 #include <fstream>
 #include <cstring>
 
@@ -113,21 +115,12 @@ bool CollectionSystemManager::saveCustomCollection(SystemData* sys)
 	CollectionSystemData sysData = mCustomCollectionSystemsData.at(name);
 	if (sysData.needsSave)
 	{
-		std::string absCollectionFn = getCustomCollectionConfigPath(name);
-		std::ofstream configFile;
-		configFile.open(absCollectionFn);
-		if (!configFile.good())
-		{
-			auto const errNo = errno;
-			LOG(LogError) << "Failed to create file, collection not created: " << absCollectionFn << ": " <<  std::strerror(errNo) << " (" << errNo <<  ")";
-			return false;
-		}
+		// RetroPangui: 목록만 만들어 넘기고 파일 쓰기(.tmp -> rename)는 GamelistWriter 스레드에서.
+		// 실패는 GamelistWriter::flush()의 결과로 알 수 있음
+		std::string content;
 		for(std::unordered_map<std::string, FileData*>::const_iterator iter = games.cbegin(); iter != games.cend(); ++iter)
-		{
-			std::string path =  iter->first;
-			configFile << path << std::endl;
-		}
-		configFile.close();
+			content += iter->first + "\n";
+		GamelistWriter::getInstance()->queueFile(getCustomCollectionConfigPath(name), content);
 	}
 	return true;
 }
@@ -236,84 +229,120 @@ void CollectionSystemManager::refreshCollectionSystems(FileData* file)
 	if (!file->getSystem()->isGameSystem() || file->getType() != GAME)
 		return;
 
-	std::map<std::string, CollectionSystemData> allCollections;
-	allCollections.insert(mAutoCollectionSystemsData.cbegin(), mAutoCollectionSystemsData.cend());
-	allCollections.insert(mCustomCollectionSystemsData.cbegin(), mCustomCollectionSystemsData.cend());
+	// RetroPangui: 변경 이벤트(실행/즐겨찾기/메타데이터 편집) 하나당 소요 시간 - 대형 라이브러리 벤치마크용
+	const auto startTs = std::chrono::steady_clock::now();
 
-	for(auto sysDataIt = allCollections.cbegin(); sysDataIt != allCollections.cend(); sysDataIt++)
-	{
+	for(auto sysDataIt = mAutoCollectionSystemsData.cbegin(); sysDataIt != mAutoCollectionSystemsData.cend(); sysDataIt++)
 		updateCollectionSystem(file, sysDataIt->second);
+	for(auto sysDataIt = mCustomCollectionSystemsData.cbegin(); sysDataIt != mCustomCollectionSystemsData.cend(); sysDataIt++)
+	{
+		// auto collections take precedence over a custom collection with the same name
+		if (mAutoCollectionSystemsData.find(sysDataIt->first) == mAutoCollectionSystemsData.cend())
+			updateCollectionSystem(file, sysDataIt->second);
 	}
+
+	const long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTs).count();
+	mRefreshCount++;
+	mRefreshTotalUs += elapsedUs;
+	LOG(LogDebug) << "refreshCollectionSystems: \"" << file->getName() << "\" in " << elapsedUs << " us (avg " << mRefreshTotalUs / mRefreshCount << " us over " << mRefreshCount << " updates)";
 }
 
-void CollectionSystemManager::updateCollectionSystem(FileData* file, CollectionSystemData sysData)
+// RetroPangui: 전체 재정렬/뷰 재생성 대신 항목 하나만 갱신한다 - 필터 인덱스는 그 항목만 뺐다 넣고,
+// 정렬 위치는 FileData::resortChild()로 옮긴다(메타데이터를 새로 읽기 전에 이전 정렬 키로 현재 자리를,
+// 읽은 뒤 새 자리를 이진 탐색 - 옮기는 건 memmove 한 번이라 전체 정렬보다 훨씬 쌈). 목록 순서가 바뀐 경우에만 뷰를 다시 채우고, 순서가 그대로면
+// 그 항목만 알려 캐시된 뷰의 별표/이름 등을 바로 반영한다.
+void CollectionSystemManager::updateCollectionSystem(FileData* file, const CollectionSystemData& sysData)
 {
-	if (sysData.isPopulated)
-	{
-		// collection files use the full path as key, to avoid clashes
-		std::string key = file->getFullPath();
-
-		SystemData* curSys = sysData.system;
-		const std::unordered_map<std::string, FileData*>& children = curSys->getRootFolder()->getChildrenByFilename();
-		bool found = children.find(key) != children.cend();
-		FileData* rootFolder = curSys->getRootFolder();
-		FileFilterIndex* fileIndex = curSys->getIndex();
-		std::string name = curSys->getName();
-
-		if (found) {
-			// if we found it, we need to update it
-			FileData* collectionEntry = children.at(key);
-			// remove from index, so we can re-index metadata after refreshing
-			fileIndex->removeFromIndex(collectionEntry);
-			collectionEntry->refreshMetadata();
-			// found and we are removing
-			if (name == "favorites" && file->metadata.get("favorite") == "false") {
-				// need to check if still marked as favorite, if not remove
-				ViewController::get()->getGameListView(curSys).get()->remove(collectionEntry, false, true);
-			}
-			else
-			{
-				// re-index with new metadata
-				fileIndex->addToIndex(collectionEntry);
-				ViewController::get()->onFileChanged(collectionEntry, FILE_METADATA_CHANGED);
-			}
+	if (!sysData.isPopulated)
+		return;
+
+	// collection files use the full path as key, to avoid clashes
+	const std::string& key = file->getPath();
+
+	SystemData* curSys = sysData.system;
+	FileData* rootFolder = curSys->getRootFolder();
+	const std::unordered_map<std::string, FileData*>& children = rootFolder->getChildrenByFilename();
+	auto found = children.find(key);
+	FileFilterIndex* fileIndex = curSys->getIndex();
+	const std::string& name = curSys->getName();
+
+	const ViewController::State& state = ViewController::get()->getState();
+	const bool isCurrentView = state.viewing == ViewController::GAME_LIST && state.getSystem() == getSystemToView(curSys);
+
+	if (!rootFolder->isSorted())
+		rootFolder->sort(getSortTypeFromString(mCollectionSystemDeclsIndex[name].defaultSort));
+
+	bool orderChanged = false;
+	if (found != children.cend()) {
+		// if we found it, we need to update it
+		FileData* collectionEntry = found->second;
+		// remove from index, so we can re-index metadata after refreshing
+		fileIndex->removeFromIndex(collectionEntry);
+		// the entry's snapshot still holds the keys it was sorted by
+		const int position = rootFolder->findSortedChild(collectionEntry);
+		collectionEntry->refreshMetadata();
+		// found and we are removing
+		if (name == "favorites" && file->metadata.get("favorite") == "false") {
+			// need to check if still marked as favorite, if not remove
+			ViewController::get()->getGameListView(curSys).get()->remove(collectionEntry, false, true);
+			return;
 		}
-		else
+
+		// re-index with new metadata
+		fileIndex->addToIndex(collectionEntry);
+		orderChanged = rootFolder->resortChild(collectionEntry, position);
+		if (!orderChanged || (isCurrentView && name != "recent"))
 		{
-			// we didn't find it here - we need to check if we should add it
-			if (name == "recent" && file->metadata.get("playcount") > "0" && includeFileInAutoCollections(file) ||
-				name == "favorites" && file->metadata.get("favorite") == "true") {
-				CollectionFileData* newGame = new CollectionFileData(file, curSys);
-				rootFolder->addChild(newGame);
-				fileIndex->addToIndex(newGame);
-				ViewController::get()->onFileChanged(file, FILE_METADATA_CHANGED);
-				ViewController::get()->getGameListView(curSys)->onFileChanged(newGame, FILE_METADATA_CHANGED);
-			}
+			// no-op if this collection has no view yet; rebuilding the current view also picks up the new order
+			ViewController::get()->onFileChanged(collectionEntry, FILE_METADATA_CHANGED);
+			return;
 		}
-		rootFolder->sort(getSortTypeFromString(mCollectionSystemDeclsIndex[name].defaultSort));
-		if (name == "recent")
-		{
-			trimCollectionCount(rootFolder, LAST_PLAYED_MAX, false);
-			ViewController::get()->onFileChanged(rootFolder, FILE_METADATA_CHANGED);
-			// Force re-calculation of cursor position
-			ViewController::get()->getGameListView(curSys)->setViewportTop(TextListComponent<FileData>::REFRESH_LIST_CURSOR_POS);
+	}
+	else
+	{
+		// we didn't find it here - we need to check if we should add it
+		if (name == "recent" && file->metadata.get("playcount") > "0" && includeFileInAutoCollections(file) ||
+			name == "favorites" && file->metadata.get("favorite") == "true") {
+			CollectionFileData* newGame = new (curSys->getFileArena()) CollectionFileData(file, curSys);
+			rootFolder->addChild(newGame);
+			fileIndex->addToIndex(newGame);
+			rootFolder->resortChild(newGame, (int)rootFolder->getChildren().size() - 1);
+			orderChanged = true;
 		}
-		else
-			ViewController::get()->onFileChanged(rootFolder, FILE_SORTED);
 	}
+
+	if (!orderChanged)
+		return;
+
+	if (name == "recent")
+	{
+		trimCollectionCount(rootFolder, LAST_PLAYED_MAX, false);
+		ViewController::get()->onFileChanged(rootFolder, FILE_METADATA_CHANGED);
+		// Force re-calculation of cursor position
+		ViewController::get()->getGameListView(curSys)->setViewportTop(TextListComponent<FileData>::REFRESH_LIST_CURSOR_POS);
+	}
+	else
+		ViewController::get()->onFileChanged(rootFolder, FILE_SORTED);
 }
 
 void CollectionSystemManager::trimCollectionCount(FileData* rootFolder, int limit, bool shuffle)
 {
 	SystemData* curSys = rootFolder->getSystem();
-	while ((int)rootFolder->getChildrenListToDisplay().size() > limit)
+	int excess = (int)rootFolder->getChildrenListToDisplay().size() - limit;
+	if (excess > 0)
 	{
+		// build the candidate list once and drop from its end
 		std::vector<FileData*> games = rootFolder->getFilesRecursive(GAME, true);
 		if (shuffle)
 			std::shuffle(games.begin(), games.end(), SystemData::sURNG);
 
-		CollectionFileData* gameToRemove = (CollectionFileData*)games.back();
-		ViewController::get()->getGameListView(curSys).get()->remove(gameToRemove, false, false);
+		std::shared_ptr<IGameListView> view = ViewController::get()->getGameListView(curSys);
+		for ( ; excess > 0 && !games.empty(); excess--)
+		{
+			CollectionFileData* gameToRemove = (CollectionFileData*)games.back();
+			games.pop_back();
+			view->remove(gameToRemove, false, false);
+		}
 	}
 	ViewController::get()->onFileChanged(rootFolder, FILE_REMOVED);
 }
@@ -533,7 +562,7 @@ bool CollectionSystemManager::toggleGameInCollection(FileData* file)
 			else
 			{
 				// we didn't find it here, we should add it
-				CollectionFileData* newGame = new CollectionFileData(file, sysData);
+				CollectionFileData* newGame = new (sysData->getFileArena()) CollectionFileData(file, sysData);
 				rootFolder->addChild(newGame);
 				fileIndex->addToIndex(newGame);
 				// this is the biggest performance bottleneck for this process.
@@ -571,9 +600,10 @@ bool CollectionSystemManager::toggleGameInCollection(FileData* file)
 			}
 			file->getSourceFileData()->getSystem()->getIndex()->addToIndex(file);
 
-			// RetroPangui: Always save favorite changes to gamelist.xml immediately
+			// RetroPangui: Always save favorite changes immediately
 			// Don't rely on SaveGamelistsMode setting for user-initiated favorite toggles
-			updateGamelist(file->getSourceFileData()->getSystem());
+			// (gamelist.xml 저널에 한 줄 덧붙임 - 전체 재작성은 유휴 시간에)
+			file->getSourceFileData()->getSystem()->journalMetaData(file->getSourceFileData(), { "favorite" }, true);
 
 			refreshCollectionSystems(file->getSourceFileData());
 
@@ -835,7 +865,7 @@ void CollectionSystemManager::addRandomGames(SystemData* newSys, SystemData* sou
 	}
 
 	// load exclusion collection
-	std::unordered_map<std::string,FileData*> exclusionMap;
+	const std::unordered_map<std::string,FileData*>* exclusionMap = NULL;
 	std::string exclusionCollection = Settings::getInstance()->getString("RandomCollectionExclusionCollection");
 	auto sysDataIt = mCustomCollectionSystemsData.find(exclusionCollection);
 
@@ -845,14 +875,15 @@ void CollectionSystemManager::addRandomGames(SystemData* newSys, SystemData* sou
 			populateCustomCollection(&(sysDataIt->second));
 		}
 
-		exclusionMap = mCustomCollectionSystemsData[exclusionCollection].system->getRootFolder()->getChildrenByFilename();
+		exclusionMap = &sysDataIt->second.system->getRootFolder()->getChildrenByFilename();
 
 	}
 
 	// we do this to avoid trying to add more games than there are in the system
-	gamesForSourceSystem = Math::min(gamesForSourceSystem, sourceSystem->getRootFolder()->getFilesRecursive(GAME).size());
+	gamesForSourceSystem = Math::min(gamesForSourceSystem, (int)sourceSystem->getRootFolder()->getGameCount());
 
-	int startCount = rootFolder->getFilesRecursive(GAME).size();
+	// collection root folders are flat, so the child count is the game count
+	int startCount = rootFolder->getChildren().size();
 	int endCount = startCount + gamesForSourceSystem;
 	int retryCount = 10;
 
@@ -861,15 +892,15 @@ void CollectionSystemManager::addRandomGames(SystemData* newSys, SystemData* sou
 		FileData* randomGame = sourceSystem->getRandomGame()->getSourceFileData();
 		CollectionFileData* newGame = NULL;
 
-		if(exclusionMap.find(randomGame->getFullPath()) == exclusionMap.end())
+		if(exclusionMap == NULL || exclusionMap->find(randomGame->getFullPath()) == exclusionMap->end())
 		{
 			// Not in the exclusion collection
-			newGame = new CollectionFileData(randomGame, newSys);
+			newGame = new (newSys->getFileArena()) CollectionFileData(randomGame, newSys);
 			rootFolder->addChild(newGame);
 			index->addToIndex(newGame);
 		}
 
-		if (rootFolder->getFilesRecursive(GAME).size() > iterCount)
+		if ((int)rootFolder->getChildren().size() > iterCount)
 		{
 			// added game, proceed
 			iterCount++;
@@ -931,6 +962,7 @@ void CollectionSystemManager::populateRandomCollectionFromCollections(std::map<s
 // populates an Automatic Collection System
 void CollectionSystemManager::populateAutoCollection(CollectionSystemData* sysData)
 {
+	const auto startTs = std::chrono::steady_clock::now();
 	SystemData* newSys = sysData->system;
 	CollectionSystemDecl sysDecl = sysData->decl;
 	FileData* rootFolder = newSys->getRootFolder();
@@ -983,7 +1015,7 @@ void CollectionSystemManager::populateAutoCollection(CollectionSystemData* sysDa
 
 					if (include)
 					{
-						CollectionFileData* newGame = new CollectionFileData(*gameIt, newSys);
+						CollectionFileData* newGame = new (newSys->getFileArena()) CollectionFileData(*gameIt, newSys);
 						rootFolder->addChild(newGame);
 						index->addToIndex(newGame);
 					}
@@ -1010,6 +1042,8 @@ void CollectionSystemManager::populateAutoCollection(CollectionSystemData* sysDa
 	}
 
 	sysData->isPopulated = true;
+	LOG(LogDebug) << "populateAutoCollection: \"" << newSys->getName() << "\" " << rootFolder->getChildren().size() << " games in "
+		<< std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTs).count() << " ms";
 }
 
 // populates a Custom Collection System
@@ -1033,7 +1067,7 @@ void CollectionSystemManager::populateCustomCollection(CollectionSystemData* sys
 	std::ifstream input(path);
 
 	// get all files map
-	std::unordered_map<std::string,FileData*> allFilesMap = getAllGamesCollection()->getRootFolder()->getChildrenByFilename();
+	const std::unordered_map<std::string,FileData*>& allFilesMap = getAllGamesCollection()->getRootFolder()->getChildrenByFilename();
 
 	// iterate list of files in config file
 	for(std::string gameKey; getline(input, gameKey); )
@@ -1041,7 +1075,7 @@ void CollectionSystemManager::populateCustomCollection(CollectionSystemData* sys
 		std::unordered_map<std::string,FileData*>::const_iterator it = allFilesMap.find(gameKey);
 		if (it != allFilesMap.cend())
 		{
-			CollectionFileData* newGame = new CollectionFileData(it->second, newSys);
+			CollectionFileData* newGame = new (newSys->getFileArena()) CollectionFileData(it->second, newSys);
 			rootFolder->addChild(newGame);
 			index->addToIndex(newGame);
 		}
@@ -83,7 +83,7 @@ public:
 	void updateSystemsList();
 
 	void refreshCollectionSystems(FileData* file);
-	void updateCollectionSystem(FileData* file, CollectionSystemData sysData);
+	void updateCollectionSystem(FileData* file, const CollectionSystemData& sysData);
 	void deleteCollectionFiles(FileData* file);
 	void recreateCollection(SystemData* sysData);
 
@@ -122,6 +122,9 @@ private:
 	std::string mEditingCollection;
 	CollectionSystemData* mEditingCollectionSystemData;
 	Uint32 mFirstPressMs = 0;
+	// refreshCollectionSystems() timing, logged per update
+	long long mRefreshCount = 0;
+	long long mRefreshTotalUs = 0;
 
 	void initAutoCollectionSystems();
 	void initCustomCollectionSystems();
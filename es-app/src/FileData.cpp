@@ -3,14 +3,17 @@
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
 #include "utils/TimeUtil.h"
+#include "views/ViewController.h"
 #include "AudioManager.h"
 #include "MusicManager.h"
 #include "CollectionSystemManager.h"
+#include "FileDataArena.h"
 #include "FileFilterIndex.h"
 #include "FileSorts.h"
 #include "InputManager.h"
 #include "Log.h"
 #include "MameNames.h"
+#include "MediaIndex.h"
 #include "platform.h"
 #include "Scripting.h"
 #include "Settings.h"
@@ -22,40 +25,77 @@
 #include <algorithm>
 #include <functional>
 #include <pugixml.hpp>
+#include <SDL_timer.h>
+#include <thread>
 
 FileData::FileData(FileType type, const std::string& path, SystemEnvironmentData* envData, SystemData* system)
 	: mType(type), mPath(path), mSystem(system), mEnvData(envData), mSourceFileData(NULL), mParent(NULL), metadata(type == GAME ? GAME_METADATA : FOLDER_METADATA) // metadata is REALLY set in the constructor!
 {
+	mDisplayName = Utils::FileSystem::getStem(mPath);
+	if(mSystem && (mSystem->hasPlatformId(PlatformIds::ARCADE) || mSystem->hasPlatformId(PlatformIds::NEOGEO)))
+		mDisplayName = MameNames::getInstance()->getRealName(mDisplayName);
+
 	// metadata needs at least a name field (since that's what getName() will return)
 	if(metadata.get("name").empty())
-		metadata.set("name", getDisplayName());
-	mSystemName = system->getName();
+		metadata.set("name", mDisplayName);
 	metadata.resetChangedFlag();
+	metadata.setOwner(this);
+
+	if(mType == FOLDER)
+		mAggregates.reset(new Aggregates());
 }
 
 FileData::~FileData()
 {
-	if(mParent)
+	// 부모가 같은 아레나와 함께 내려가는 중이면 떼어 낼 필요 없음 (다른 시스템 소속 부모 - 컬렉션 번들 등 - 에서는 뗀다)
+	if(mParent && !FileDataArena::isReleasing(mParent))
 		mParent->removeChild(this);
 
+	// 시스템 전체를 내리는 중: 인덱스/최근 목록도 곧 같이 사라짐
+	if(FileDataArena::isReleasing(this))
+		return;
+
 	if(mType == GAME)
+	{
 		mSystem->getIndex()->removeFromIndex(this);
+		mSystem->getMediaIndex()->removeFromIndex(this);
+		mSystem->removeRecentGame(this);
+	}
 
 	mChildren.clear();
 }
 
-std::string FileData::getDisplayName() const
+void* FileData::operator new(size_t size)
 {
-	std::string stem = Utils::FileSystem::getStem(mPath);
-	if(mSystem && (mSystem->hasPlatformId(PlatformIds::ARCADE) || mSystem->hasPlatformId(PlatformIds::NEOGEO)))
-		stem = MameNames::getInstance()->getRealName(stem);
+	return FileDataArena::allocate(NULL, size);
+}
+
+void* FileData::operator new(size_t size, FileDataArena* arena)
+{
+	return FileDataArena::allocate(arena, size);
+}
+
+void FileData::operator delete(void* ptr)
+{
+	FileDataArena::deallocate(ptr);
+}
+
+void FileData::operator delete(void* ptr, FileDataArena* /*arena*/)
+{
+	FileDataArena::deallocate(ptr);
+}
 
-	return stem;
+// 노드마다 시스템 이름을 복사해 두지 않고 원본(컬렉션 항목이면 원래 게임) 시스템에서 읽음
+std::string FileData::getSystemName() const
+{
+	return (mSourceFileData != NULL ? mSourceFileData->mSystem : mSystem)->getName();
 }
 
-std::string FileData::getCleanName() const
+const std::string& FileData::getCleanName() const
 {
-	return Utils::String::removeParenthesis(this->getDisplayName());
+	if(mCleanName.empty())
+		mCleanName = Utils::String::removeParenthesis(mDisplayName);
+	return mCleanName;
 }
 
 const std::string FileData::getThumbnailPath() const
@@ -117,10 +157,17 @@ const std::string& FileData::getSortName()
 		return metadata.get("sortname");
 }
 
+// RetroPangui: ShowFolders가 실제로 바뀔 때마다 증가 - 폴더마다 설정 문자열을 들고 비교하던 것 대신
+static unsigned int sShowFoldersGeneration = 0;
+static unsigned int sTreeGeneration = 0;
+
 const std::vector<FileData*>& FileData::getChildrenListToDisplay() {
 
 	FileFilterIndex* idx = CollectionSystemManager::get()->getSystemToView(mSystem)->getIndex();
-	std::string showFoldersSetting = Settings::getInstance()->getString("ShowFolders");
+	static StringSetting showFolders("ShowFolders");
+	static const int showFoldersListener = Settings::getInstance()->addChangeCallback("ShowFolders", [] { sShowFoldersGeneration++; });
+	(void)showFoldersListener;
+	const std::string& showFoldersSetting = showFolders.get();
 
 	// RetroPangui: gamelist.xml-based filtering
 	// 컬렉션(전체 게임/즐겨찾기/최근 플레이/랜덤)은 실제 롬 폴더가 없고
@@ -152,10 +199,10 @@ const std::vector<FileData*>& FileData::getChildrenListToDisplay() {
 	// 재사용 - "screenshots" 하나에만 하드코딩, 전체 시스템에 토글 메뉴를
 	// 만드는 범용 기능까지는 불필요하다고 판단.
 	if (mSystem->getName() == "screenshots" && mType == FOLDER) {
-		if (mFilteredChildrenDirty || showFoldersSetting != mLastShowFoldersSetting) {
+		if (mFilteredChildrenDirty || mShowFoldersGeneration != sShowFoldersGeneration) {
 			mFilteredChildren = getFilesRecursive(GAME, false);
 			mFilteredChildrenDirty = false;
-			mLastShowFoldersSetting = showFoldersSetting;
+			mShowFoldersGeneration = sShowFoldersGeneration;
 		}
 		return mFilteredChildren;
 	}
@@ -166,7 +213,7 @@ const std::vector<FileData*>& FileData::getChildrenListToDisplay() {
 	}
 
 	// Invalidate cache if ShowFolders setting changed since last cache build
-	if (showFoldersSetting != mLastShowFoldersSetting) {
+	if (mShowFoldersGeneration != sShowFoldersGeneration) {
 		mFilteredChildrenDirty = true;
 	}
 
@@ -175,7 +222,7 @@ const std::vector<FileData*>& FileData::getChildrenListToDisplay() {
 		return mFilteredChildren;
 	}
 	mFilteredChildrenDirty = false;
-	mLastShowFoldersSetting = showFoldersSetting;
+	mShowFoldersGeneration = sShowFoldersGeneration;
 
 	if (idx->isFiltered() || needsFolderFiltering) {
 		mFilteredChildren.clear();
@@ -439,23 +486,118 @@ std::vector<FileData*> FileData::getFilesRecursive(unsigned int typeMask, bool d
 {
 	std::vector<FileData*> out;
 	FileFilterIndex* idx = mSystem->getIndex();
+	const bool filtered = displayedOnly && idx->isFiltered();
 
-	for(auto it = mChildren.cbegin(); it != mChildren.cend(); it++)
+	if(typeMask == GAME)
+		out.reserve(mGameCount);
+
+	visitRecursive(typeMask, [&](FileData* file)
+	{
+		if (!filtered || idx->showFile(file))
+			out.push_back(file);
+	});
+
+	return out;
+}
+
+unsigned int FileData::getShowFoldersGeneration()
+{
+	return sShowFoldersGeneration;
+}
+
+unsigned int FileData::getTreeGeneration()
+{
+	return sTreeGeneration;
+}
+
+unsigned int FileData::getFavoriteCount() const
+{
+	return mAggregates ? mAggregates->favorites : 0;
+}
+
+const std::string& FileData::getLastPlayed()
+{
+	static const std::string empty;
+	if(!mAggregates)
+		return empty;
+
+	Aggregates& aggregates = *mAggregates;
+	if(aggregates.lastPlayedDirty)
 	{
-		if((*it)->getType() & typeMask)
+		// 자식 폴더는 각자의 값을 쓰므로 이 폴더의 자식 수만큼만
+		aggregates.lastPlayed.clear();
+		for(auto it = mChildren.cbegin(); it != mChildren.cend(); it++)
 		{
-			if (!displayedOnly || !idx->isFiltered() || idx->showFile(*it))
-				out.push_back(*it);
+			const std::string& lastPlayed = (*it)->mType == GAME ? (*it)->metadata.get("lastplayed") : (*it)->getLastPlayed();
+			if(lastPlayed > aggregates.lastPlayed)
+				aggregates.lastPlayed = lastPlayed;
 		}
+		aggregates.lastPlayedDirty = false;
+	}
+	return aggregates.lastPlayed;
+}
+
+void FileData::addToAggregates(FileData* file)
+{
+	const unsigned int favorites = file->mType == GAME ? (file->metadata.get("favorite") == "true" ? 1 : 0) : file->getFavoriteCount();
+	const std::string& lastPlayed = file->mType == GAME ? file->metadata.get("lastplayed") : file->getLastPlayed();
+	for(FileData* folder = this; folder != NULL; folder = folder->mParent)
+	{
+		Aggregates& aggregates = *folder->mAggregates;
+		aggregates.favorites += favorites;
+		if(!aggregates.lastPlayedDirty && lastPlayed > aggregates.lastPlayed)
+			aggregates.lastPlayed = lastPlayed;
+	}
+}
+
+void FileData::removeFromAggregates(FileData* file)
+{
+	const unsigned int favorites = file->mType == GAME ? (file->metadata.get("favorite") == "true" ? 1 : 0) : file->getFavoriteCount();
+	const std::string& lastPlayed = file->mType == GAME ? file->metadata.get("lastplayed") : file->getLastPlayed();
+	for(FileData* folder = this; folder != NULL; folder = folder->mParent)
+	{
+		Aggregates& aggregates = *folder->mAggregates;
+		aggregates.favorites -= favorites;
+		// 최댓값을 가진 항목이 빠짐 - 다음에 물을 때 다시 계산
+		if(!lastPlayed.empty() && lastPlayed == aggregates.lastPlayed)
+			aggregates.lastPlayedDirty = true;
+	}
+}
+
+void FileData::onMetaDataChanged(const std::string& key, const std::string& oldValue, const std::string& newValue)
+{
+	if(mType != GAME || mParent == NULL)
+		return;
+
+	if(key == "favorite")
+	{
+		const bool was = oldValue == "true";
+		const bool is = newValue == "true";
+		if(was == is)
+			return;
 
-		if((*it)->getChildren().size() > 0)
+		for(FileData* folder = mParent; folder != NULL; folder = folder->mParent)
 		{
-			std::vector<FileData*> subchildren = (*it)->getFilesRecursive(typeMask, displayedOnly);
-			out.insert(out.cend(), subchildren.cbegin(), subchildren.cend());
+			if(is)
+				folder->mAggregates->favorites++;
+			else
+				folder->mAggregates->favorites--;
 		}
 	}
+	else if(key == "lastplayed")
+	{
+		for(FileData* folder = mParent; folder != NULL; folder = folder->mParent)
+		{
+			Aggregates& aggregates = *folder->mAggregates;
+			if(aggregates.lastPlayedDirty)
+				continue;
 
-	return out;
+			if(newValue > aggregates.lastPlayed)
+				aggregates.lastPlayed = newValue;
+			else if(oldValue == aggregates.lastPlayed && newValue < oldValue)
+				aggregates.lastPlayedDirty = true;
+		}
+	}
 }
 
 std::string FileData::getKey() {
@@ -464,12 +606,11 @@ std::string FileData::getKey() {
 
 const bool FileData::isArcadeAsset()
 {
+	if(!mSystem || !(mSystem->hasPlatformId(PlatformIds::ARCADE) || mSystem->hasPlatformId(PlatformIds::NEOGEO)))
+		return false;
+
 	const std::string stem = Utils::FileSystem::getStem(mPath);
-	return (
-		(mSystem && (mSystem->hasPlatformId(PlatformIds::ARCADE) || mSystem->hasPlatformId(PlatformIds::NEOGEO)))
-		&&
-		(MameNames::getInstance()->isBios(stem) || MameNames::getInstance()->isDevice(stem))
-	);
+	return MameNames::getInstance()->isBios(stem) || MameNames::getInstance()->isDevice(stem);
 }
 
 FileData* FileData::getSourceFileData()
@@ -489,6 +630,14 @@ void FileData::addChild(FileData* file)
 		mChildren.push_back(file);
 		file->mParent = this;
 		mFilteredChildrenDirty = true;
+
+		sTreeGeneration++;
+		const unsigned int games = file->mType == GAME ? 1 : file->mGameCount;
+		for(FileData* folder = this; folder != NULL; folder = folder->mParent)
+		{
+			folder->mGameCount += games;
+		}
+		addToAggregates(file);
 	}
 }
 
@@ -504,6 +653,14 @@ void FileData::removeChild(FileData* file)
 			file->mParent = NULL;
 			mChildren.erase(it);
 			mFilteredChildrenDirty = true;
+
+			sTreeGeneration++;
+			const unsigned int games = file->mType == GAME ? 1 : file->mGameCount;
+			for(FileData* folder = this; folder != NULL; folder = folder->mParent)
+			{
+				folder->mGameCount -= games;
+			}
+			removeFromAggregates(file);
 			return;
 		}
 	}
@@ -539,18 +696,76 @@ void FileData::sort(const SortType& type)
 {
 	sort(*type.comparisonFunction, type.ascending);
 	mSortDesc = type.description;
+	mSortComparator = type.comparisonFunction;
+	mSortAscending = type.ascending;
+}
+
+int FileData::findSortedChild(FileData* file) const
+{
+	assert(mType == FOLDER);
+	if (mSortComparator == nullptr)
+		return -1;
+
+	// descending sorts are stored reversed, so compare the other way around
+	ComparisonFunction* comparator = mSortComparator;
+	const bool ascending = mSortAscending;
+	auto less = [comparator, ascending](const FileData* a, const FileData* b) { return ascending ? comparator(a, b) : comparator(b, a); };
+
+	// stable sort: entries with equal keys stay together, the child is somewhere in that run
+	auto range = std::equal_range(mChildren.cbegin(), mChildren.cend(), file, less);
+	auto it = std::find(range.first, range.second, file);
+	if (it != range.second)
+		return (int)(it - mChildren.cbegin());
+
+	// the child's keys changed since it was sorted - only its own position can be out of order
+	it = std::find(mChildren.cbegin(), mChildren.cend(), file);
+	return it != mChildren.cend() ? (int)(it - mChildren.cbegin()) : -1;
 }
 
+bool FileData::resortChild(FileData* file, int position)
+{
+	assert(mType == FOLDER);
+	if (mSortComparator == nullptr || position < 0 || position >= (int)mChildren.size() || mChildren[position] != file)
+		return false;
+
+	ComparisonFunction* comparator = mSortComparator;
+	const bool ascending = mSortAscending;
+	auto less = [comparator, ascending](const FileData* a, const FileData* b) { return ascending ? comparator(a, b) : comparator(b, a); };
+
+	// still in order with its neighbours: nothing to do
+	auto it = mChildren.begin() + position;
+	if ((it == mChildren.begin() || !less(file, *(it - 1))) && (it + 1 == mChildren.end() || !less(*(it + 1), file)))
+		return false;
+
+	mChildren.erase(it);
+	mChildren.insert(std::upper_bound(mChildren.begin(), mChildren.end(), file, less), file);
+	mFilteredChildrenDirty = true;
+	return true;
+}
+
+
+static FileData::LaunchTimings sLastLaunchTimings = FileData::LaunchTimings();
 
 void FileData::launchGame(Window* window, int entrySlot)
 {
 	LOG(LogInfo) << "Attempting to launch game...";
 
-	MusicManager::getInstance()->stop();
-	AudioManager::getInstance()->deinit();
-	VolumeControl::getInstance()->deinit();
+	LaunchTimings timings = LaunchTimings();
+	const unsigned int launchTicks = SDL_GetTicks();
+
+	// RetroPangui: 정리 단계 - BGM(VLC 덱/플레이어 해제가 가장 느림)과 ALSA 믹서는 SDL/GL과
+	// 무관해서 보조 스레드에서, 입력과 창(GL 컨텍스트)은 메인 스레드에서 동시에 정리한다.
+	// SDL 오디오는 BGM 스트림이 끊긴 뒤에 닫아야 하므로 합류한 다음 메인 스레드에서
+	std::thread teardown([]
+	{
+		MusicManager::getInstance()->stop();
+		VolumeControl::getInstance()->deinit();
+	});
 	InputManager::getInstance()->deinit();
-	window->deinit();
+	window->deinit(true);
+	teardown.join();
+	AudioManager::getInstance()->deinit();
+	timings.teardown = SDL_GetTicks() - launchTicks;
 
 	std::string command = mEnvData->mLaunchCommand;
 
@@ -604,7 +819,10 @@ void FileData::launchGame(Window* window, int entrySlot)
 	Scripting::fireEvent("game-start", rom, basename, name);
 
 	LOG(LogInfo) << "	" << command;
+	const unsigned int commandTicks = SDL_GetTicks();
 	int exitCode = runSystemCommand(command);
+	const unsigned int exitTicks = SDL_GetTicks();
+	timings.command = exitTicks - commandTicks;
 
 	if(exitCode != 0)
 	{
@@ -627,26 +845,51 @@ void FileData::launchGame(Window* window, int entrySlot)
 	// S99emulationstation/ES 두 호출처(여기, main.cpp SIGUSR1 핸들러)가
 	// 각자 인라인으로 들고 있던 동일 로직을 하나로 합침. 상세:
 	// todo-20260713-display-followups.html 2번 항목.
+	// 복귀 단계 - 해상도 재적용과 창/입력 초기화는 이 순서대로 메인 스레드에서, ALSA 믹서는
+	// 그동안 보조 스레드에서 연다. BGM은 SDL 오디오를 다시 열 수 있어서 합류 후에
+	std::thread restore([] { VolumeControl::getInstance()->init(); });
 	system("/usr/share/retropangui/apply-resolution.sh 2>/dev/null || true");
 
 	window->init();
 	InputManager::getInstance()->init();
-	VolumeControl::getInstance()->init();
+	restore.join();
 	MusicManager::getInstance()->start(); // 게임 종료 후 BGM 재개 (새 셔플)
 	window->normalizeNextUpdate();
+	window->measureTimeToInteractive(exitTicks);
+	timings.restore = SDL_GetTicks() - exitTicks;
+
+	// 플레이 기록/컬렉션/gamelist 갱신은 게임 목록이 다시 그려진 다음 프레임으로 미룸.
+	// 메타데이터와 컬렉션은 UI 스레드에서만 만지므로 작업 스레드가 아닌 UI 루프에서 실행
+	FileData* launched = this;
+	window->runAfterNextFrame([launched, timings]() mutable
+	{
+		const unsigned int bookkeepingTicks = SDL_GetTicks();
+
+		//update number of times the game has been launched
 
-	//update number of times the game has been launched
+		FileData* gameToUpdate = launched->getSourceFileData();
 
-	FileData* gameToUpdate = getSourceFileData();
+		int timesPlayed = gameToUpdate->metadata.getInt("playcount") + 1;
+		gameToUpdate->metadata.set("playcount", std::to_string(static_cast<long long>(timesPlayed)));
 
-	int timesPlayed = gameToUpdate->metadata.getInt("playcount") + 1;
-	gameToUpdate->metadata.set("playcount", std::to_string(static_cast<long long>(timesPlayed)));
+		//update last played time
+		gameToUpdate->metadata.set("lastplayed", Utils::Time::DateTime(Utils::Time::now()));
+		CollectionSystemManager::get()->refreshCollectionSystems(gameToUpdate);
+		gameToUpdate->mSystem->updateRecentGame(gameToUpdate);
 
-	//update last played time
-	gameToUpdate->metadata.set("lastplayed", Utils::Time::DateTime(Utils::Time::now()));
-	CollectionSystemManager::get()->refreshCollectionSystems(gameToUpdate);
+		gameToUpdate->mSystem->journalMetaData(gameToUpdate, { "playcount", "lastplayed" });
+		ViewController::get()->onFileChanged(launched, FILE_METADATA_CHANGED);
 
-	gameToUpdate->mSystem->onMetaDataSavePoint();
+		timings.bookkeeping = SDL_GetTicks() - bookkeepingTicks;
+		sLastLaunchTimings = timings;
+		LOG(LogInfo) << "Launch timings: teardown " << timings.teardown << " ms, game " << timings.command << " ms, restore "
+			<< timings.restore << " ms, bookkeeping " << timings.bookkeeping << " ms";
+	});
+}
+
+const FileData::LaunchTimings& FileData::getLastLaunchTimings()
+{
+	return sLastLaunchTimings;
 }
 
 CollectionFileData::CollectionFileData(FileData* file, SystemData* system)
@@ -654,16 +897,39 @@ CollectionFileData::CollectionFileData(FileData* file, SystemData* system)
 {
 	// we use this constructor to create a clone of the filedata, and change its system
 	mSourceFileData = file->getSourceFileData();
-	refreshMetadata();
 	mParent = NULL;
-	metadata = mSourceFileData->metadata;
-	mSystemName = mSourceFileData->getSystem()->getName();
+
+	// RetroPangui: 메타데이터를 통째로 복사하지 않고 원본과 공유 - 설명/경로 같은 긴 값은 원본에만 있다.
+	// 항목 객체 자체(FileData 하나, 경로/이름 문자열)는 컬렉션마다 게임당 여전히 하나씩 만들어진다.
+	// 필터 인덱스 키와 정렬 키만 항목별로 들고 있는다 - 정렬 키가 refreshMetadata() 전까지 정렬된 값
+	// 그대로여야 findSortedChild()가 이진 탐색으로 찾음.
+	static std::vector<std::string> sSnapshotKeys;
+	if (sSnapshotKeys.empty())
+	{
+		const std::vector<FilterDataDecl>& decls = system->getIndex()->getFilterDataDecls();
+		for (auto it = decls.cbegin(); it != decls.cend(); ++it)
+		{
+			sSnapshotKeys.push_back(it->primaryKey);
+			if (it->hasSecondaryKey)
+				sSnapshotKeys.push_back(it->secondaryKey);
+		}
+
+		// keys read by the FileSorts comparators
+		static const char* sortKeys[] = { "sortname", "name", "rating", "playcount", "lastplayed", "players", "releasedate", "genre", "developer", "publisher" };
+		for (const char* key : sortKeys)
+		{
+			if (std::find(sSnapshotKeys.cbegin(), sSnapshotKeys.cend(), key) == sSnapshotKeys.cend())
+				sSnapshotKeys.push_back(key);
+		}
+	}
+	metadata.share(&mSourceFileData->metadata, sSnapshotKeys);
+	mDirty = true;
 }
 
 CollectionFileData::~CollectionFileData()
 {
 	// need to remove collection file data at the collection object destructor
-	if(mParent)
+	if(mParent && !FileDataArena::isReleasing(mParent))
 		mParent->removeChild(this);
 	mParent = NULL;
 }
@@ -679,7 +945,7 @@ FileData* CollectionFileData::getSourceFileData()
 
 void CollectionFileData::refreshMetadata()
 {
-	metadata = mSourceFileData->metadata;
+	metadata.refreshShared();
 	mDirty = true;
 }
 
@@ -4,8 +4,10 @@
 
 #include "utils/FileSystemUtil.h"
 #include "MetaData.h"
+#include <memory>
 #include <unordered_map>
 
+class FileDataArena;
 class SystemData;
 class Window;
 struct SystemEnvironmentData;
@@ -36,6 +38,13 @@ public:
 	FileData(FileType type, const std::string& path, SystemEnvironmentData* envData, SystemData* system);
 	virtual ~FileData();
 
+	// RetroPangui: `new (system->getFileArena()) FileData(...)`는 시스템의 슬랩에, 그냥 new는 힙에 할당.
+	// delete는 둘 다 그대로 쓰면 됨 (FileDataArena.h 참고)
+	static void* operator new(size_t size);
+	static void* operator new(size_t size, FileDataArena* arena);
+	static void operator delete(void* ptr);
+	static void operator delete(void* ptr, FileDataArena* arena);
+
 	virtual const std::string& getName();
 	virtual const std::string& getSortName();
 	inline FileType getType() const { return mType; }
@@ -53,6 +62,30 @@ public:
 	const std::vector<FileData*>& getChildrenListToDisplay();
 	std::vector<FileData*> getFilesRecursive(unsigned int typeMask, bool displayedOnly = false) const;
 
+	// RetroPangui: 하위 트리를 getFilesRecursive()와 같은 순서(깊이 우선)로 돌면서 typeMask에 맞는 항목마다
+	// visit(FileData*) 호출 - 세기/찾기만 할 때 전체 트리 벡터를 만들지 않도록
+	template<typename Visitor>
+	void visitRecursive(unsigned int typeMask, const Visitor& visit) const
+	{
+		for(auto it = mChildren.cbegin(); it != mChildren.cend(); it++)
+		{
+			if((*it)->mType & typeMask)
+				visit(*it);
+			if(!(*it)->mChildren.empty())
+				(*it)->visitRecursive(typeMask, visit);
+		}
+	}
+
+	// 하위 트리 전체의 게임 수 - addChild()/removeChild()가 조상까지 바로 갱신하므로 O(1)
+	inline unsigned int getGameCount() const { return mGameCount; }
+	// 하위 트리의 즐겨찾기 수와 가장 최근 lastplayed - 게임 추가/제거와 메타데이터 변경 때 조상까지 바로 갱신.
+	// lastplayed는 최댓값이 줄어들 때만 그 폴더의 자식들로 다시 계산(처음 물을 때)
+	unsigned int getFavoriteCount() const;
+	const std::string& getLastPlayed();
+	static unsigned int getShowFoldersGeneration();
+	// 어느 폴더에서든 addChild()/removeChild()가 있을 때마다 증가
+	static unsigned int getTreeGeneration();
+
 	void addChild(FileData* file); // Error if mType != FOLDER
 	void removeChild(FileData* file); //Error if mType != FOLDER
 
@@ -65,18 +98,29 @@ public:
 	inline std::string getFullPath() { return getPath(); };
 	inline std::string getFileName() { return Utils::FileSystem::getFileName(getPath()); };
 	virtual FileData* getSourceFileData();
-	inline std::string getSystemName() const { return mSystemName; };
+	std::string getSystemName() const;
 
 	// Returns our best guess at the "real" name for this file (will attempt to perform MAME name translation)
-	std::string getDisplayName() const;
+	// RetroPangui: 경로와 시스템은 바뀌지 않으므로 생성자에서 한 번만 계산
+	inline const std::string& getDisplayName() const { return mDisplayName; }
 
-	// As above, but also remove parenthesis
-	std::string getCleanName() const;
+	// As above, but also remove parenthesis (계산은 처음 부를 때 한 번)
+	const std::string& getCleanName() const;
 
 	// entrySlot >= 0 이면 rpui-launcher 5번째 인자로 붙여 RetroArch --entryslot
 	// (해당 슬롯 스테이트를 로드하며 시작)로 전달됨. -1 = 스테이트 없이 실행.
 	void launchGame(Window* window, int entrySlot = -1);
 
+	// RetroPangui: 마지막 게임 실행의 단계별 소요 시간(ms) - 실행 지연 회귀 추적용
+	struct LaunchTimings
+	{
+		unsigned int teardown;    // 오디오/입력/창 정리
+		unsigned int command;     // 에뮬레이터 실행 ~ 종료
+		unsigned int restore;     // 종료 ~ 화면/입력/BGM 복귀
+		unsigned int bookkeeping; // 플레이 기록/컬렉션/gamelist 갱신(복귀 후 첫 프레임 다음)
+	};
+	static const LaunchTimings& getLastLaunchTimings();
+
 	typedef bool ComparisonFunction(const FileData* a, const FileData* b);
 	struct SortType
 	{
@@ -90,25 +134,48 @@ public:
 
 	void sort(const SortType& type);
 	std::string getSortDescription() { return mSortDesc; }
+	inline bool isSorted() const { return mSortComparator != nullptr; }
+	// Returns the child's index under the last sort(), found by binary search - call it while the child still has
+	// the sort keys it was sorted by. Returns -1 if the child isn't here or this folder was never sorted.
+	int findSortedChild(FileData* file) const;
+	// Moves the child at position (from findSortedChild()) to its place under the last sort(), instead of
+	// re-sorting all children. The new place is found by binary search; moving it is one vector erase/insert.
+	// Returns true if the child changed position. No-op if this folder was never sorted.
+	bool resortChild(FileData* file, int position);
 	MetaDataList metadata;
+	// called by metadata when one of its values changes
+	void onMetaDataChanged(const std::string& key, const std::string& oldValue, const std::string& newValue);
 
 protected:
 	FileData* mSourceFileData;
 	FileData* mParent;
-	std::string mSystemName;
 
 private:
 	void sort(ComparisonFunction& comparator, bool ascending = true);
 	FileType mType;
 	std::string mPath;
+	std::string mDisplayName;
+	mutable std::string mCleanName;
 	SystemEnvironmentData* mEnvData;
 	SystemData* mSystem;
 	std::unordered_map<std::string,FileData*> mChildrenByFilename;
 	std::vector<FileData*> mChildren;
 	std::vector<FileData*> mFilteredChildren;
 	bool mFilteredChildrenDirty = true;
-	std::string mLastShowFoldersSetting;
+	unsigned int mGameCount = 0;
+	void addToAggregates(FileData* file);
+	void removeFromAggregates(FileData* file);
+	struct Aggregates
+	{
+		unsigned int favorites = 0;
+		std::string lastPlayed; // lastplayed는 ISO 형식(yyyymmddThhmmss)이라 문자열 비교가 곧 시간 비교
+		bool lastPlayedDirty = false;
+	};
+	std::unique_ptr<Aggregates> mAggregates; // 폴더만
+	unsigned int mShowFoldersGeneration = 0; // 캐시를 만들 때의 ShowFolders 변경 횟수
 	std::string mSortDesc;
+	ComparisonFunction* mSortComparator = nullptr;
+	bool mSortAscending = true;
 };
 
 class CollectionFileData : public FileData
@@ -0,0 +1,119 @@
+#include "FileDataArena.h"
+
+#include "FileData.h"
+#include <algorithm>
+#include <new>
+
+namespace
+{
+	const size_t ALIGNMENT = alignof(std::max_align_t);
+
+	inline size_t alignUp(size_t size)
+	{
+		return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+}
+
+const size_t FileDataArena::HEADER_SIZE = alignUp(sizeof(FileDataArena::Header));
+
+FileDataArena::FileDataArena() : mBlockUsed(SLOTS_PER_BLOCK), mFreeList(NULL), mLiveCount(0), mReleasing(false)
+{
+	// 슬롯 하나에 어떤 노드 타입이든 들어가도록
+	mSlotSize = HEADER_SIZE + alignUp(std::max(sizeof(FileData), sizeof(CollectionFileData)));
+}
+
+FileDataArena::~FileDataArena()
+{
+	releaseAll();
+}
+
+void* FileDataArena::allocate(size_t size)
+{
+	if(HEADER_SIZE + size > mSlotSize)
+		return allocate(NULL, size);
+
+	Header* header = mFreeList;
+	if(header != NULL)
+	{
+		mFreeList = header->nextFree;
+	}
+	else
+	{
+		if(mBlockUsed == SLOTS_PER_BLOCK)
+		{
+			mBlocks.push_back(static_cast<char*>(::operator new(SLOTS_PER_BLOCK * mSlotSize)));
+			mBlockUsed = 0;
+		}
+		header = reinterpret_cast<Header*>(mBlocks.back() + mBlockUsed * mSlotSize);
+		mBlockUsed++;
+	}
+
+	header->arena = this;
+	header->nextFree = NULL;
+	header->live = true;
+	mLiveCount++;
+	return reinterpret_cast<char*>(header) + HEADER_SIZE;
+}
+
+void FileDataArena::release(Header* header)
+{
+	header->live = false;
+	header->nextFree = mFreeList;
+	mFreeList = header;
+	mLiveCount--;
+}
+
+void FileDataArena::releaseAll()
+{
+	mReleasing = true;
+
+	for(size_t block = 0; block < mBlocks.size(); block++)
+	{
+		const size_t used = (block + 1 == mBlocks.size()) ? mBlockUsed : SLOTS_PER_BLOCK;
+		for(size_t slot = 0; slot < used; slot++)
+		{
+			Header* header = reinterpret_cast<Header*>(mBlocks[block] + slot * mSlotSize);
+			if(header->live)
+				reinterpret_cast<FileData*>(reinterpret_cast<char*>(header) + HEADER_SIZE)->~FileData();
+		}
+	}
+
+	for(auto it = mBlocks.cbegin(); it != mBlocks.cend(); it++)
+		::operator delete(*it);
+
+	mBlocks.clear();
+	mBlockUsed = SLOTS_PER_BLOCK;
+	mFreeList = NULL;
+	mLiveCount = 0;
+	mReleasing = false;
+}
+
+void* FileDataArena::allocate(FileDataArena* arena, size_t size)
+{
+	if(arena != NULL)
+		return arena->allocate(size);
+
+	Header* header = static_cast<Header*>(::operator new(HEADER_SIZE + size));
+	header->arena = NULL;
+	header->nextFree = NULL;
+	header->live = true;
+	return reinterpret_cast<char*>(header) + HEADER_SIZE;
+}
+
+void FileDataArena::deallocate(void* ptr)
+{
+	if(ptr == NULL)
+		return;
+
+	Header* header = reinterpret_cast<Header*>(static_cast<char*>(ptr) - HEADER_SIZE);
+	if(header->arena == NULL)
+		::operator delete(header);
+	else if(!header->arena->mReleasing) // releaseAll()이 블록째로 해제
+		header->arena->release(header);
+}
+
+bool FileDataArena::isReleasing(const void* ptr)
+{
+	const Header* header = reinterpret_cast<const Header*>(static_cast<const char*>(ptr) - HEADER_SIZE);
+	return header->arena != NULL && header->arena->mReleasing;
+}
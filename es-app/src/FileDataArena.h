@@ -0,0 +1,58 @@
+#pragma once
+#ifndef ES_APP_FILE_DATA_ARENA_H
+#define ES_APP_FILE_DATA_ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+class FileData;
+
+// RetroPangui: 시스템별 FileData 슬랩 할당기. 게임/폴더 노드를 하나씩 new 하는 대신
+// SLOTS_PER_BLOCK개짜리 블록에서 고정 크기 슬롯으로 잘라 쓴다 - 할당 횟수가 블록 수로 줄고,
+// 같은 시스템의 노드가 붙어 있어 정렬/필터링 때 캐시 효율이 좋다.
+// 각 슬롯 앞에는 소속 아레나를 적은 헤더가 있어서 `delete game`(FileData::operator delete)이
+// 그 아레나의 빈 슬롯 목록으로 돌려준다. 아레나 없이 만든 노드(플레이스홀더 등)도 같은 헤더를 달고
+// 일반 힙에서 할당된다.
+// 시스템을 내릴 때는 releaseAll() 한 번으로 살아 있는 노드의 소멸자를 모두 부르고 블록을 통째로 해제한다.
+// 이 동안 isReleasing()이 true라서 ~FileData()가 같은 아레나 안의 부모/인덱스에서 하나씩 떼어 내지 않는다.
+// 아레나 하나는 한 번에 한 스레드(시스템을 만들거나 고치는 스레드)에서만 쓴다.
+class FileDataArena
+{
+public:
+	FileDataArena();
+	~FileDataArena();
+
+	void* allocate(size_t size);
+	void releaseAll();
+
+	inline size_t getLiveCount() const { return mLiveCount; }
+	inline size_t getReservedBytes() const { return mBlocks.size() * SLOTS_PER_BLOCK * mSlotSize; }
+
+	// arena가 NULL이거나 요청 크기가 슬롯보다 크면 일반 힙
+	static void* allocate(FileDataArena* arena, size_t size);
+	static void deallocate(void* ptr);
+	// ptr(FileData)이 속한 아레나가 releaseAll() 중이면 true
+	static bool isReleasing(const void* ptr);
+
+private:
+	struct Header
+	{
+		FileDataArena* arena; // NULL이면 일반 힙 할당
+		Header* nextFree;
+		bool live;
+	};
+
+	static const size_t SLOTS_PER_BLOCK = 256;
+	static const size_t HEADER_SIZE;
+
+	void release(Header* header);
+
+	size_t mSlotSize;
+	std::vector<char*> mBlocks;
+	size_t mBlockUsed; // 마지막 블록에서 쓴 슬롯 수
+	Header* mFreeList;
+	size_t mLiveCount;
+	bool mReleasing;
+};
+
+#endif // ES_APP_FILE_DATA_ARENA_H
@@ -45,6 +45,8 @@ public:
 	bool showFile(FileData* game);
 	bool isFiltered() { return (filterByGenre || filterByPlayers || filterByPubDev || filterByRatings || filterByFavorites || filterByHidden || filterByKidGame); };
 	bool isKeyBeingFilteredBy(std::string key, FilterIndexType type);
+	// RetroPangui: setFilter()/clearAllFilters()마다 증가 - 필터 결과에 기대는 캐시(표시 게임 수 등)의 키
+	inline unsigned int getFilterGeneration() const { return mFilterGeneration; }
 	std::vector<FilterDataDecl>& getFilterDataDecls();
 
 	void importIndex(FileFilterIndex* indexToImport);
@@ -68,6 +70,8 @@ private:
 
 	void clearIndex(std::map<std::string, int> indexMap);
 
+	unsigned int mFilterGeneration;
+
 	bool filterByGenre;
 	bool filterByPlayers;
 	bool filterByPubDev;
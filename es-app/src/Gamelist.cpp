@@ -1,11 +1,16 @@
 #include "Gamelist.h"
 
-#include <chrono>
+#include <algorithm>
 #include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "utils/FileSystemUtil.h"
 #include "FileData.h"
 #include "FileFilterIndex.h"
+#include "GamelistWriter.h"
 #include "Log.h"
 #include "Settings.h"
 #include "SystemData.h"
@@ -107,7 +112,7 @@ FileData* findOrCreateFile(SystemData* system, const std::string& path, FileType
 				return NULL;
 			}
 
-			FileData* file = new FileData(type, path, system->getSystemEnvData(), system);
+			FileData* file = new (system->getFileArena()) FileData(type, path, system->getSystemEnvData(), system);
 
 			// skipping arcade assets from gamelist and add only to filesystem
 			// (fs) folders, i.e. entriess in gamelist with <folder/> and not to
@@ -141,7 +146,7 @@ FileData* findOrCreateFile(SystemData* system, const std::string& path, FileType
 			}
 			// create folder filedata object
 			std::string absPath = Utils::FileSystem::resolveRelativePath(treeNode->getPath() + "/" + pathSegment, systemPath, false, true);
-			FileData* folder = new FileData(FOLDER, absPath, system->getSystemEnvData(), system);
+			FileData* folder = new (system->getFileArena()) FileData(FOLDER, absPath, system->getSystemEnvData(), system);
 			LOG(LogDebug) << "folder not found as FileData, adding: " << folder->getPath();
 
 			treeNode->addChild(folder);
@@ -188,7 +193,7 @@ void generateGamelist(SystemData* system)
 		LOG(LogError) << "Failed to auto-generate gamelist.xml for \"" << system->getName() << "\"";
 }
 
-void parseGamelist(SystemData* system)
+void parseGamelist(SystemData* system, bool newOnly)
 {
 	bool trustGamelist = Settings::getInstance()->getBool("ParseGamelistOnly");
 	std::string xmlpath = system->getGamelistPath(false);
@@ -217,6 +222,10 @@ void parseGamelist(SystemData* system)
 
 	std::string relativeTo = system->getStartPath();
 
+	std::unordered_set<FileData*> loaded;
+	if(newOnly)
+		system->getRootFolder()->visitRecursive(GAME | FOLDER, [&loaded](FileData* file) { loaded.insert(file); });
+
 	const char* tagList[2] = { "game", "folder" };
 	FileType typeList[2] = { GAME, FOLDER };
 	for(int i = 0; i < 2; i++)
@@ -252,7 +261,7 @@ void parseGamelist(SystemData* system)
 				LOG(LogError) << "Error finding/creating FileData for \"" << path << "\", skipping.";
 				continue;
 			}
-			else if(!file->isArcadeAsset())
+			else if(!file->isArcadeAsset() && loaded.find(file) == loaded.cend())
 			{
 				std::string defaultName = file->metadata.get("name");
 				file->metadata = MetaDataList::createFromXML(file->getType() == GAME ? GAME_METADATA : FOLDER_METADATA, fileNode, relativeTo);
@@ -291,148 +300,215 @@ void addFileDataNode(pugi::xml_node& parent, const FileData* file, const char* t
 	}
 }
 
-void updateGamelist(SystemData* system)
+std::string getGamelistJournalPath(SystemData* system)
 {
-	//We do this by reading the XML again, adding changes and then writing it back,
-	//because there might be information missing in our systemdata which would then miss in the new XML.
-	//We have the complete information for every game though, so we can simply remove a game
-	//we already have in the system from the XML, and then add it back from its GameData information...
-
-	if(Settings::getInstance()->getBool("IgnoreGamelist"))
-		return;
+	return system->getGamelistPath(true) + ".journal";
+}
 
-	pugi::xml_document doc;
-	pugi::xml_node root;
-	std::string xmlReadPath = system->getGamelistPath(false);
+bool appendGamelistJournal(SystemData* system, const FileData* file, const std::vector<std::string>& keys)
+{
+	const std::string journalPath = getGamelistJournalPath(system);
+	const std::string relPath = Utils::FileSystem::createRelativePath(file->getPath(), system->getStartPath(), false, true);
 
-	std::string relativeTo = system->getStartPath();
+	std::string records;
+	for (auto it = keys.cbegin(); it != keys.cend(); ++it)
+		records += *it + "\t" + file->metadata.get(*it) + "\t" + relPath + "\n";
 
-	if(Utils::FileSystem::exists(xmlReadPath))
+	FILE* journal = fopen(journalPath.c_str(), "ab");
+	if (journal == NULL)
 	{
-		//parse an existing file first
-		pugi::xml_parse_result result = doc.load_file(xmlReadPath.c_str());
-
-		if(!result)
+		Utils::FileSystem::createDirectory(Utils::FileSystem::getParent(journalPath));
+		journal = fopen(journalPath.c_str(), "ab");
+		if (journal == NULL)
 		{
-			LOG(LogError) << "Error parsing XML file \"" << xmlReadPath << "\"!\n	" << result.description();
-			return;
+			LOG(LogError) << "appendGamelistJournal: 저널 열기 실패 - " << journalPath;
+			return false;
 		}
+	}
 
-		root = doc.child("gameList");
-		if(!root)
-		{
-			LOG(LogError) << "Could not find <gameList> node in gamelist \"" << xmlReadPath << "\"!";
-			return;
-		}
-	}else{
-		//set up an empty gamelist to append to
-		root = doc.append_child("gameList");
+	const bool written = fwrite(records.data(), 1, records.size(), journal) == records.size();
+	fclose(journal);
+	if (!written)
+		LOG(LogError) << "appendGamelistJournal: 저널 쓰기 실패 - " << journalPath;
+	return written;
+}
+
+static unsigned int replayJournalFile(const std::string& journalPath, const std::unordered_map<std::string, FileData*>& files, const std::string& relativeTo)
+{
+	std::ifstream journal(journalPath.c_str(), std::ios::binary);
+	if (!journal)
+		return 0;
+
+	unsigned int records = 0;
+	std::string line;
+	while (std::getline(journal, line))
+	{
+		// 쓰는 도중 꺼져서 줄바꿈 없이 끝난 마지막 줄은 버림
+		if (journal.eof())
+			break;
+
+		const size_t keyEnd = line.find('\t');
+		const size_t valueEnd = keyEnd == std::string::npos ? std::string::npos : line.find('\t', keyEnd + 1);
+		if (valueEnd == std::string::npos)
+			continue;
+
+		const std::string path = Utils::FileSystem::resolveRelativePath(line.substr(valueEnd + 1), relativeTo, false, true);
+		auto file = files.find(path);
+		if (file == files.cend())
+			continue;
+
+		const std::string key = line.substr(0, keyEnd);
+		const std::vector<MetaDataDecl>& mdd = file->second->metadata.getMDD();
+		if (std::find_if(mdd.cbegin(), mdd.cend(), [&key](const MetaDataDecl& decl) { return decl.key == key; }) == mdd.cend())
+			continue;
+
+		file->second->metadata.set(key, line.substr(keyEnd + 1, valueEnd - keyEnd - 1));
+		records++;
 	}
 
-	std::vector<FileData*> changedGames;
-	std::vector<FileData*> changedFolders;
+	if (records > 0)
+		LOG(LogInfo) << "Replayed " << records << " journal records from \"" << journalPath << "\"";
+	return records;
+}
 
-	//now we have all the information from the XML. now iterate through all our games and add information from there
-	FileData* rootFolder = system->getRootFolder();
-	if (rootFolder != nullptr)
+// 압축할 때마다 저널을 <journal>.old.<seq>로 넘김 - 저장 중인 작업의 파일에 이어 붙이지 않고
+// 작업마다 자기 파일만 지우게. 옛 버전이 남긴 .old(순번 없음)가 가장 오래된 것.
+// 오래된 순으로 정렬된 경로 목록 반환
+static std::vector<std::string> getHandedOffJournals(const std::string& journalPath, unsigned int* lastSeq = nullptr)
+{
+	const std::string legacyPath = journalPath + ".old";
+	const std::string prefix = legacyPath + ".";
+
+	std::vector<std::pair<unsigned long, std::string>> handOffs;
+	const Utils::FileSystem::stringList dirContent = Utils::FileSystem::getDirContent(Utils::FileSystem::getParent(journalPath));
+	for (auto it = dirContent.cbegin(); it != dirContent.cend(); ++it)
 	{
-		int numUpdated = 0;
+		if (it->compare(0, prefix.size(), prefix) != 0 || it->size() == prefix.size())
+			continue;
 
-		std::vector<FileData*> files = rootFolder->getFilesRecursive(GAME | FOLDER);
+		char* end = nullptr;
+		const unsigned long seq = strtoul(it->c_str() + prefix.size(), &end, 10);
+		if (*end == '\0')
+			handOffs.push_back(std::make_pair(seq, *it));
+	}
+	std::sort(handOffs.begin(), handOffs.end());
 
-		// Stage 1: iterate through all files in memory, checking for changes
-		for(std::vector<FileData*>::const_iterator fit = files.cbegin(); fit != files.cend(); ++fit)
-		{
+	std::vector<std::string> paths;
+	if (Utils::FileSystem::exists(legacyPath))
+		paths.push_back(legacyPath);
+	for (auto it = handOffs.cbegin(); it != handOffs.cend(); ++it)
+		paths.push_back(it->second);
 
-			// do not touch if it wasn't changed anyway
-			if (!(*fit)->metadata.wasChanged())
-				continue;
+	if (lastSeq != nullptr)
+		*lastSeq = handOffs.empty() ? 0 : (unsigned int)handOffs.back().first;
+	return paths;
+}
 
-			// adding item to changed list
-			if ((*fit)->getType() == GAME)
-			{
-				changedGames.push_back((*fit));
-			}
-			else
-			{
-				changedFolders.push_back((*fit));
-			}
-		}
+unsigned int replayGamelistJournal(SystemData* system)
+{
+	// 넘겼지만 저장이 끝나기 전에 꺼진 저널들 - 더 오래된 것이므로 먼저, 넘긴 순서대로
+	const std::string journalPath = getGamelistJournalPath(system);
+	const std::vector<std::string> handOffs = getHandedOffJournals(journalPath);
+	const bool hasJournal = Utils::FileSystem::exists(journalPath);
+	if (!hasJournal && handOffs.empty())
+		return 0;
+
+	std::unordered_map<std::string, FileData*> files;
+	system->getRootFolder()->visitRecursive(GAME | FOLDER, [&files](FileData* file) { files[file->getPath()] = file; });
+
+	const std::string relativeTo = system->getStartPath();
+	unsigned int records = 0;
+	for (auto it = handOffs.cbegin(); it != handOffs.cend(); ++it)
+		records += replayJournalFile(*it, files, relativeTo);
+	if (hasJournal)
+		records += replayJournalFile(journalPath, files, relativeTo);
+
+	// 남은 게임이 없음 - 다시 적용할 것도 없음
+	if (records == 0)
+	{
+		for (auto it = handOffs.cbegin(); it != handOffs.cend(); ++it)
+			std::remove(it->c_str());
+		std::remove(journalPath.c_str());
+	}
+	return records;
+}
+
+// 저널을 새 .old.<seq>로 넘겨 그 저장 작업이 성공한 뒤 지우게 함 - 그 사이 새 레코드는 새 저널로.
+// 이전 저장이 실패해 남은 .old.*는 건드리지 않음(시작할 때 순서대로 다시 적용). 넘긴 경로 반환
+static std::string handOffJournal(SystemData* system)
+{
+	// 지워진 파일의 순번을 다시 쓰지 않도록 이번 실행에서 쓴 순번도 기억
+	static unsigned int sNextSeq = 1;
+
+	const std::string journalPath = getGamelistJournalPath(system);
+	unsigned int lastSeq = 0;
+	getHandedOffJournals(journalPath, &lastSeq);
+	const unsigned int seq = std::max(lastSeq + 1, sNextSeq);
+	sNextSeq = seq + 1;
+
+	const std::string handOffPath = journalPath + ".old." + std::to_string(seq);
+	if (std::rename(journalPath.c_str(), handOffPath.c_str()) != 0)
+		return "";
+
+	Utils::FileSystem::updateExistsCache(journalPath, false);
+	Utils::FileSystem::updateExistsCache(handOffPath, true);
+	return handOffPath;
+}
 
+void updateGamelist(SystemData* system)
+{
+	// RetroPangui: 여기서는 바뀐 항목의 노드만 만들어(스냅샷) GamelistWriter에 넘긴다 - 기존 gamelist.xml을
+	// 다시 읽어 바뀐 항목을 교체하고 저장하는 일은 백그라운드 스레드에서 (GamelistWriter.h 참고)
 
-		// Stage 2: iterate XML if needed, to remove and add changed items
-		const char* tagList[2] = { "game", "folder" };
-		FileType typeList[2] = { GAME, FOLDER };
-		std::vector<FileData*> changedList[2] = { changedGames, changedFolders };
+	if(Settings::getInstance()->getBool("IgnoreGamelist"))
+		return;
 
-		for(int i = 0; i < 2; i++)
-		{
-			const char* tag = tagList[i];
-			std::vector<FileData*> changes = changedList[i];
-
-			// check for changed items of this type
-			if (changes.size() > 0) {
-				// check if the item already exists in the XML
-				// if it does, remove all corresponding items before adding
-				for(pugi::xml_node fileNode = root.child(tag); fileNode; )
-				{
-					pugi::xml_node pathNode = fileNode.child("path");
-
-					// we need this as we were deleting the iterator and things would become inconsistent
-					pugi::xml_node nextNode = fileNode.next_sibling(tag);
-
-					if(!pathNode)
-					{
-						LOG(LogError) << "<" << tag << "> node contains no <path> child!";
-						continue;
-					}
-
-					std::string xmlpath = pathNode.text().get();
-					// apply the same transformation as in Gamelist::parseGamelist
-					xmlpath = Utils::FileSystem::resolveRelativePath(xmlpath, relativeTo, false, true);
-
-					for(std::vector<FileData*>::const_iterator cfit = changes.cbegin(); cfit != changes.cend(); ++cfit)
-					{
-						if(xmlpath == (*cfit)->getPath())
-						{
-							// found it
-							root.remove_child(fileNode);
-							break;
-						}
-					}
-					fileNode = nextNode;
-
-				}
-
-				// add items to XML
-				for(std::vector<FileData*>::const_iterator cfit = changes.cbegin(); cfit != changes.cend(); ++cfit)
-				{
-					// it was either removed or never existed to begin with; either way, we can add it now
-					addFileDataNode(root, *cfit, tag, system);
-					++numUpdated;
-				}
-			}
-		}
+	FileData* rootFolder = system->getRootFolder();
+	if (rootFolder == nullptr)
+	{
+		LOG(LogError) << "Found no root folder for system \"" << system->getName() << "\"!";
+		return;
+	}
 
-		// now write the file
+	GamelistWriter::Batch batch;
+	batch.doc = std::make_shared<pugi::xml_document>();
+	pugi::xml_node snapshot = batch.doc->append_child("gameList");
 
-		if (numUpdated > 0) {
-			const auto startTs = std::chrono::system_clock::now();
+	// iterate through all files in memory, checking for changes
+	std::vector<FileData*> changed;
+	rootFolder->visitRecursive(GAME | FOLDER, [&](FileData* file)
+	{
+		// do not touch if it wasn't changed anyway
+		if (!file->metadata.wasChanged())
+			return;
 
-			//make sure the folders leading up to this path exist (or the write will fail)
-			std::string xmlWritePath(system->getGamelistPath(true));
-			Utils::FileSystem::createDirectory(Utils::FileSystem::getParent(xmlWritePath));
+		changed.push_back(file);
 
-			LOG(LogInfo) << "Added/Updated " << numUpdated << " entities in '" << xmlReadPath << "'";
+		// addFileDataNode()는 기본값뿐인 항목은 붙이지 않음 - 그때는 기존 항목만 지움
+		pugi::xml_node last = snapshot.last_child();
+		addFileDataNode(snapshot, file, file->getType() == GAME ? "game" : "folder", system);
+		pugi::xml_node added = snapshot.last_child();
+		batch.nodes.push_back(std::make_pair(file->getPath(), added != last ? added : pugi::xml_node()));
+	});
 
-			if (!saveGamelistXml(doc, xmlWritePath)) {
-				LOG(LogError) << "Error saving gamelist.xml to \"" << xmlWritePath << "\" (for system " << system->getName() << ")!";
-			}
+	if (batch.nodes.empty() && !system->hasGamelistJournal())
+		return;
 
-			const auto endTs = std::chrono::system_clock::now();
-			LOG(LogInfo) << "Saved gamelist.xml for system \"" << system->getName() << "\" in " << std::chrono::duration_cast<std::chrono::milliseconds>(endTs - startTs).count() << " ms";
-		}
-	}else{
-		LOG(LogError) << "Found no root folder for system \"" << system->getName() << "\"!";
+	// 저널에 있던 변경은 메모리에서 changed 상태로 남아 있으므로 이 스냅샷에 같이 들어감
+	std::string journal;
+	if (system->hasGamelistJournal())
+	{
+		journal = handOffJournal(system);
+		system->onGamelistJournalCompacted();
 	}
+
+	//make sure the folders leading up to this path exist (or the write will fail)
+	std::string xmlWritePath(system->getGamelistPath(true));
+	Utils::FileSystem::createDirectory(Utils::FileSystem::getParent(xmlWritePath));
+
+	GamelistWriter::getInstance()->queueGamelist(system->getGamelistPath(false), xmlWritePath, system->getStartPath(), batch, journal);
+
+	// 스냅샷에 들어갔으니 다음 압축에서 다시 쓰지 않게
+	for (auto it = changed.cbegin(); it != changed.cend(); ++it)
+		(*it)->metadata.resetChangedFlag();
 }
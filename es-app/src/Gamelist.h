@@ -3,19 +3,33 @@
 #define ES_APP_GAME_LIST_H
 
 #include <string>
+#include <vector>
 
+class FileData;
 class SystemData;
 namespace pugi { class xml_document; }
 
 // Loads gamelist.xml data into a SystemData.
-void parseGamelist(SystemData* system);
+// RetroPangui: newOnly면 이미 트리에 있던 항목은 건너뛰고 새로 만든 항목의 메타데이터만 읽음(refreshGamelist)
+void parseGamelist(SystemData* system, bool newOnly = false);
 
 // Creates a minimal gamelist.xml from the files already in the FileData tree.
 void generateGamelist(SystemData* system);
 
 // Writes currently loaded metadata for a SystemData to gamelist.xml.
+// RetroPangui: 바뀐 항목만 스냅샷해서 GamelistWriter에 넘김 - 실제 쓰기는 백그라운드에서
 void updateGamelist(SystemData* system);
 
+// RetroPangui: 게임 실행/즐겨찾기처럼 자주 바뀌는 값은 gamelist.xml 전체를 다시 읽고 쓰지 않고
+// gamelist.xml.journal에 "key<TAB>value<TAB>상대경로" 한 줄씩 덧붙인다(값은 증분이 아닌 최종값이라
+// 여러 번 적용해도 같음). 시작할 때 parseGamelist() 다음에 replayGamelistJournal()로 다시 적용하고,
+// updateGamelist()가 저널을 .old.<순번>으로 넘기면 그 저장 작업이 성공한 뒤 지운다.
+// 압축(=updateGamelist)은 SystemData가 유휴 시간/종료 시에.
+std::string getGamelistJournalPath(SystemData* system);
+bool appendGamelistJournal(SystemData* system, const FileData* file, const std::vector<std::string>& keys);
+// 적용한 레코드 수 반환
+unsigned int replayGamelistJournal(SystemData* system);
+
 // RetroPangui: gamelist.xml을 그 자리에서 직접 덮어쓰지 않고 .tmp에 먼저
 // 쓴 뒤 rename()으로 교체 - 쓰는 도중 정전(이 기기의 흔한 종료 방식)이 나도
 // 기존 파일은 깨지지 않는다. 기존 파일은 .old로 백업(이 프로젝트의 OTA
@@ -0,0 +1,251 @@
+#include "GamelistWriter.h"
+
+#include "utils/FileSystemUtil.h"
+#include "Gamelist.h"
+#include "Log.h"
+#include <cstdio>
+#include <unordered_set>
+#include <SDL_timer.h>
+
+GamelistWriter* GamelistWriter::sInstance = nullptr;
+
+GamelistWriter* GamelistWriter::getInstance()
+{
+	if (!sInstance)
+		sInstance = new GamelistWriter();
+
+	return sInstance;
+}
+
+void GamelistWriter::deinit()
+{
+	if (sInstance)
+	{
+		delete sInstance;
+		sInstance = nullptr;
+	}
+}
+
+GamelistWriter::GamelistWriter() : mWriting(0), mFlushRequests(0), mFailed(false), mRunning(true)
+{
+	mThread = std::thread(&GamelistWriter::run, this);
+}
+
+GamelistWriter::~GamelistWriter()
+{
+	flush();
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mRunning = false;
+	}
+	mWakeCondition.notify_one();
+	mThread.join();
+}
+
+GamelistWriter::Job& GamelistWriter::getJob(const std::string& path)
+{
+	auto it = mJobs.find(path);
+	if (it != mJobs.end())
+		return it->second;
+
+	Job& job = mJobs[path];
+	job.isGamelist = false;
+	job.due = Clock::now() + std::chrono::milliseconds(COALESCE_MS);
+	return job;
+}
+
+void GamelistWriter::queueGamelist(const std::string& readPath, const std::string& writePath, const std::string& relativeTo,
+	const Batch& batch, const std::string& removeAfterSave)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		Job& job = getJob(writePath);
+		job.isGamelist = true;
+		job.readPath = readPath;
+		job.relativeTo = relativeTo;
+		job.batches.push_back(batch);
+		if (!removeAfterSave.empty())
+			job.removeAfterSave.push_back(removeAfterSave);
+	}
+	mWakeCondition.notify_one();
+}
+
+void GamelistWriter::queueFile(const std::string& path, const std::string& content)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		Job& job = getJob(path);
+		job.content = content;
+	}
+	mWakeCondition.notify_one();
+}
+
+bool GamelistWriter::flush()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mFlushRequests++;
+	mWakeCondition.notify_one();
+	mIdleCondition.wait(lock, [this] { return mJobs.empty() && mWriting == 0; });
+	mFlushRequests--;
+
+	const bool ok = !mFailed;
+	mFailed = false;
+	return ok;
+}
+
+void GamelistWriter::run()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	while (mRunning || !mJobs.empty())
+	{
+		// 기한이 된 파일(flush 중이면 전부) 하나씩 - 쓰는 동안에는 잠금을 풀어 UI가 계속 요청을 넣을 수 있게
+		const Clock::time_point now = Clock::now();
+		Clock::time_point next = Clock::time_point::max();
+		auto ready = mJobs.end();
+		for (auto it = mJobs.begin(); it != mJobs.end(); ++it)
+		{
+			if (mFlushRequests > 0 || !mRunning || it->second.due <= now)
+			{
+				ready = it;
+				break;
+			}
+			next = std::min(next, it->second.due);
+		}
+
+		if (ready != mJobs.end())
+		{
+			const std::string path = ready->first;
+			const Job job = std::move(ready->second);
+			mJobs.erase(ready);
+			mWriting++;
+
+			lock.unlock();
+			const bool ok = write(path, job);
+			lock.lock();
+
+			mWriting--;
+			if (!ok)
+				mFailed = true;
+			if (mJobs.empty() && mWriting == 0)
+				mIdleCondition.notify_all();
+			continue;
+		}
+
+		if (next == Clock::time_point::max())
+			mWakeCondition.wait(lock);
+		else
+			mWakeCondition.wait_until(lock, next);
+	}
+}
+
+bool GamelistWriter::write(const std::string& path, const Job& job)
+{
+	const unsigned int start = SDL_GetTicks();
+	const bool ok = job.isGamelist ? writeGamelist(path, job) : writeFile(path, job.content);
+	LOG(LogDebug) << "GamelistWriter: wrote \"" << path << "\" in " << (SDL_GetTicks() - start) << " ms" << (ok ? "" : " (failed)");
+	return ok;
+}
+
+bool GamelistWriter::writeGamelist(const std::string& path, const Job& job)
+{
+	//We do this by reading the XML again, adding changes and then writing it back,
+	//because there might be information missing in our systemdata which would then miss in the new XML.
+	pugi::xml_document doc;
+	pugi::xml_node root;
+
+	if (Utils::FileSystem::exists(job.readPath))
+	{
+		pugi::xml_parse_result result = doc.load_file(job.readPath.c_str());
+		if (!result)
+		{
+			LOG(LogError) << "Error parsing XML file \"" << job.readPath << "\"!\n	" << result.description();
+			return false;
+		}
+
+		root = doc.child("gameList");
+		if (!root)
+		{
+			LOG(LogError) << "Could not find <gameList> node in gamelist \"" << job.readPath << "\"!";
+			return false;
+		}
+	}
+	else
+	{
+		root = doc.append_child("gameList");
+	}
+
+	// 여러 번 들어온 요청 중 경로마다 마지막 노드만 - 뒤에서부터 보며 처음 만난 것을 씀
+	std::unordered_set<std::string> changedPaths;
+	std::vector<pugi::xml_node> newNodes;
+	for (auto batch = job.batches.crbegin(); batch != job.batches.crend(); ++batch)
+	{
+		for (auto it = batch->nodes.cbegin(); it != batch->nodes.cend(); ++it)
+		{
+			if (changedPaths.insert(it->first).second && it->second)
+				newNodes.push_back(it->second);
+		}
+	}
+
+	const char* tagList[2] = { "game", "folder" };
+	for (int i = 0; i < 2; i++)
+	{
+		const char* tag = tagList[i];
+		for (pugi::xml_node fileNode = root.child(tag); fileNode; )
+		{
+			pugi::xml_node nextNode = fileNode.next_sibling(tag);
+			pugi::xml_node pathNode = fileNode.child("path");
+			if (!pathNode)
+			{
+				LOG(LogError) << "<" << tag << "> node contains no <path> child!";
+				fileNode = nextNode;
+				continue;
+			}
+
+			// apply the same transformation as in Gamelist::parseGamelist
+			const std::string xmlpath = Utils::FileSystem::resolveRelativePath(pathNode.text().get(), job.relativeTo, false, true);
+			if (changedPaths.find(xmlpath) != changedPaths.cend())
+				root.remove_child(fileNode);
+			fileNode = nextNode;
+		}
+	}
+
+	for (auto it = newNodes.crbegin(); it != newNodes.crend(); ++it)
+		root.append_copy(*it);
+
+	LOG(LogInfo) << "Added/Updated " << changedPaths.size() << " entities in '" << path << "'";
+
+	if (!saveGamelistXml(doc, path))
+	{
+		LOG(LogError) << "Error saving gamelist.xml to \"" << path << "\"!";
+		return false;
+	}
+
+	for (auto it = job.removeAfterSave.cbegin(); it != job.removeAfterSave.cend(); ++it)
+		std::remove(it->c_str());
+
+	return true;
+}
+
+bool GamelistWriter::writeFile(const std::string& path, const std::string& content)
+{
+	const std::string tmpPath = path + ".tmp";
+
+	FILE* file = fopen(tmpPath.c_str(), "wb");
+	if (file == NULL)
+	{
+		LOG(LogError) << "GamelistWriter: failed to create \"" << tmpPath << "\"";
+		return false;
+	}
+
+	const bool written = fwrite(content.data(), 1, content.size(), file) == content.size();
+	if (fclose(file) != 0 || !written || std::rename(tmpPath.c_str(), path.c_str()) != 0)
+	{
+		LOG(LogError) << "GamelistWriter: failed to write \"" << path << "\"";
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+
+	Utils::FileSystem::updateExistsCache(path, true);
+	return true;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#ifndef ES_APP_GAMELIST_WRITER_H
+#define ES_APP_GAMELIST_WRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pugixml.hpp>
+
+// RetroPangui: gamelist.xml/커스텀 컬렉션 파일을 백그라운드 스레드에서 쓰는 저장 서비스.
+// UI 스레드는 바뀐 항목의 노드만 만들어(스냅샷) 넘기고 바로 돌아온다 - 기존 파일 읽기, 항목 교체,
+// 직렬화, .tmp -> rename 교체는 모두 이 스레드가 한다.
+// 같은 파일에 대한 요청은 처음 들어온 뒤 COALESCE_MS 동안 모았다가 한 번에 쓴다
+// (즐겨찾기를 연달아 토글하거나 배치 스크래퍼가 저장할 때 파일을 여러 번 다시 쓰지 않도록).
+// flush()는 남은 쓰기가 모두 끝날 때까지 기다리는 장벽 - 종료할 때, 그리고 gamelist.xml을
+// 직접 읽고 쓰는 곳(refreshGamelist) 앞에서 부른다.
+class GamelistWriter
+{
+public:
+	// 한 번의 저장 요청에 담긴 항목들. nodes: (절대 경로, 새 노드) - 노드가 비어 있으면 기존 항목만 지움
+	struct Batch
+	{
+		std::shared_ptr<pugi::xml_document> doc; // nodes를 담고 있는 문서
+		std::vector<std::pair<std::string, pugi::xml_node>> nodes;
+	};
+
+	static GamelistWriter* getInstance();
+	// 남은 쓰기를 마치고 스레드 종료 - 종료할 때
+	static void deinit();
+
+	// readPath의 gamelist.xml에 batch를 반영해 writePath에 저장. relativeTo는 <path> 해석 기준.
+	// 저장에 성공하면 removeAfterSave(반영이 끝난 저널 등)를 지운다
+	void queueGamelist(const std::string& readPath, const std::string& writePath, const std::string& relativeTo,
+		const Batch& batch, const std::string& removeAfterSave = "");
+	// 파일 전체를 content로 교체
+	void queueFile(const std::string& path, const std::string& content);
+
+	// 지금까지 들어온 요청을 바로 쓰고 끝날 때까지 기다림. 이전 flush() 이후 실패한 쓰기가 없으면 true
+	bool flush();
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	static const int COALESCE_MS = 1000;
+
+	struct Job
+	{
+		bool isGamelist;
+		std::string readPath;
+		std::string relativeTo;
+		std::vector<Batch> batches; // 들어온 순서 - 같은 경로는 나중 것이 이김
+		std::vector<std::string> removeAfterSave;
+		std::string content;
+		Clock::time_point due;
+	};
+
+	GamelistWriter();
+	~GamelistWriter();
+
+	static GamelistWriter* sInstance;
+
+	Job& getJob(const std::string& path);
+	void run();
+	bool write(const std::string& path, const Job& job);
+	bool writeGamelist(const std::string& path, const Job& job);
+	bool writeFile(const std::string& path, const std::string& content);
+
+	std::mutex mMutex;
+	std::condition_variable mWakeCondition;
+	std::condition_variable mIdleCondition;
+	std::map<std::string, Job> mJobs; // 쓸 파일 경로 기준
+	unsigned int mWriting;
+	unsigned int mFlushRequests;
+	bool mFailed;
+	bool mRunning;
+	std::thread mThread;
+};
+
+#endif // ES_APP_GAMELIST_WRITER_H
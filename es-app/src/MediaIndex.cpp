@@ -0,0 +1,433 @@
+#include "MediaIndex.h"
+
+#include "utils/FileSystemUtil.h"
+#include "FileData.h"
+#include "ImageIO.h"
+#include "Log.h"
+#include "Settings.h"
+#include "SystemData.h"
+#include <pugixml.hpp>
+#include <SDL_timer.h>
+#include <sys/stat.h>
+
+static const char* MEDIA_TYPE_NAMES[MEDIA_TYPE_COUNT] = { "video", "image", "thumbnail", "marquee" };
+
+MediaIndex::MediaIndex(const std::string& systemName) : mSystemName(systemName), mDirty(false)
+{
+}
+
+MediaIndex::~MediaIndex()
+{
+}
+
+// 경로 해석에 영향을 주는 값만 모은 것 - 저장된 레코드와 같으면 게터(로컬 아트 exists 탐색)를 건너뜀.
+// 로컬 아트를 쓰면 그 폴더의 수정 시각도 넣어서 새로 넣거나 지운 로컬 이미지/비디오를 놓치지 않게 한다. 잠금 안에서 호출
+std::string MediaIndex::getSignature(const FileData* game)
+{
+	std::string signature;
+	for (int i = 0; i < MEDIA_TYPE_COUNT; i++)
+	{
+		signature += game->metadata.get(MEDIA_TYPE_NAMES[i]);
+		signature += '\n';
+	}
+
+	if (!Settings::getInstance()->getBool("LocalArt"))
+		return signature + "0";
+
+	const std::string& startPath = game->getSystemEnvData()->mStartPath;
+	std::unordered_map<std::string, std::string>::const_iterator stamp = mLocalArtStamps.find(startPath);
+	if (stamp == mLocalArtStamps.cend())
+	{
+		struct stat st;
+		const std::string dir = startPath + "/images";
+		stamp = mLocalArtStamps.insert(std::make_pair(startPath, stat(dir.c_str(), &st) == 0 ? std::to_string((long long)st.st_mtime) : std::string("-"))).first;
+	}
+	return signature + "1:" + stamp->second;
+}
+
+void MediaIndex::resolvePaths(FileData* game, Entry& entry)
+{
+	entry.media[MEDIA_VIDEO].path = game->getVideoPath();
+	entry.media[MEDIA_IMAGE].path = game->getImagePath();
+	entry.media[MEDIA_THUMBNAIL].path = game->getThumbnailPath();
+	entry.media[MEDIA_MARQUEE].path = game->getMarqueePath();
+	for (int i = 0; i < MEDIA_TYPE_COUNT; i++)
+	{
+		entry.media[i].size = -1;
+		entry.media[i].mtime = 0;
+		entry.media[i].width = 0;
+		entry.media[i].height = 0;
+		entry.stale[i] = false;
+	}
+}
+
+// 파일 크기와 (이미지면) 헤더만 읽은 가로/세로. 파일이 없으면 size = 0
+void MediaIndex::probeFile(MediaType type, MediaInfo& info)
+{
+	info.width = 0;
+	info.height = 0;
+
+	struct stat st;
+	if (info.path.empty() || stat(info.path.c_str(), &st) != 0)
+	{
+		info.size = 0;
+		info.mtime = 0;
+		return;
+	}
+	info.size = (long long)st.st_size;
+	info.mtime = (long long)st.st_mtime;
+
+	if (type != MEDIA_VIDEO)
+		ImageIO::loadImageSize(info.path, info.width, info.height);
+}
+
+// 저장된 레코드 재확인 - 크기/수정 시각이 그대로면 stat 한 번으로 끝, 바뀌었거나 새로 생겼으면 다시 확인
+void MediaIndex::verifyFile(MediaType type, MediaInfo& info)
+{
+	struct stat st;
+	if (!info.path.empty() && stat(info.path.c_str(), &st) == 0 && info.size > 0 &&
+		(long long)st.st_size == info.size && (long long)st.st_mtime == info.mtime)
+		return;
+
+	probeFile(type, info);
+}
+
+// 미디어가 있는 게임 밀집 배열 - 지울 때는 마지막 원소와 자리를 바꿔서 O(1)
+void MediaIndex::setSlot(FileData* game, Entry& entry, MediaType type, bool present)
+{
+	std::vector<FileData*>& list = mWithMedia[type];
+	const int slot = entry.slot[type];
+
+	if (present && slot < 0)
+	{
+		entry.slot[type] = (int)list.size();
+		list.push_back(game);
+	}
+	else if (!present && slot >= 0)
+	{
+		FileData* last = list.back();
+		list[slot] = last;
+		mEntries[last].slot[type] = slot;
+		list.pop_back();
+		entry.slot[type] = -1;
+	}
+}
+
+void MediaIndex::insertEntry(FileData* game, Entry& entry)
+{
+	for (int i = 0; i < MEDIA_TYPE_COUNT; i++)
+	{
+		entry.slot[i] = -1;
+		// 아직 확인 전(size < 0)이면 경로가 있는 것만으로 후보 - 없는 파일은 probePending()이 빼냄
+		setSlot(game, entry, (MediaType)i, !entry.media[i].path.empty() && entry.media[i].size != 0);
+	}
+}
+
+void MediaIndex::eraseEntry(const FileData* /*game*/, Entry& entry)
+{
+	for (int i = 0; i < MEDIA_TYPE_COUNT; i++)
+		setSlot(nullptr, entry, (MediaType)i, false);
+}
+
+void MediaIndex::addToIndex(FileData* game)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mEntries.find(game) != mEntries.cend())
+		return;
+
+	const std::string signature = getSignature(game);
+	Entry& entry = mEntries[game];
+	std::unordered_map<std::string, Entry>::iterator stored = mStored.find(game->getPath());
+	if (stored != mStored.end() && stored->second.signature == signature)
+	{
+		// 경로는 그대로 믿지만 파일 자체는 그 뒤에 지워지거나 바뀌었을 수 있음 - probePending()이 다시 stat
+		entry = stored->second;
+		for (int i = 0; i < MEDIA_TYPE_COUNT; i++)
+			entry.stale[i] = entry.media[i].size >= 0 && !entry.media[i].path.empty();
+	}
+	else
+	{
+		resolvePaths(game, entry);
+		entry.signature = signature;
+		mDirty = true;
+	}
+	insertEntry(game, entry);
+}
+
+void MediaIndex::removeFromIndex(FileData* game)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	std::unordered_map<const FileData*, Entry>::iterator it = mEntries.find(game);
+	if (it == mEntries.end())
+		return;
+
+	eraseEntry(game, it->second);
+	mEntries.erase(it);
+	mDirty = true;
+}
+
+// 메타데이터 편집/스크래핑 후 호출. 같은 경로에 파일이 새로 받아졌을 수도 있으니 시그니처와 무관하게 다시 해석
+void MediaIndex::refreshFile(FileData* game)
+{
+	Entry fresh;
+	resolvePaths(game, fresh);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	std::unordered_map<const FileData*, Entry>::iterator it = mEntries.find(game);
+	if (it == mEntries.end())
+		return;
+
+	// 로컬 아트 폴더도 방금 바뀌었을 수 있음
+	mLocalArtStamps.erase(game->getSystemEnvData()->mStartPath);
+
+	for (int i = 0; i < MEDIA_TYPE_COUNT; i++)
+	{
+		it->second.media[i] = fresh.media[i];
+		it->second.stale[i] = false;
+		setSlot(game, it->second, (MediaType)i, !fresh.media[i].path.empty());
+	}
+	it->second.signature = getSignature(game);
+	mDirty = true;
+}
+
+// 게임 목록을 다시 읽기 전에 호출 - 현재 항목은 경로 기준 레코드로 남겨 두어 재등록 시 그대로 재사용
+void MediaIndex::resetIndex()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	for (std::unordered_map<const FileData*, Entry>::const_iterator it = mEntries.cbegin(); it != mEntries.cend(); ++it)
+		mStored[it->first->getPath()] = it->second;
+
+	mEntries.clear();
+	mLocalArtStamps.clear();
+	for (int i = 0; i < MEDIA_TYPE_COUNT; i++)
+		mWithMedia[i].clear();
+}
+
+bool MediaIndex::hasMedia(const FileData* game, MediaType type) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	std::unordered_map<const FileData*, Entry>::const_iterator it = mEntries.find(game);
+	return it != mEntries.cend() && it->second.slot[type] >= 0;
+}
+
+bool MediaIndex::getMedia(const FileData* game, MediaType type, MediaInfo& out) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	std::unordered_map<const FileData*, Entry>::const_iterator it = mEntries.find(game);
+	if (it == mEntries.cend())
+		return false;
+
+	out = it->second.media[type];
+	return true;
+}
+
+size_t MediaIndex::getCount(MediaType type) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mWithMedia[type].size();
+}
+
+FileData* MediaIndex::getRandomGame(MediaType type, std::ranlux48& urng) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	const std::vector<FileData*>& list = mWithMedia[type];
+	if (list.empty())
+		return nullptr;
+
+	std::uniform_int_distribution<size_t> dist(0, list.size() - 1);
+	return list[dist(urng)];
+}
+
+size_t MediaIndex::probePending(size_t maxCount, const bool* abort)
+{
+	struct Pending
+	{
+		const FileData* game;
+		MediaType type;
+		MediaInfo info;
+	};
+
+	// 잠금은 목록 수집/결과 반영 때만 - 실제 stat/헤더 읽기는 잠금 밖에서
+	std::vector<Pending> pending;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		for (std::unordered_map<const FileData*, Entry>::const_iterator it = mEntries.cbegin(); it != mEntries.cend() && pending.size() < maxCount; ++it)
+		{
+			for (int i = 0; i < MEDIA_TYPE_COUNT; i++)
+			{
+				if ((it->second.media[i].size < 0 || it->second.stale[i]) && !it->second.media[i].path.empty())
+				{
+					Pending p = { it->first, (MediaType)i, it->second.media[i] };
+					pending.push_back(p);
+				}
+			}
+		}
+	}
+
+	size_t probed = 0;
+	for (std::vector<Pending>::iterator it = pending.begin(); it != pending.end(); ++it)
+	{
+		if (abort != nullptr && *abort)
+			break;
+		if (it->info.size < 0)
+			probeFile(it->type, it->info);
+		else
+			verifyFile(it->type, it->info);
+		probed++;
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	for (size_t i = 0; i < probed; i++)
+	{
+		std::unordered_map<const FileData*, Entry>::iterator it = mEntries.find(pending[i].game);
+		// 그 사이 경로가 바뀌었으면(refreshFile) 결과를 버린다
+		if (it == mEntries.end() || it->second.media[pending[i].type].path != pending[i].info.path)
+			continue;
+
+		it->second.media[pending[i].type] = pending[i].info;
+		it->second.stale[pending[i].type] = false;
+		setSlot(const_cast<FileData*>(it->first), it->second, pending[i].type, pending[i].info.size != 0);
+	}
+	if (probed > 0)
+		mDirty = true;
+
+	return probed;
+}
+
+std::string MediaIndex::getIndexPath() const
+{
+	return Utils::FileSystem::getHomePath() + "/.emulationstation/media_index/" + mSystemName + ".xml";
+}
+
+void MediaIndex::load()
+{
+	const std::string path = getIndexPath();
+	if (!Utils::FileSystem::exists(path))
+		return;
+
+	const unsigned int start = SDL_GetTicks();
+	pugi::xml_document doc;
+	pugi::xml_parse_result result = doc.load_file(path.c_str());
+	if (!result)
+	{
+		LOG(LogWarning) << "MediaIndex: 인덱스 파싱 실패 (" << path << ") - " << result.description();
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	for (pugi::xml_node gameNode = doc.child("mediaIndex").child("game"); gameNode; gameNode = gameNode.next_sibling("game"))
+	{
+		Entry& entry = mStored[gameNode.attribute("path").as_string()];
+		entry.signature = gameNode.attribute("signature").as_string();
+		for (int i = 0; i < MEDIA_TYPE_COUNT; i++)
+		{
+			pugi::xml_node mediaNode = gameNode.child(MEDIA_TYPE_NAMES[i]);
+			if (!mediaNode)
+				continue;
+			entry.media[i].path = mediaNode.attribute("path").as_string();
+			entry.media[i].size = mediaNode.attribute("size").as_llong(-1);
+			entry.media[i].mtime = mediaNode.attribute("mtime").as_llong(0);
+			entry.media[i].width = mediaNode.attribute("width").as_uint();
+			entry.media[i].height = mediaNode.attribute("height").as_uint();
+		}
+	}
+	LOG(LogDebug) << "MediaIndex: \"" << mSystemName << "\" " << mStored.size() << "개 로드 (" << SDL_GetTicks() - start << "ms)";
+}
+
+void MediaIndex::save()
+{
+	pugi::xml_document doc;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (!mDirty)
+			return;
+		mDirty = false;
+
+		pugi::xml_node root = doc.append_child("mediaIndex");
+		for (std::unordered_map<const FileData*, Entry>::const_iterator it = mEntries.cbegin(); it != mEntries.cend(); ++it)
+		{
+			pugi::xml_node gameNode = root.append_child("game");
+			gameNode.append_attribute("path").set_value(it->first->getPath().c_str());
+			gameNode.append_attribute("signature").set_value(it->second.signature.c_str());
+			for (int i = 0; i < MEDIA_TYPE_COUNT; i++)
+			{
+				const MediaInfo& info = it->second.media[i];
+				if (info.path.empty())
+					continue;
+				pugi::xml_node mediaNode = gameNode.append_child(MEDIA_TYPE_NAMES[i]);
+				mediaNode.append_attribute("path").set_value(info.path.c_str());
+				mediaNode.append_attribute("size").set_value(info.size);
+				if (info.mtime > 0)
+					mediaNode.append_attribute("mtime").set_value(info.mtime);
+				if (info.width > 0)
+				{
+					mediaNode.append_attribute("width").set_value(info.width);
+					mediaNode.append_attribute("height").set_value(info.height);
+				}
+			}
+		}
+	}
+
+	const std::string path = getIndexPath();
+	const std::string dir = Utils::FileSystem::getParent(path);
+	if (!Utils::FileSystem::exists(dir))
+		Utils::FileSystem::createDirectory(dir);
+
+	if (!doc.save_file(path.c_str()))
+		LOG(LogWarning) << "MediaIndex: 인덱스 저장 실패 - " << path;
+}
+
+MediaIndex* MediaIndex::getIndexFor(FileData* file)
+{
+	if (file == nullptr)
+		return nullptr;
+
+	FileData* source = file->getSourceFileData();
+	if (source->getType() != GAME || source->getSystem() == nullptr || source->getSystem()->isCollection())
+		return nullptr;
+
+	return source->getSystem()->getMediaIndex();
+}
+
+std::string MediaIndex::getMediaPath(FileData* file, MediaType type)
+{
+	MediaIndex* index = getIndexFor(file);
+	MediaInfo info;
+	if (index != nullptr && index->getMedia(file->getSourceFileData(), type, info))
+		return info.size == 0 ? "" : info.path;
+
+	switch (type)
+	{
+		case MEDIA_VIDEO:     return file->getVideoPath();
+		case MEDIA_IMAGE:     return file->getImagePath();
+		case MEDIA_THUMBNAIL: return file->getThumbnailPath();
+		case MEDIA_MARQUEE:   return file->getMarqueePath();
+		default:              return "";
+	}
+}
+
+FileData* MediaIndex::getRandomGameFromAllSystems(MediaType type, std::ranlux48& urng)
+{
+	size_t total = 0;
+	for (std::vector<SystemData*>::const_iterator it = SystemData::sSystemVector.cbegin(); it != SystemData::sSystemVector.cend(); ++it)
+	{
+		if ((*it)->isGameSystem() && !(*it)->isCollection())
+			total += (*it)->getMediaIndex()->getCount(type);
+	}
+	if (total == 0)
+		return nullptr;
+
+	// 시스템 수만큼만 순회 - 게임 수와 무관
+	size_t pick = std::uniform_int_distribution<size_t>(0, total - 1)(urng);
+	for (std::vector<SystemData*>::const_iterator it = SystemData::sSystemVector.cbegin(); it != SystemData::sSystemVector.cend(); ++it)
+	{
+		if (!(*it)->isGameSystem() || (*it)->isCollection())
+			continue;
+
+		const size_t count = (*it)->getMediaIndex()->getCount(type);
+		if (pick < count)
+			return (*it)->getMediaIndex()->getRandomGame(type, urng);
+		pick -= count;
+	}
+	return nullptr;
+}
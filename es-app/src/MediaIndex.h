@@ -0,0 +1,103 @@
+#pragma once
+#ifndef ES_APP_MEDIA_INDEX_H
+#define ES_APP_MEDIA_INDEX_H
+
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FileData;
+
+enum MediaType
+{
+	MEDIA_VIDEO = 0,
+	MEDIA_IMAGE,
+	MEDIA_THUMBNAIL,
+	MEDIA_MARQUEE,
+
+	MEDIA_TYPE_COUNT
+};
+
+struct MediaInfo
+{
+	std::string path;   // 해석된 경로(FileData::getVideoPath() 등), 없으면 빈 문자열
+	long long size;     // 확인 전 -1, 파일이 없으면 0
+	long long mtime;    // 확인할 때의 수정 시각, 모르면 0
+	unsigned int width; // 이미지만, 모르면 0
+	unsigned int height;
+
+	MediaInfo() : size(-1), mtime(0), width(0), height(0) {}
+};
+
+// RetroPangui: 시스템별 미디어 보유 인덱스. 게임마다 비디오/이미지/썸네일/마퀴 경로를
+// 한 번만 해석해 두고, 타입별로 "그 미디어가 있는 게임" 밀집 배열을 유지해서
+// 스크린세이버/게임 목록 뷰가 파일시스템을 뒤지지 않고 O(1)로 후보를 고를 수 있게 한다.
+// FileFilterIndex와 같은 지점에서 addToIndex()/removeFromIndex()로 갱신되고, 메타데이터가
+// 바뀐 게임은 refreshFile()로 다시 해석한다(미디어 관련 메타데이터가 그대로면 no-op).
+// 파일 크기/이미지 크기는 비싸서 probePending()이 백그라운드에서 채우며, 결과는
+// ~/.emulationstation/media_index/<system>.xml에 저장돼 다음 실행 때 재사용된다. 재사용한 레코드는
+// probePending()이 stat만 다시 해서 크기/수정 시각이 그대로인지 확인한다(지워지거나 바뀐 파일 반영).
+// 스크린세이버의 백그라운드 스레드가 probePending()을 부르므로 공개 함수는 모두 잠금을 잡는다.
+class MediaIndex
+{
+public:
+	MediaIndex(const std::string& systemName);
+	~MediaIndex();
+
+	void addToIndex(FileData* game);
+	void removeFromIndex(FileData* game);
+	void refreshFile(FileData* game);
+	void resetIndex();
+
+	bool hasMedia(const FileData* game, MediaType type) const;
+	bool getMedia(const FileData* game, MediaType type, MediaInfo& out) const;
+	size_t getCount(MediaType type) const;
+	FileData* getRandomGame(MediaType type, std::ranlux48& urng) const;
+
+	// 확인 전(또는 저장된 레코드에서 가져와 재확인 전) 파일을 최대 maxCount개 stat/헤더 읽기,
+	// 실제로 확인한 개수 반환. *abort가 true가 되면 중단
+	size_t probePending(size_t maxCount, const bool* abort = nullptr);
+
+	void load();
+	void save();
+
+	// 게임의 원본 시스템 인덱스(컬렉션 항목이면 원본 게임 기준), 게임이 아니면 nullptr
+	static MediaIndex* getIndexFor(FileData* file);
+	// 인덱스에 있으면 그 경로, 없으면 FileData 게터(파일시스템 탐색 가능)
+	static std::string getMediaPath(FileData* file, MediaType type);
+	// 전체 게임 시스템에서 해당 미디어가 있는 게임 하나 - 시스템별 개수로 가중치
+	static FileData* getRandomGameFromAllSystems(MediaType type, std::ranlux48& urng);
+
+private:
+	struct Entry
+	{
+		std::string signature; // 경로를 해석할 때 쓴 미디어 관련 메타데이터
+		MediaInfo media[MEDIA_TYPE_COUNT];
+		int slot[MEDIA_TYPE_COUNT]; // mWithMedia 안의 위치, 없으면 -1
+		bool stale[MEDIA_TYPE_COUNT]; // 저장된 레코드에서 가져와 이번 실행에서 아직 stat 안 함
+	};
+
+	std::string getSignature(const FileData* game);
+	static void resolvePaths(FileData* game, Entry& entry);
+	static void probeFile(MediaType type, MediaInfo& info);
+	static void verifyFile(MediaType type, MediaInfo& info);
+
+	void insertEntry(FileData* game, Entry& entry);
+	void eraseEntry(const FileData* game, Entry& entry);
+	void setSlot(FileData* game, Entry& entry, MediaType type, bool present);
+	std::string getIndexPath() const;
+
+	std::string mSystemName;
+	mutable std::mutex mMutex;
+	std::unordered_map<const FileData*, Entry> mEntries;
+	std::vector<FileData*> mWithMedia[MEDIA_TYPE_COUNT];
+	// 인덱스 파일(또는 resetIndex() 이전)의 레코드 - 게임 경로 기준
+	std::unordered_map<std::string, Entry> mStored;
+	// 로컬 아트 폴더(<롬 폴더>/images)의 수정 시각 - 파일이 추가/삭제되면 바뀌어 시그니처가 달라짐
+	std::unordered_map<std::string, std::string> mLocalArtStamps;
+	bool mDirty;
+};
+
+#endif // ES_APP_MEDIA_INDEX_H
@@ -1,10 +1,13 @@
 #include "MetaData.h"
 
 #include "utils/FileSystemUtil.h"
+#include "FileData.h"
 #include "utils/TimeUtil.h"
 #include "Log.h"
 #include <pugixml.hpp>
 
+std::atomic<unsigned int> MetaDataList::sGeneration(0);
+
 MetaDataDecl gameDecls[] = {
 	// key,         type,                   default,            statistic,  name in GuiMetaDataEd,  prompt in GuiMetaDataEd
 	{"name",        MD_STRING,              "",                 false,      "name",                 "enter game name"},
@@ -69,13 +72,97 @@ const std::vector<MetaDataDecl>& getMDDByType(MetaDataListType type)
 
 
 MetaDataList::MetaDataList(MetaDataListType type)
-	: mType(type), mWasChanged(false)
+	: mType(type), mWasChanged(false), mShared(nullptr), mOwner(nullptr)
 {
 	const std::vector<MetaDataDecl>& mdd = getMDD();
 	for(auto iter = mdd.cbegin(); iter != mdd.cend(); iter++)
 		set(iter->key, iter->defaultValue);
 }
 
+MetaDataList::MetaDataList(const MetaDataList& other)
+	: mType(other.mType), mWasChanged(other.mWasChanged), mShared(nullptr), mOwner(nullptr)
+{
+	*this = other;
+}
+
+MetaDataList& MetaDataList::operator=(const MetaDataList& other)
+{
+	if(this == &other)
+		return *this;
+
+	// 소유자가 있으면 바뀐 값을 알려야 하므로 이전 값을 잡아 둠
+	std::map<std::string, std::string> previous;
+	if(mOwner)
+	{
+		const std::vector<MetaDataDecl>& mdd = getMDD();
+		for(auto it = mdd.cbegin(); it != mdd.cend(); it++)
+			previous[it->key] = get(it->key);
+	}
+
+	mType = other.mType;
+	mWasChanged = other.mWasChanged;
+	mShared = nullptr;
+	if(other.mShared)
+	{
+		// source values, with the snapshot on top (what other.get() would return)
+		mMap = other.mShared->mMap;
+		for(auto it = other.mMap.cbegin(); it != other.mMap.cend(); it++)
+			mMap[it->first] = it->second;
+	}
+	else
+	{
+		mMap = other.mMap;
+	}
+
+	if(mOwner)
+	{
+		bool changed = false;
+		for(auto it = mMap.cbegin(); it != mMap.cend(); it++)
+		{
+			const std::string& oldValue = previous[it->first];
+			if(oldValue == it->second)
+				continue;
+
+			changed = true;
+			mOwner->onMetaDataChanged(it->first, oldValue, it->second);
+		}
+		if(changed)
+			sGeneration.fetch_add(1, std::memory_order_relaxed);
+	}
+	return *this;
+}
+
+void MetaDataList::share(MetaDataList* source, const std::vector<std::string>& snapshotKeys)
+{
+	mShared = source;
+	mMap.clear();
+	for(auto it = snapshotKeys.cbegin(); it != snapshotKeys.cend(); it++)
+	{
+		auto value = source->mMap.find(*it);
+		if(value != source->mMap.cend())
+			mMap[*it] = value->second;
+	}
+}
+
+void MetaDataList::refreshShared()
+{
+	if(!mShared)
+		return;
+
+	for(auto it = mMap.begin(); it != mMap.end(); it++)
+	{
+		const std::string& value = mShared->get(it->first);
+		if(it->second != value)
+		{
+			std::string previous(value);
+			previous.swap(it->second);
+			sGeneration.fetch_add(1, std::memory_order_relaxed);
+			if(mOwner)
+				mOwner->onMetaDataChanged(it->first, previous, it->second);
+		}
+	}
+}
+
 
 MetaDataList MetaDataList::createFromXML(MetaDataListType type, pugi::xml_node& node, const std::string& relativeTo)
 {
@@ -105,6 +192,13 @@ MetaDataList MetaDataList::createFromXML(MetaDataListType type, pugi::xml_node&
 
 void MetaDataList::appendToXML(pugi::xml_node& parent, bool ignoreDefaults, const std::string& relativeTo) const
 {
+	if(mShared)
+	{
+		MetaDataList copy(*this);
+		copy.appendToXML(parent, ignoreDefaults, relativeTo);
+		return;
+	}
+
 	const std::vector<MetaDataDecl>& mdd = getMDD();
 
 	for(auto mddIter = mdd.cbegin(); mddIter != mdd.cend(); mddIter++)
@@ -129,12 +223,32 @@ void MetaDataList::appendToXML(pugi::xml_node& parent, bool ignoreDefaults, cons
 
 void MetaDataList::set(const std::string& key, const std::string& value)
 {
-	mMap[key] = value;
+	if(mShared)
+	{
+		mShared->set(key, value);
+		return;
+	}
+
 	mWasChanged = true;
+	std::string& current = mMap[key];
+	if(current == value)
+		return;
+
+	std::string previous(value);
+	previous.swap(current);
+	sGeneration.fetch_add(1, std::memory_order_relaxed);
+	if(mOwner)
+		mOwner->onMetaDataChanged(key, previous, current);
 }
 
 const std::string& MetaDataList::get(const std::string& key) const
 {
+	if(mShared)
+	{
+		auto it = mMap.find(key);
+		return it != mMap.cend() ? it->second : mShared->get(key);
+	}
+
 	return mMap.at(key);
 }
 
@@ -2,10 +2,12 @@
 #ifndef ES_APP_META_DATA_H
 #define ES_APP_META_DATA_H
 
+#include <atomic>
 #include <map>
 #include <vector>
 #include <string>
 
+class FileData;
 namespace pugi { class xml_node; }
 
 enum MetaDataType
@@ -49,6 +51,19 @@ public:
 	void appendToXML(pugi::xml_node& parent, bool ignoreDefaults, const std::string& relativeTo) const;
 
 	MetaDataList(MetaDataListType type);
+	// copies of a shared list are standalone lists holding the source's values
+	MetaDataList(const MetaDataList& other);
+	MetaDataList& operator=(const MetaDataList& other);
+
+	// RetroPangui: 컬렉션 항목용 공유 모드. 원본 메타데이터를 복사하지 않고 source에서 바로 읽고
+	// set()도 source로 넘긴다. snapshotKeys(필터 인덱스 키와 정렬 키)만 이 목록에 복사해 두어 refreshShared()
+	// 전까지 이전 값을 유지한다 - FileFilterIndex에서 뺄 때 넣었던 키, 정렬된 자리와 같아야 하기 때문.
+	void share(MetaDataList* source, const std::vector<std::string>& snapshotKeys);
+	void refreshShared();
+
+	// RetroPangui: 이 목록을 가진 FileData - 값이 바뀔 때마다 FileData::onMetaDataChanged()로 알려
+	// 폴더 집계(즐겨찾기 수, 최근 lastplayed)를 바로 갱신한다. 복사본에는 넘어가지 않음
+	inline void setOwner(FileData* owner) { mOwner = owner; }
 
 	void set(const std::string& key, const std::string& value);
 
@@ -59,6 +74,10 @@ public:
 	bool wasChanged() const;
 	void resetChangedFlag();
 
+	// RetroPangui: FileData가 가진 MetaDataList의 값이 바뀔 때마다 증가(소유자 없는 복사본은 제외) -
+	// 메타데이터에서 계산한 집계(즐겨찾기 수 등)의 캐시 키. 메인 스레드 밖에서도 바뀔 수 있어 atomic
+	static inline unsigned int getGeneration() { return sGeneration.load(std::memory_order_relaxed); }
+
 	inline MetaDataListType getType() const { return mType; }
 	inline const std::vector<MetaDataDecl>& getMDD() const { return getMDDByType(getType()); }
 
@@ -66,6 +85,10 @@ private:
 	MetaDataListType mType;
 	std::map<std::string, std::string> mMap;
 	bool mWasChanged;
+	MetaDataList* mShared;
+	FileData* mOwner;
+
+	static std::atomic<unsigned int> sGeneration;
 };
 
 #endif // ES_APP_META_DATA_H
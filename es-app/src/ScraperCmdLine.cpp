@@ -1,9 +1,16 @@
 #include "ScraperCmdLine.h"
 
+#include "scrapers/RomHasher.h"
+#include "scrapers/ScraperBatch.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "FileData.h"
 #include "Log.h"
 #include "platform.h"
 #include "SystemData.h"
 #include <iostream>
+#include <sstream>
+#include <thread>
 #include <signal.h>
 #if defined(__linux__)
 #include <unistd.h>
@@ -13,15 +20,151 @@
 
 std::ostream& out = std::cout;
 
+// RetroPangui: Ctrl+C는 플래그만 세우고, 배치 루프가 진행 중인 작업을 버린 뒤 지금까지 받은
+// 결과를 gamelist.xml에 저장하고 끝낸다(예전엔 저장 없이 바로 종료).
+static volatile sig_atomic_t sInterrupted = 0;
+
 void handle_interrupt_signal(int /*p*/)
 {
-	sleep(50);
+	sInterrupted = 1;
+}
+
+static int run_scraper_batch(const std::vector<SystemData*>& systems, bool missingImagesOnly, bool manualMode, int concurrency)
+{
+	std::queue<ScraperSearchParams> searches;
+	unsigned int alreadyScraped = 0;
+	for(auto sysIt = systems.cbegin(); sysIt != systems.cend(); sysIt++)
+	{
+		std::vector<FileData*> files = (*sysIt)->getRootFolder()->getFilesRecursive(GAME);
+		for(auto gameIt = files.cbegin(); gameIt != files.cend(); gameIt++)
+		{
+			//maybe should also check if the image file exists/is a URL
+			if(missingImagesOnly && !(*gameIt)->metadata.get("image").empty())
+			{
+				alreadyScraped++;
+				continue;
+			}
+
+			ScraperSearchParams params;
+			params.system = *sysIt;
+			params.game = *gameIt;
+			searches.push(params);
+		}
+	}
+
+	if(alreadyScraped > 0)
+		out << "Skipping " << alreadyScraped << " games that already have an image.\n";
+
+	if(searches.empty())
+	{
+		out << "Nothing to scrape.\n";
+		return 0;
+	}
+
+	out << "Scraping " << searches.size() << " games, " << concurrency << " at a time...\n\n";
+
+	ScraperBatch batch(searches, concurrency);
+
+	if(manualMode)
+	{
+		// runs from batch.update(), the other searches simply wait while the user chooses
+		batch.setChooseFunc([](const ScraperSearchParams& params, const std::vector<ScraperSearchResult>& results) -> int
+		{
+			out << Utils::FileSystem::getFileName(params.game->getPath()) << ":\n";
+			for(unsigned int i = 0; i < results.size(); i++)
+				out << "   " << i << " - " << results.at(i).mdl.get("name") << "\n";
+
+			do {
+				out << "Your choice (nothing to skip): ";
+
+				std::string choice_str;
+				std::getline(std::cin, choice_str);
+				if(choice_str.empty())
+					return -1;
+
+				int choice = -1;
+				std::stringstream choice_buff(choice_str); //convert to int
+				choice_buff >> choice;
+				if(choice >= 0 && choice < (int)results.size())
+					return choice;
+
+				out << "Invalid choice.\n";
+			} while(true);
+		});
+	}
+
+	batch.setProgressFunc([&batch](const ScraperSearchParams& params, ScraperBatch::Outcome outcome, const std::string& message)
+	{
+		out << "[" << batch.getFinished() << "/" << batch.getTotal() << "] " << Utils::FileSystem::getFileName(params.game->getPath());
+		switch(outcome)
+		{
+			case ScraperBatch::SCRAPED: out << " -> " << message << "\n"; break;
+			case ScraperBatch::SKIPPED: out << " - skipped (" << message << ")\n"; break;
+			case ScraperBatch::FAILED:  out << " - FAILED: " << message << "\n"; break;
+		}
+	});
+
+	while(!batch.isDone())
+	{
+		if(sInterrupted)
+		{
+			out << "\nInterrupted, saving what has been scraped so far...\n";
+			batch.cancel();
+			break;
+		}
+
+		batch.update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	out << "\n\n";
+	out << "==============================\n";
+	out << (sInterrupted ? "SCRAPE INTERRUPTED!\n" : "SCRAPE COMPLETE!\n");
+	out << "==============================\n";
+	out << batch.getScraped() << " scraped, " << batch.getSkipped() << " skipped, " << batch.getFailed() << " failed.\n";
+
+	return batch.getFailed() > 0 || sInterrupted ? 1 : 0;
+}
+
+int run_scraper_batch_cmdline(const std::string& systemNames, bool missingImagesOnly, bool hashRoms)
+{
+	signal(SIGINT, handle_interrupt_signal);
+
+	std::vector<SystemData*> systems;
+	std::vector<std::string> names = Utils::String::delimitedStringToVector(systemNames, ",");
+	for(auto i = SystemData::sSystemVector.cbegin(); i != SystemData::sSystemVector.cend(); i++)
+	{
+		if(!(*i)->isGameSystem() || (*i)->isCollection())
+			continue;
 
-	LOG(LogInfo) << "Interrupt received during scrape...";
+		if(systemNames == "all" || std::find(names.cbegin(), names.cend(), (*i)->getName()) != names.cend())
+			systems.push_back(*i);
+	}
+
+	if(systems.empty())
+	{
+		out << "No matching systems for \"" << systemNames << "\".\n";
+		return 1;
+	}
+
+	if(hashRoms)
+	{
+		std::vector<FileData*> games;
+		for(auto system : systems)
+		{
+			std::vector<FileData*> files = system->getRootFolder()->getFilesRecursive(GAME);
+			games.insert(games.end(), files.cbegin(), files.cend());
+		}
 
-	SystemData::deleteSystems();
+		out << "Hashing ROMs...\n";
+		size_t hashed = RomHasher::getInstance()->hashGames(games, [](size_t done, size_t total)
+		{
+			out << "\r   " << done << "/" << total << std::flush;
+		});
+		out << "\r   " << hashed << " hashed, " << (games.size() - hashed) << " already up to date.\n\n";
+	}
 
-	exit(1);
+	return run_scraper_batch(systems, missingImagesOnly, false, ScraperBatch::getConfiguredConcurrency());
 }
 
 int run_scraper_cmdline()
@@ -143,148 +286,5 @@ int run_scraper_cmdline()
 	out << "Alright, let's do this thing!\n";
 	out << "=============================\n";
 
-	/*
-	std::shared_ptr<Scraper> scraper = Settings::getInstance()->getScraper();
-	for(auto sysIt = systems.cbegin(); sysIt != systems.cend(); sysIt++)
-	{
-		std::vector<FileData*> files = (*sysIt)->getRootFolder()->getFilesRecursive(GAME);
-
-		ScraperSearchParams params;
-		params.system = (*sysIt);
-
-		for(auto gameIt = files.cbegin(); gameIt != files.cend(); gameIt++)
-		{
-			params.nameOverride = "";
-			params.game = *gameIt;
-
-			//print original search term
-			out << getCleanFileName(params.game->getPath()) << "...\n";
-
-			//need to take into account filter_choice
-			if(filter_choice == FILTER_MISSING_IMAGES)
-			{
-				if(!params.game->metadata.get("image").empty()) //maybe should also check if the image file exists/is a URL
-				{
-					out << "   Skipping, metadata \"image\" entry is not empty.\n";
-					continue;
-				}
-			}
-
-			//actually get some results
-			do {
-				std::vector<MetaDataList> mdls = scraper->getResults(params);
-
-				//no results
-				if(mdls.size() == 0)
-				{
-					if(manual_mode)
-					{
-						//in manual mode let the user enter a custom search
-						out << "   NO RESULTS FOUND! Enter a new name to search for, or nothing to skip.\n";
-
-						std::getline(std::cin, params.nameOverride);
-
-						if(params.nameOverride.empty())
-						{
-							out << "   Skipping...\n";
-							break;
-						}
-
-						continue;
-
-					}else{
-						out << "   NO RESULTS FOUND! Skipping...\n";
-						break;
-					}
-				}
-
-				//some results
-				if(manual_mode)
-				{
-					//print list of choices
-					for(unsigned int i = 0; i < mdls.size(); i++)
-					{
-						out << "   " << i << " - " << mdls.at(i).get("name") << "\n";
-					}
-
-					int choice = -1;
-					std::string choice_str;
-
-					out << "Your choice: ";
-
-					std::getline(std::cin, choice_str);
-					std::stringstream choice_buff(choice_str); //convert to int
-					choice_buff >> choice;
-
-					if(choice >= 0 && choice < (int)mdls.size())
-					{
-						params.game->metadata = mdls.at(choice);
-						break;
-					}else{
-						out << "Invalid choice.\n";
-						continue;
-					}
-
-				}else{
-					//automatic mode
-					//always choose the first choice
-					out << "   name -> " << mdls.at(0).get("name") << "\n";
-					params.game->metadata = mdls.at(0);
-					break;
-				}
-
-			} while(true);
-
-			out << "===================\n";
-		}
-	}
-
-	out << "\n\n";
-	out << "Downloading boxart...\n";
-
-	for(auto sysIt = systems.cbegin(); sysIt != systems.cend(); sysIt++)
-	{
-		std::vector<FileData*> files = (*sysIt)->getRootFolder()->getFilesRecursive(GAME);
-
-		for(auto gameIt = files.cbegin(); gameIt != files.cend(); gameIt++)
-		{
-			FileData* game = *gameIt;
-			const std::vector<MetaDataDecl>& mdd = game->metadata.getMDD();
-			for(auto i = mdd.cbegin(); i != mdd.cend(); i++)
-			{
-				std::string key = i->key;
-				std::string url = game->metadata.get(key);
-
-				if(i->type == MD_IMAGE_PATH && HttpReq::isUrl(url))
-				{
-					std::string urlShort = url.substr(0, url.length() > 35 ? 35 : url.length());
-					if(url.length() != urlShort.length()) urlShort += "...";
-
-					out << "   " << game->metadata.get("name") << " [from: " << urlShort << "]...\n";
-
-					ScraperSearchParams p;
-					p.game = game;
-					p.system = *sysIt;
-					game->metadata.set(key, downloadImage(url, getSaveAsPath(p, key, url)));
-					if(game->metadata.get(key).empty())
-					{
-						out << "     FAILED! Skipping.\n";
-						game->metadata.set(key, url); //result URL to what it was if download failed, retry some other time
-					}
-				}
-			}
-		}
-	}
-
-
-	out << "\n\n";
-	out << "==============================\n";
-	out << "SCRAPE COMPLETE!\n";
-	out << "==============================\n";
-	*/
-
-	out << "\n\n";
-	out << "ACTUALLY THIS IS STILL TODO\n";
-
-	return 0;
+	return run_scraper_batch(systems, filter_choice == FILTER_MISSING_IMAGES, manual_mode, ScraperBatch::getConfiguredConcurrency());
 }
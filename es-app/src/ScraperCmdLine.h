@@ -2,6 +2,11 @@
 #ifndef ES_APP_SCRAPER_CMD_LINE_H
 #define ES_APP_SCRAPER_CMD_LINE_H
 
+#include <string>
+
 int run_scraper_cmdline();
+// RetroPangui: 묻지 않고 자동 모드로 스크랩(--scrape-batch). systemNames: 쉼표로 구분한 시스템 이름 또는 "all"
+// hashRoms면 먼저 ROM CRC32/MD5를 계산해 둠(--scrape-hash, ScreenScraper 체크섬 검색용)
+int run_scraper_batch_cmdline(const std::string& systemNames, bool missingImagesOnly, bool hashRoms);
 
 #endif // ES_APP_SCRAPER_CMD_LINE_H
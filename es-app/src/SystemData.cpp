@@ -2,11 +2,14 @@
 
 #include "utils/FileSystemUtil.h"
 #include "CollectionSystemManager.h"
+#include "FileDataArena.h"
 #include "FileFilterIndex.h"
 #include "FileSorts.h"
 #include "Gamelist.h"
+#include "GamelistWriter.h"
 #include "Log.h"
 #include "LocaleES.h"
+#include "MediaIndex.h"
 #include "platform.h"
 #include "Settings.h"
 #include "ThemeData.h"
@@ -17,12 +20,16 @@
 #include "utils/StringUtil.h"
 #include "utils/ThreadPool.h"
 #include "Window.h"
+#include <SDL_timer.h>
 
 using namespace Utils;
 
 std::vector<SystemData*> SystemData::sSystemVector;
 std::vector<SystemData*> SystemData::sSystemVectorShuffled;
 std::ranlux48 SystemData::sURNG = std::ranlux48(std::random_device()());
+bool SystemData::sDeferThemeLoading = false;
+std::vector<SystemData*> SystemData::sPendingThemes;
+std::mutex SystemData::sPendingThemesMutex;
 
 // RetroPangui: Disc image priority helper functions
 // When multiple disc formats exist for the same game, only add the highest priority one.
@@ -91,14 +98,21 @@ static std::set<std::string> getM3uMemberPaths(const std::string& folderPath)
 
 
 SystemData::SystemData(const std::string& name, const std::string& fullName, SystemEnvironmentData* envData, const std::string& themeFolder, bool CollectionSystem) :
-	mName(name), mFullName(fullName), mEnvData(envData), mThemeFolder(themeFolder), mIsCollectionSystem(CollectionSystem), mIsGameSystem(true)
+	mName(name), mFullName(fullName), mEnvData(envData), mThemeFolder(themeFolder), mIsCollectionSystem(CollectionSystem), mIsGameSystem(true), mRecentGamesVersion(0), mJournalRecords(0)
 {
+	// 최근 플레이 인덱스가 색인 중에 isGameSystem을 보므로 먼저 결정
+	setIsGameSystemStatus();
+
 	mFilterIndex = new FileFilterIndex();
+	mMediaIndex = new MediaIndex(name);
+	mFileArena = new FileDataArena();
 
 	// if it's an actual system, initialize it, if not, just create the data structure
 	if(!CollectionSystem)
 	{
-		mRootFolder = new FileData(FOLDER, mEnvData->mStartPath, mEnvData, this);
+		mMediaIndex->load();
+
+		mRootFolder = new (mFileArena) FileData(FOLDER, mEnvData->mStartPath, mEnvData, this);
 		mRootFolder->metadata.set("name", mFullName);
 
 		if(!Settings::getInstance()->getBool("ParseGamelistOnly"))
@@ -110,6 +124,7 @@ SystemData::SystemData(const std::string& name, const std::string& fullName, Sys
 			if(!Utils::FileSystem::exists(mRootFolder->getPath() + "/gamelist.xml"))
 				generateGamelist(this);
 			parseGamelist(this);
+			mJournalRecords = replayGamelistJournal(this);
 		}
 
 		mRootFolder->sort(FileSorts::SortTypes.at(0));
@@ -119,19 +134,32 @@ SystemData::SystemData(const std::string& name, const std::string& fullName, Sys
 	else
 	{
 		// virtual systems are updated afterwards, we're just creating the data structure
-		mRootFolder = new FileData(FOLDER, "" + name, mEnvData, this);
+		mRootFolder = new (mFileArena) FileData(FOLDER, "" + name, mEnvData, this);
 	}
-	setIsGameSystemStatus();
-	loadTheme();
+
+	if(sDeferThemeLoading)
+	{
+		std::unique_lock<std::mutex> lock(sPendingThemesMutex);
+		sPendingThemes.push_back(this);
+	}
+	else
+		loadTheme();
 }
 
 SystemData::~SystemData()
 {
-	if(Settings::getInstance()->getString("SaveGamelistsMode") == "on exit")
+	if(Settings::getInstance()->getString("SaveGamelistsMode") == "on exit" || mJournalRecords > 0)
 		writeMetaData();
 
-	delete mRootFolder;
+	mMediaIndex->save();
+
+	// RetroPangui: 노드를 하나씩 떼어 내며 지우지 않고 (예전에는 루트만 지워지고 하위 노드는 남았음)
+	// 슬랩째로 소멸자 호출 + 해제. 다른 시스템 소속 부모(컬렉션 번들)에서는 ~FileData()가 떼어 냄
+	mFileArena->releaseAll();
+	mRootFolder = NULL;
+	delete mFileArena;
 	delete mFilterIndex;
+	delete mMediaIndex;
 }
 
 void SystemData::setIsGameSystemStatus()
@@ -196,7 +224,7 @@ void SystemData::populateFolder(FileData* folder)
 			}
 			else
 			{
-				FileData* newGame = new FileData(GAME, filePath, mEnvData, this);
+				FileData* newGame = new (mFileArena) FileData(GAME, filePath, mEnvData, this);
 
 				// preventing new arcade assets to be added
 				if(!newGame->isArcadeAsset())
@@ -210,7 +238,7 @@ void SystemData::populateFolder(FileData* folder)
 		//add directories that also do not match an extension as folders
 		if(!isGame && Utils::FileSystem::isDirectory(filePath))
 		{
-			FileData* newFolder = new FileData(FOLDER, filePath, mEnvData, this);
+			FileData* newFolder = new (mFileArena) FileData(FOLDER, filePath, mEnvData, this);
 			populateFolder(newFolder);
 
 			//ignore folders that do not contain games
@@ -277,6 +305,14 @@ int SystemData::refreshGamelist(int* removedOut)
 
 	std::string xmlPath = getGamelistPath(true);
 
+	// 저널에만 있는 변경(즐겨찾기/플레이 기록)을 먼저 gamelist.xml에 반영 - 아래에서 파일을 통째로 다시 쓰면
+	// 저널은 다음 압축 때 지워지므로 그 전에 내용이 xml에 들어가 있어야 함
+	if (hasGamelistJournal())
+		writeMetaData();
+
+	// 백그라운드에서 쓰는 중이거나 대기 중인 저장을 먼저 끝냄 - 아래에서 파일을 직접 읽고 다시 쓰므로
+	GamelistWriter::getInstance()->flush();
+
 	// RetroPangui 2026-07-18(사용자 지시): 기존 <path> 노드를 찾아 지우고 다시
 	// 넣는 diff-patch 방식 대신, 새 문서를 통째로 다시 써서 로직을 단순화.
 	// 살아있는(디스크에 실제 존재하는) <game>은 노드를 그대로 복사해 메타데이터
@@ -372,13 +408,16 @@ int SystemData::refreshGamelist(int* removedOut)
 		}
 	}
 
-	// 새 항목을 메모리 트리에 반영(기존 항목은 findOrCreateFile이 그대로 반환)
+	// 새 항목만 메모리 트리에 반영 - 이미 있던 항목의 메모리 메타데이터(아직 저장 전인 변경 포함)는 그대로 둠
 	if (added > 0)
-		parseGamelist(this);
+		parseGamelist(this, true);
 
 	// 추가/삭제로 필터 인덱스가 어긋나지 않게 전체 재색인
 	mFilterIndex->resetIndex();
+	mMediaIndex->resetIndex();
+	mRecentGames.clear();
 	indexAllGameFilters(mRootFolder);
+	mRecentGamesVersion++;
 
 	LOG(LogInfo) << "refreshGamelist: \"" << mName << "\" +" << added << " -" << removed;
 	if (removedOut)
@@ -394,7 +433,7 @@ void SystemData::indexAllGameFilters(const FileData* folder)
 	{
 		switch((*it)->getType())
 		{
-			case GAME:   { mFilterIndex->addToIndex(*it); } break;
+			case GAME:   { mFilterIndex->addToIndex(*it); mMediaIndex->addToIndex(*it); insertRecentGame(*it); } break;
 			case FOLDER: { indexAllGameFilters(*it);      } break;
 			default:
 				LOG(LogInfo) << "Unknown type: " << (*it)->getType();
@@ -550,11 +589,27 @@ SystemData* SystemData::loadSystem(pugi::xml_node system)
 	return newSys;
 }
 
+// RetroPangui: 현재 프로세스 RSS(KiB), 알 수 없으면 0 - 시스템 로드 전후 메모리 비교용
+static unsigned long getResidentKB()
+{
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line))
+	{
+		if (line.compare(0, 6, "VmRSS:") == 0)
+			return strtoul(line.c_str() + 6, NULL, 10);
+	}
+	return 0;
+}
+
 //creates systems from information located in a config file
 bool SystemData::loadConfig(Window* window)
 {
 	deleteSystems();
 
+	const unsigned int loadStart = SDL_GetTicks();
+	const unsigned long loadStartRSS = getResidentKB();
+
 	std::string path = getConfigPath(false);
 
 	LOG(LogInfo) << "Loading system config file " << path << "...";
@@ -596,6 +651,9 @@ bool SystemData::loadConfig(Window* window)
 
 	int currentSystem = 0;
 
+	// RetroPangui: 시스템 테마는 모든 시스템(컬렉션 포함)을 만든 뒤 한 번에 병렬로
+	sDeferThemeLoading = true;
+
 	typedef SystemData* SystemDataPtr;
 
 	ThreadPool* pThreadPool = NULL;
@@ -678,6 +736,23 @@ bool SystemData::loadConfig(Window* window)
 		CollectionSystemManager::get()->loadCollectionSystems();
 	}
 
+	sDeferThemeLoading = false;
+	if (window != NULL)
+		window->renderLoadingScreen("Themes", 1.0f);
+	loadThemes(sPendingThemes);
+	sPendingThemes.clear();
+
+	size_t nodes = 0;
+	size_t arenaBytes = 0;
+	for (auto sys : sSystemVector)
+	{
+		nodes += sys->mFileArena->getLiveCount();
+		arenaBytes += sys->mFileArena->getReservedBytes();
+	}
+	const unsigned long loadEndRSS = getResidentKB();
+	LOG(LogInfo) << "Loaded " << sSystemVector.size() << " systems (" << nodes << " file nodes, " << (arenaBytes / 1024) << " KiB node arenas) in "
+		<< (SDL_GetTicks() - loadStart) << " ms, RSS " << loadStartRSS << " -> " << loadEndRSS << " KiB";
+
 	return true;
 }
 
@@ -729,11 +804,16 @@ void SystemData::writeExampleConfig(const std::string& path)
 
 void SystemData::deleteSystems()
 {
+	if (sSystemVector.empty())
+		return;
+
+	const unsigned int start = SDL_GetTicks();
 	for(unsigned int i = 0; i < sSystemVector.size(); i++)
 	{
 		delete sSystemVector.at(i);
 	}
 	sSystemVector.clear();
+	LOG(LogInfo) << "Deleted systems in " << (SDL_GetTicks() - start) << " ms";
 }
 
 std::string SystemData::getConfigPath(bool forWrite)
@@ -798,6 +878,11 @@ std::string SystemData::getGamelistPath(bool forWrite) const
 }
 
 std::string SystemData::getThemePath() const
+{
+	return getThemePath(ThemeData::getCurrentThemeSet());
+}
+
+std::string SystemData::getThemePath(const ThemeSet& themeSet) const
 {
 	// where we check for themes, in order:
 	// 1. [SYSTEM_PATH]/theme.xml
@@ -810,7 +895,7 @@ std::string SystemData::getThemePath() const
 		return localThemePath;
 
 	// not in game folder, try system theme in theme sets
-	localThemePath = ThemeData::getThemeFromCurrentSet(mThemeFolder);
+	localThemePath = themeSet.path.empty() ? "" : themeSet.getThemePath(mThemeFolder);
 
 	if (Utils::FileSystem::exists(localThemePath))
 		return localThemePath;
@@ -828,7 +913,7 @@ bool SystemData::hasGamelist() const
 
 unsigned int SystemData::getGameCount() const
 {
-	return (unsigned int)mRootFolder->getFilesRecursive(GAME).size();
+	return mRootFolder->getGameCount();
 }
 
 SystemData* SystemData::getRandomSystem()
@@ -866,78 +951,156 @@ FileData* SystemData::getRandomGame()
 	return random_game;
 }
 
-unsigned int SystemData::getDisplayedGameCount() const
+// RetroPangui: 최근 플레이 인덱스에 후보 하나를 정렬 위치에 끼워 넣음(상위 RECENT_GAMES_MAX개 유지).
+// "recent" 자동 컬렉션과 같은 기준(플레이 횟수 > 0, kodi/비게임 시스템 제외). 들어갔으면 true
+bool SystemData::insertRecentGame(FileData* game)
 {
-	// RetroPangui: Use getChildrenListToDisplay which properly handles ShowFolders setting
-	const std::vector<FileData*>& displayedChildren = mRootFolder->getChildrenListToDisplay();
+	if (mIsCollectionSystem || !mIsGameSystem || game->getType() != GAME)
+		return false;
+	if (game->metadata.getInt("playcount") <= 0 || game->getName() == "kodi")
+		return false;
 
-	// Count only GAME type (not folders)
-	unsigned int count = 0;
-	for (FileData* child : displayedChildren)
+	RecentGame entry;
+	entry.game = game;
+	entry.lastPlayed = game->metadata.get("lastplayed");
+	entry.thumbnailResolved = false;
+
+	auto pos = std::upper_bound(mRecentGames.begin(), mRecentGames.end(), entry, [](const RecentGame& a, const RecentGame& b) {
+		return a.lastPlayed > b.lastPlayed;
+	});
+	if (pos - mRecentGames.begin() >= RECENT_GAMES_MAX)
+		return false;
+
+	mRecentGames.insert(pos, entry);
+	if ((int)mRecentGames.size() > RECENT_GAMES_MAX)
+		mRecentGames.pop_back();
+	return true;
+}
+
+void SystemData::rebuildRecentGames()
+{
+	mRecentGames.clear();
+	mRootFolder->visitRecursive(GAME, [this](FileData* game) { insertRecentGame(game); });
+	mRecentGamesVersion++;
+}
+
+const std::vector<SystemData::RecentGame>& SystemData::getRecentGames()
+{
+	for (auto it = mRecentGames.begin(); it != mRecentGames.end(); ++it)
 	{
-		if (child->getType() == GAME)
-			count++;
+		if (it->thumbnailResolved)
+			continue;
+		it->thumbnail = it->game->getThumbnailPath();
+		if (!it->thumbnail.empty() && !Utils::FileSystem::exists(it->thumbnail))
+			it->thumbnail.clear();
+		it->thumbnailResolved = true;
 	}
+	return mRecentGames;
+}
 
-	// Also recursively count games in folders
-	std::function<void(FileData*)> countRecursive = [&](FileData* folder) {
-		const std::vector<FileData*>& children = folder->getChildrenListToDisplay();
-		for (FileData* child : children)
+// 게임 실행/메타데이터 저장 후 호출 - 목록 안에서 자리를 옮기거나 새로 넣거나 뺀다.
+// 꽉 찬 목록에서 한 게임이 밀려났을 때만 다음 후보를 알 수 없어 전체를 다시 만든다.
+void SystemData::updateRecentGame(FileData* game)
+{
+	size_t sizeBefore = mRecentGames.size();
+	for (auto it = mRecentGames.begin(); it != mRecentGames.end(); ++it)
+	{
+		if (it->game == game)
 		{
-			if (child->getType() == GAME)
-				count++;
-			else if (child->getType() == FOLDER)
-				countRecursive(child);
+			mRecentGames.erase(it);
+			break;
 		}
-	};
-
-	// Count games in subfolders
-	for (FileData* child : displayedChildren)
-	{
-		if (child->getType() == FOLDER)
-			countRecursive(child);
 	}
+	bool wasListed = mRecentGames.size() != sizeBefore;
 
-	return count;
+	if (!insertRecentGame(game) && !wasListed)
+		return;
+
+	if (wasListed && (int)sizeBefore == RECENT_GAMES_MAX && (int)mRecentGames.size() < RECENT_GAMES_MAX)
+		rebuildRecentGames();
+	else
+		mRecentGamesVersion++;
 }
 
-// RetroPangui: Count favorited games among displayed games (mirrors getDisplayedGameCount)
-unsigned int SystemData::getDisplayedFavoriteCount() const
+void SystemData::removeRecentGame(FileData* game)
 {
-	const std::vector<FileData*>& displayedChildren = mRootFolder->getChildrenListToDisplay();
-
-	unsigned int count = 0;
-	for (FileData* child : displayedChildren)
+	for (auto it = mRecentGames.begin(); it != mRecentGames.end(); ++it)
 	{
-		if (child->getType() == GAME && child->metadata.get("favorite") == "true")
-			count++;
+		if (it->game != game)
+			continue;
+
+		mRecentGames.erase(it);
+		if ((int)mRecentGames.size() == RECENT_GAMES_MAX - 1)
+		{
+			// 빈 자리를 채울 다음 후보 - 삭제 중인 게임은 이미 부모에서 빠졌으므로 다시 들어오지 않음
+			rebuildRecentGames();
+		}
+		else
+			mRecentGamesVersion++;
+		return;
 	}
+}
+
+// RetroPangui: 표시 중인 게임/즐겨찾기 수를 한 번의 순회로 같이 세고, 결과를 담당하는 세대 번호들이
+// 그대로인 동안에는 재사용한다 - 캐러셀이 isVisible()로 시스템마다 자주 묻기 때문.
+// 메타데이터(즐겨찾기/숨김 등), 트리 구성, 필터, ShowFolders 중 하나라도 바뀌면 다시 센다.
+void SystemData::updateDisplayedCounts() const
+{
+	const FileFilterIndex* idx = CollectionSystemManager::get()->getSystemToView(const_cast<SystemData*>(this))->getIndex();
+	const DisplayedCountsKey key = { MetaDataList::getGeneration(), FileData::getTreeGeneration(),
+		FileData::getShowFoldersGeneration(), idx, idx->getFilterGeneration() };
 
+	if (mDisplayedCountsValid && key == mDisplayedCountsKey)
+		return;
+
+	// RetroPangui: Use getChildrenListToDisplay which properly handles ShowFolders setting
+	unsigned int games = 0;
+	unsigned int favorites = 0;
 	std::function<void(FileData*)> countRecursive = [&](FileData* folder) {
 		const std::vector<FileData*>& children = folder->getChildrenListToDisplay();
 		for (FileData* child : children)
 		{
-			if (child->getType() == GAME && child->metadata.get("favorite") == "true")
-				count++;
+			if (child->getType() == GAME)
+			{
+				games++;
+				if (child->metadata.get("favorite") == "true")
+					favorites++;
+			}
 			else if (child->getType() == FOLDER)
 				countRecursive(child);
 		}
 	};
+	countRecursive(mRootFolder);
 
-	for (FileData* child : displayedChildren)
-	{
-		if (child->getType() == FOLDER)
-			countRecursive(child);
-	}
+	mDisplayedGameCount = games;
+	mDisplayedFavoriteCount = favorites;
+	mDisplayedCountsKey = key;
+	mDisplayedCountsValid = true;
+}
+
+unsigned int SystemData::getDisplayedGameCount() const
+{
+	updateDisplayedCounts();
+	return mDisplayedGameCount;
+}
 
-	return count;
+// RetroPangui: Count favorited games among displayed games (mirrors getDisplayedGameCount)
+unsigned int SystemData::getDisplayedFavoriteCount() const
+{
+	updateDisplayedCounts();
+	return mDisplayedFavoriteCount;
 }
 
 void SystemData::loadTheme()
+{
+	loadTheme(ThemeData::getCurrentThemeSet());
+}
+
+void SystemData::loadTheme(const ThemeSet& themeSet)
 {
 	mTheme = std::make_shared<ThemeData>();
 
-	std::string path = getThemePath();
+	std::string path = getThemePath(themeSet);
 
 	if(!Utils::FileSystem::exists(path)) // no theme available for this platform
 		return;
@@ -961,6 +1124,37 @@ void SystemData::loadTheme()
 	}
 }
 
+void SystemData::loadThemes(const std::vector<SystemData*>& systems)
+{
+	const unsigned int start = SDL_GetTicks();
+
+	// 없는 세트면 첫 세트로 바꿔 Settings에 쓰므로 작업을 나누기 전에 여기서 한 번만 고른다
+	const ThemeSet themeSet = ThemeData::getCurrentThemeSet();
+
+	if (std::thread::hardware_concurrency() > 2 && systems.size() > 1)
+	{
+		ThreadPool pool;
+		for (auto system : systems)
+			pool.queueWorkItem([system, &themeSet] { system->loadTheme(themeSet); });
+		pool.wait();
+	}
+	else
+	{
+		for (auto system : systems)
+			system->loadTheme(themeSet);
+	}
+
+	// include 문서는 이번 로드 동안만 공유 - 끝나면 메모리에서 내림
+	ThemeData::clearDocumentCache();
+
+	int cached = 0;
+	for (auto system : systems)
+		if (system->getTheme()->wasLoadedFromCache())
+			cached++;
+
+	LOG(LogInfo) << "Loaded " << systems.size() << " system themes in " << (SDL_GetTicks() - start) << "ms (" << cached << " from the compiled cache)";
+}
+
 void SystemData::writeMetaData() {
 	if(Settings::getInstance()->getBool("IgnoreGamelist") || mIsCollectionSystem)
 		return;
@@ -976,6 +1170,43 @@ void SystemData::onMetaDataSavePoint() {
 	writeMetaData();
 }
 
+void SystemData::journalMetaData(FileData* game, const std::vector<std::string>& keys, bool force)
+{
+	if(Settings::getInstance()->getBool("IgnoreGamelist") || mIsCollectionSystem)
+		return;
+
+	if(!force && Settings::getInstance()->getString("SaveGamelistsMode") != "always")
+		return;
+
+	// 저널을 못 쓰면 예전처럼 gamelist.xml 전체 저장
+	if(!appendGamelistJournal(this, game, keys))
+	{
+		updateGamelist(this);
+		return;
+	}
+
+	mJournalRecords += (unsigned int)keys.size();
+	if(mJournalRecords >= JOURNAL_COMPACT_RECORDS)
+		updateGamelist(this);
+}
+
+void SystemData::onGamelistJournalCompacted()
+{
+	mJournalRecords = 0;
+}
+
+void SystemData::compactGamelistJournals()
+{
+	for(auto sys : sSystemVector)
+	{
+		if(sys->mJournalRecords > 0)
+		{
+			LOG(LogDebug) << "Compacting " << sys->mJournalRecords << " gamelist journal records for " << sys->getName();
+			sys->writeMetaData();
+		}
+	}
+}
+
 // RetroPangui: Get available emulator cores sorted by priority
 std::vector<CoreInfo> SystemData::getCores() const
 {
@@ -7,13 +7,17 @@
 #include <memory>
 #include <random>
 #include <string>
+#include <mutex>
 #include <vector>
 
 #include <pugixml.hpp>
 
 class FileData;
+class FileDataArena;
 class FileFilterIndex;
+class MediaIndex;
 class ThemeData;
+struct ThemeSet;
 class Window;
 
 // RetroPangui: Multi-core support
@@ -57,6 +61,8 @@ public:
 	std::string getGamelistPath(bool forWrite) const;
 	bool hasGamelist() const;
 	std::string getThemePath() const;
+	// RetroPangui: 이미 고른 테마 세트 기준 - Settings를 건드리지 않아 작업 스레드에서 불러도 됨
+	std::string getThemePath(const ThemeSet& themeSet) const;
 
 	// RetroPangui: Get available emulator cores for this system (sorted by priority)
 	std::vector<CoreInfo> getCores() const;
@@ -89,11 +95,43 @@ public:
 
 	// Load or re-load theme.
 	void loadTheme();
+	void loadTheme(const ThemeSet& themeSet);
+	// RetroPangui: 여러 시스템의 테마를 한꺼번에 (재)로드 - 코어가 충분하면 ThreadPool에서 병렬로.
+	// 시스템들이 같은 include 파일을 공유하므로 그 파싱 결과도 이 한 번 동안 공유된다.
+	static void loadThemes(const std::vector<SystemData*>& systems);
 
 	FileFilterIndex* getIndex() { return mFilterIndex; };
+	// RetroPangui: 게임별 미디어 보유 인덱스 (컬렉션 시스템은 비어 있음 - MediaIndex::getIndexFor() 참고)
+	MediaIndex* getMediaIndex() { return mMediaIndex; };
+	// RetroPangui: 이 시스템의 FileData 노드가 들어가는 슬랩 - `new (system->getFileArena()) FileData(...)`
+	FileDataArena* getFileArena() { return mFileArena; };
 	void onMetaDataSavePoint();
+	// RetroPangui: game의 keys(플레이 횟수, 즐겨찾기 등)만 바뀐 저장 지점 - gamelist.xml을 다시 쓰지 않고
+	// 저널에 덧붙임(Gamelist.h 참고). force면 SaveGamelistsMode와 상관없이 저장
+	void journalMetaData(FileData* game, const std::vector<std::string>& keys, bool force = false);
+	inline bool hasGamelistJournal() const { return mJournalRecords > 0; }
+	void onGamelistJournalCompacted();
+	// 저널이 쌓인 시스템의 gamelist.xml을 다시 씀 - main 루프가 입력이 없을 때 호출
+	static void compactGamelistJournals();
 	void setShuffledCacheDirty();
 
+	// RetroPangui: 시스템별 최근 플레이 인덱스 - lastplayed 내림차순 상위 RECENT_GAMES_MAX개.
+	// SystemView의 RECENTLY PLAYED 카드가 매 프레임 "recent" 컬렉션을 훑지 않도록, 색인할 때
+	// 한 번 만들고 게임 실행/메타데이터 저장 시점에만 updateRecentGame()으로 갱신한다.
+	// 목록이 바뀔 때마다 getRecentGamesVersion()이 올라가므로 읽는 쪽은 버전만 비교하면 된다.
+	struct RecentGame
+	{
+		FileData* game;
+		std::string lastPlayed;  // 정렬 키(메타데이터 원문, ISO 형식이라 문자열 비교 가능)
+		std::string thumbnail;   // 존재가 확인된 썸네일 경로, 없으면 빈 문자열
+		bool thumbnailResolved;  // thumbnail은 처음 읽을 때 한 번만 확인
+	};
+	static const int RECENT_GAMES_MAX = 16; // 카드 수(6)보다 여유 있게 - 필터로 빠지는 게임 몫
+	const std::vector<RecentGame>& getRecentGames();
+	inline unsigned int getRecentGamesVersion() const { return mRecentGamesVersion; }
+	void updateRecentGame(FileData* game);
+	void removeRecentGame(FileData* game);
+
 	// RetroPangui: 롬 폴더를 재스캔해서 gamelist.xml에 없는 게임만 최소
 	// 항목(<path>/<name>)으로 등록하고 메모리 트리에 반영한다. 기존 항목은
 	// 건드리지 않는다. 반환: 새로 등록된 개수, 오류 시 -1.
@@ -103,6 +141,11 @@ public:
 private:
 	static SystemData* loadSystem(pugi::xml_node system);
 
+	// RetroPangui: loadConfig() 동안에는 생성자가 테마를 바로 읽지 않고 모아 두었다가 끝에서 loadThemes()로 한 번에
+	static bool sDeferThemeLoading;
+	static std::vector<SystemData*> sPendingThemes;
+	static std::mutex sPendingThemesMutex;
+
 	bool mIsCollectionSystem;
 	bool mIsGameSystem;
 	std::string mName;
@@ -113,14 +156,44 @@ private:
 
 	void populateFolder(FileData* folder);
 	void indexAllGameFilters(const FileData* folder);
+	bool insertRecentGame(FileData* game);
+	void rebuildRecentGames();
 	void setIsGameSystemStatus();
 	void writeMetaData();
 
 	FileFilterIndex* mFilterIndex;
+	MediaIndex* mMediaIndex;
+	FileDataArena* mFileArena;
+	std::vector<RecentGame> mRecentGames;
+	unsigned int mRecentGamesVersion;
+	unsigned int mJournalRecords; // 마지막 gamelist.xml 저장 이후 저널에 쌓인 레코드 수
+	static const unsigned int JOURNAL_COMPACT_RECORDS = 512; // 이만큼 쌓이면 유휴를 기다리지 않고 바로 압축
 
 	FileData* mRootFolder;
 	// for getRandomGame()
 	std::vector<FileData*> mGamesShuffled;
+
+	// RetroPangui: getDisplayedGameCount()/getDisplayedFavoriteCount() 캐시
+	struct DisplayedCountsKey
+	{
+		unsigned int metadataGeneration;
+		unsigned int treeGeneration;
+		unsigned int showFoldersGeneration;
+		const FileFilterIndex* filterIndex;
+		unsigned int filterGeneration;
+
+		bool operator==(const DisplayedCountsKey& other) const
+		{
+			return metadataGeneration == other.metadataGeneration && treeGeneration == other.treeGeneration &&
+				showFoldersGeneration == other.showFoldersGeneration && filterIndex == other.filterIndex &&
+				filterGeneration == other.filterGeneration;
+		}
+	};
+	void updateDisplayedCounts() const;
+	mutable DisplayedCountsKey mDisplayedCountsKey;
+	mutable bool mDisplayedCountsValid = false;
+	mutable unsigned int mDisplayedGameCount = 0;
+	mutable unsigned int mDisplayedFavoriteCount = 0;
 };
 
 #endif // ES_APP_SYSTEM_DATA_H
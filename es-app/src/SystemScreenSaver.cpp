@@ -13,6 +13,7 @@
 #include "FileData.h"
 #include "FileFilterIndex.h"
 #include "Log.h"
+#include "MediaIndex.h"
 #include "PowerSaver.h"
 #include "Scripting.h"
 #include "Sound.h"
@@ -30,8 +31,6 @@
 
 #define FADE_TIME 			300
 
-static int lastIndex = 0;
-
 SystemScreenSaver::SystemScreenSaver(Window* window) :
 	mVideoScreensaver(NULL),
 	mImageScreensaver(NULL),
@@ -451,22 +450,23 @@ void SystemScreenSaver::backgroundIndexing()
 {
 	LOG(LogDebug) << "Background indexing starting.";
 
-	// get the list of all games
-	SystemData* all = CollectionSystemManager::get()->getAllGamesCollection();
-	std::vector<FileData*> files = all->getRootFolder()->getFilesRecursive(GAME);
-
+	// RetroPangui: exists() 캐시를 데우는 대신 미디어 인덱스의 미확인 항목(파일 크기/이미지 크기)을 채운다.
+	// 한 번 확인된 항목은 인덱스 파일에 남으므로 다음 실행부터는 할 일이 거의 없음
 	const auto startTs = std::chrono::system_clock::now();
-	for ( ; lastIndex < files.size(); lastIndex++)
+	size_t probed = 0;
+	for (std::vector<SystemData*>::const_iterator it = SystemData::sSystemVector.cbegin(); it != SystemData::sSystemVector.cend() && !mExit; ++it)
 	{
-		if(mExit)
-			break;
-		Utils::FileSystem::exists(files.at(lastIndex)->getVideoPath());
-		Utils::FileSystem::exists(files.at(lastIndex)->getMarqueePath());
-		Utils::FileSystem::exists(files.at(lastIndex)->getThumbnailPath());
-		Utils::FileSystem::exists(files.at(lastIndex)->getImagePath());
+		if (!(*it)->isGameSystem() || (*it)->isCollection())
+			continue;
+
+		MediaIndex* index = (*it)->getMediaIndex();
+		size_t count;
+		while (!mExit && (count = index->probePending(256, &mExit)) > 0)
+			probed += count;
+		index->save();
 	}
 	auto endTs = std::chrono::system_clock::now();
-	LOG(LogDebug) << "Indexed a total of " << lastIndex << " entries in " << std::chrono::duration_cast<std::chrono::milliseconds>(endTs - startTs).count() << " ms. Stopping.";
+	LOG(LogDebug) << "Indexed a total of " << probed << " media files in " << std::chrono::duration_cast<std::chrono::milliseconds>(endTs - startTs).count() << " ms. Stopping.";
 }
 
 void SystemScreenSaver::getAllGamelistNodesForSystem(SystemData* system) {
@@ -491,6 +491,33 @@ void SystemScreenSaver::getAllGamelistNodes()
 
 void SystemScreenSaver::pickGameListNode(const char *nodeName)
 {
+	const MediaType type = (strcmp(nodeName, "video") == 0) ? MEDIA_VIDEO : MEDIA_IMAGE;
+
+	// RetroPangui: 미디어 인덱스에서 해당 미디어가 있는 게임을 바로 뽑는다(O(1)).
+	// 컬렉션은 인덱스가 원본 시스템 기준이라 아래의 기존 방식(목록 셔플)으로 고름
+	if (mSystem == NULL || !mSystem->isCollection())
+	{
+		for (int attempt = 0; attempt < 8; attempt++)
+		{
+			FileData* itf = mSystem ? mSystem->getMediaIndex()->getRandomGame(type, SystemData::sURNG)
+			                        : MediaIndex::getRandomGameFromAllSystems(type, SystemData::sURNG);
+			if (itf == NULL)
+				return; // no candidate with image/video
+
+			// getFilesRecursive(GAME, true)와 같이 현재 필터에 걸리는 게임은 제외
+			FileFilterIndex* idx = itf->getSystem()->getIndex();
+			if (idx->isFiltered() && !idx->showFile(itf))
+				continue;
+
+			// 후보가 여럿이면 방금 보여준 게임은 피한다
+			if ((itf == mCurrentGame || itf == mPreviousGame) && attempt < 7)
+				continue;
+
+			mCurrentGame = itf;
+			return;
+		}
+	}
+
 	FileData *itf = nullptr;
 	bool found =  false;
 	int missCtr = 0;
@@ -510,8 +537,7 @@ void SystemScreenSaver::pickGameListNode(const char *nodeName)
 
 		itf = mAllFiles.back();
 		mAllFiles.pop_back();
-		if ((strcmp(nodeName, "video") == 0 && itf->getVideoPath() != "") ||
-			(strcmp(nodeName, "image") == 0 && itf->getImagePath() != ""))
+		if (MediaIndex::getMediaPath(itf, type) != "")
 		{
 			found = true;
 		}
@@ -531,7 +557,7 @@ void SystemScreenSaver::pickGameListNode(const char *nodeName)
 void SystemScreenSaver::prepareScreenSaverMedia(const char *nodeName, std::string& path)
 {
 	if (mCurrentGame) {
-		path = (strcmp(nodeName, "video") == 0) ? mCurrentGame->getVideoPath() : mCurrentGame->getImagePath();
+		path = MediaIndex::getMediaPath(mCurrentGame, (strcmp(nodeName, "video") == 0) ? MEDIA_VIDEO : MEDIA_IMAGE);
 		if (Settings::getInstance()->getString("ScreenSaverGameInfo") != "never")
 		{
 			auto systemName = mCurrentGame->getSourceFileData()->getSystem()->getFullName();
@@ -36,6 +36,9 @@ protected:
 	using IList<TextListData, T>::mCursor;
 	using IList<TextListData, T>::mViewportTop;
 	using IList<TextListData, T>::mEntry;
+	using IList<TextListData, T>::getEntry;
+	using IList<TextListData, T>::prefetchEntries;
+	using IList<TextListData, T>::invalidateEntries;
 
 public:
 	using IList<TextListData, T>::size;
@@ -70,6 +73,7 @@ public:
 		mFont = font;
 		for(auto it = mEntries.begin(); it != mEntries.end(); it++)
 			it->data.textCache.reset();
+		invalidateEntries();
 	}
 
 	inline void setUppercase(bool uppercase)
@@ -77,6 +81,7 @@ public:
 		mUppercase = uppercase;
 		for(auto it = mEntries.begin(); it != mEntries.end(); it++)
 			it->data.textCache.reset();
+		invalidateEntries();
 	}
 
 	inline void setSelectorHeight(float selectorScale) { mSelectorHeight = selectorScale; }
@@ -184,6 +189,9 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 
 	float y = (mSize.y() - (mViewportHeight * entrySize)) * 0.5f;
 
+	// one page above and below, so scrolling a page doesn't wait for the data source
+	prefetchEntries(mViewportTop - mViewportHeight, listCutoff + mViewportHeight);
+
 	if (mSelectorImage.hasImage()) {
 		mSelectorImage.setPosition(0.f, y + (mCursor - mViewportTop)*entrySize + mSelectorOffsetY, 0.f);
 		mSelectorImage.render(trans);
@@ -201,7 +209,7 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 
 	for(int i = mViewportTop; i < listCutoff; i++)
 	{
-		typename IList<TextListData, T>::Entry& entry = mEntries.at((unsigned int)i);
+		typename IList<TextListData, T>::Entry& entry = getEntry(i);
 
 		unsigned int color;
 		if(mCursor == i && mSelectedColor)
@@ -292,7 +300,8 @@ int TextListComponent<T>::viewportTop()
 
 	int delta = mCursor - mCursorPrev;
 
-	if(Settings::getInstance()->getBool("UseFullscreenPaging"))
+	static BoolSetting useFullscreenPaging("UseFullscreenPaging");
+	if(useFullscreenPaging.get())
 	{
 		// delta may be greater/less than +/-mViewportHeight on re-sorting of list
 		if (delta <= -mViewportHeight || delta >= mViewportHeight
@@ -320,8 +329,9 @@ int TextListComponent<T>::viewportTop()
 template <typename T>
 bool TextListComponent<T>::input(InputConfig* config, Input input)
 {
-	bool isSingleStep = config->isMappedLike("down", input) || config->isMappedLike("up", input);
-	bool isPageStep = config->isMappedLike("rightshoulder", input) || config->isMappedLike("leftshoulder", input);
+	const unsigned int actions = config->getActions(input);
+	bool isSingleStep = (actions & (ACTION_DOWN | ACTION_UP)) != 0;
+	bool isPageStep = (actions & (ACTION_RIGHTSHOULDER | ACTION_LEFTSHOULDER)) != 0;
 
 	if(size() > 0 && (isSingleStep || isPageStep))
 	{
@@ -332,11 +342,12 @@ bool TextListComponent<T>::input(InputConfig* config, Input input)
 			int delta;
 			mCursorPrev = mCursor;
 			if(isSingleStep)
-				delta = config->isMappedLike("down", input) ? 1 : -1;
+				delta = (actions & ACTION_DOWN) ? 1 : -1;
 			else
 			{
-				delta = Settings::getInstance()->getBool("UseFullscreenPaging") ? mViewportHeight : 10;
-				if (config->isMappedLike("leftshoulder", input))
+				static BoolSetting useFullscreenPaging("UseFullscreenPaging");
+				delta = useFullscreenPaging.get() ? mViewportHeight : 10;
+				if (actions & ACTION_LEFTSHOULDER)
 					delta = -delta;
 			}
 			listInput(delta);
@@ -361,7 +372,7 @@ void TextListComponent<T>::update(int deltaTime)
 		mMarqueeOffset2 = 0;
 
 		// if we're not scrolling and this object's text goes outside our size, marquee it!
-		auto name = mEntries.at((unsigned int)mCursor).name;
+		const std::string& name = getEntry(mCursor).name;
 		const float textLength = mFont->sizeText(mUppercase ? Utils::String::toUpper(name) : name).x();
 		const float limit      = mSize.x() - mHorizontalMargin * 2;
 
@@ -433,37 +444,37 @@ void TextListComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme, c
 	using namespace ThemeFlags;
 	if(properties & COLOR)
 	{
-		if(elem->has("selectorColor"))
+		if(elem->has(ThemeProperty::SELECTOR_COLOR))
 		{
-			setSelectorColor(elem->get<unsigned int>("selectorColor"));
-			setSelectorColorEnd(elem->get<unsigned int>("selectorColor"));
+			setSelectorColor(elem->get<unsigned int>(ThemeProperty::SELECTOR_COLOR));
+			setSelectorColorEnd(elem->get<unsigned int>(ThemeProperty::SELECTOR_COLOR));
 		}
-		if (elem->has("selectorColorEnd"))
-			setSelectorColorEnd(elem->get<unsigned int>("selectorColorEnd"));
-		if (elem->has("selectorGradientType"))
-			setSelectorColorGradientHorizontal(!(elem->get<std::string>("selectorGradientType").compare("horizontal")));
-		if(elem->has("selectedColor"))
-			setSelectedColor(elem->get<unsigned int>("selectedColor"));
-		if(elem->has("primaryColor"))
-			setColor(0, elem->get<unsigned int>("primaryColor"));
-		if(elem->has("secondaryColor"))
-			setColor(1, elem->get<unsigned int>("secondaryColor"));
-		if(elem->has("markerColor"))
-			setMarkerColor(elem->get<unsigned int>("markerColor"));
+		if (elem->has(ThemeProperty::SELECTOR_COLOR_END))
+			setSelectorColorEnd(elem->get<unsigned int>(ThemeProperty::SELECTOR_COLOR_END));
+		if (elem->has(ThemeProperty::SELECTOR_GRADIENT_TYPE))
+			setSelectorColorGradientHorizontal(!(elem->get<std::string>(ThemeProperty::SELECTOR_GRADIENT_TYPE).compare("horizontal")));
+		if(elem->has(ThemeProperty::SELECTED_COLOR))
+			setSelectedColor(elem->get<unsigned int>(ThemeProperty::SELECTED_COLOR));
+		if(elem->has(ThemeProperty::PRIMARY_COLOR))
+			setColor(0, elem->get<unsigned int>(ThemeProperty::PRIMARY_COLOR));
+		if(elem->has(ThemeProperty::SECONDARY_COLOR))
+			setColor(1, elem->get<unsigned int>(ThemeProperty::SECONDARY_COLOR));
+		if(elem->has(ThemeProperty::MARKER_COLOR))
+			setMarkerColor(elem->get<unsigned int>(ThemeProperty::MARKER_COLOR));
 	}
 
 	setFont(Font::getFromTheme(elem, properties, mFont));
 	const float selectorHeight = Math::max(mFont->getHeight(1.0), (float)mFont->getSize()) * mLineSpacing;
 	setSelectorHeight(selectorHeight);
 
-	if(properties & SOUND && elem->has("scrollSound"))
-		mScrollSound = elem->get<std::string>("scrollSound");
+	if(properties & SOUND && elem->has(ThemeProperty::SCROLL_SOUND))
+		mScrollSound = elem->get<std::string>(ThemeProperty::SCROLL_SOUND);
 
 	if(properties & ALIGNMENT)
 	{
-		if(elem->has("alignment"))
+		if(elem->has(ThemeProperty::ALIGNMENT))
 		{
-			const std::string& str = elem->get<std::string>("alignment");
+			const std::string& str = elem->get<std::string>(ThemeProperty::ALIGNMENT);
 			if(str == "left")
 				setAlignment(ALIGN_LEFT);
 			else if(str == "center")
@@ -473,36 +484,36 @@ void TextListComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme, c
 			else
 				LOG(LogError) << "Unknown TextListComponent alignment \"" << str << "\"!";
 		}
-		if(elem->has("horizontalMargin"))
+		if(elem->has(ThemeProperty::HORIZONTAL_MARGIN))
 		{
-			mHorizontalMargin = elem->get<float>("horizontalMargin") * (this->mParent ? this->mParent->getSize().x() : (float)Renderer::getScreenWidth());
+			mHorizontalMargin = elem->get<float>(ThemeProperty::HORIZONTAL_MARGIN) * (this->mParent ? this->mParent->getSize().x() : (float)Renderer::getScreenWidth());
 		}
 	}
 
-	if(properties & FORCE_UPPERCASE && elem->has("forceUppercase"))
-		setUppercase(elem->get<bool>("forceUppercase"));
+	if(properties & FORCE_UPPERCASE && elem->has(ThemeProperty::FORCE_UPPERCASE))
+		setUppercase(elem->get<bool>(ThemeProperty::FORCE_UPPERCASE));
 
 	if(properties & LINE_SPACING)
 	{
-		if(elem->has("lineSpacing"))
-			setLineSpacing(elem->get<float>("lineSpacing"));
-		if(elem->has("selectorHeight"))
+		if(elem->has(ThemeProperty::LINE_SPACING))
+			setLineSpacing(elem->get<float>(ThemeProperty::LINE_SPACING));
+		if(elem->has(ThemeProperty::SELECTOR_HEIGHT))
 		{
-			setSelectorHeight(elem->get<float>("selectorHeight") * Renderer::getScreenHeight());
+			setSelectorHeight(elem->get<float>(ThemeProperty::SELECTOR_HEIGHT) * Renderer::getScreenHeight());
 		}
-		if(elem->has("selectorOffsetY"))
+		if(elem->has(ThemeProperty::SELECTOR_OFFSET_Y))
 		{
 			float scale = this->mParent ? this->mParent->getSize().y() : (float)Renderer::getScreenHeight();
-			setSelectorOffsetY(elem->get<float>("selectorOffsetY") * scale);
+			setSelectorOffsetY(elem->get<float>(ThemeProperty::SELECTOR_OFFSET_Y) * scale);
 		} else {
 			setSelectorOffsetY(0.0);
 		}
 	}
 
-	if (elem->has("selectorImagePath"))
+	if (elem->has(ThemeProperty::SELECTOR_IMAGE_PATH))
 	{
-		std::string path = elem->get<std::string>("selectorImagePath");
-		bool tile = elem->has("selectorImageTile") && elem->get<bool>("selectorImageTile");
+		std::string path = elem->get<std::string>(ThemeProperty::SELECTOR_IMAGE_PATH);
+		bool tile = elem->has(ThemeProperty::SELECTOR_IMAGE_TILE) && elem->get<bool>(ThemeProperty::SELECTOR_IMAGE_TILE);
 		mSelectorImage.setImage(path, tile);
 		mSelectorImage.setSize(mSize.x(), mSelectorHeight);
 		mSelectorImage.setColorShift(mSelectorColor);
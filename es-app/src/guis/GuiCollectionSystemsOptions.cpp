@@ -12,6 +12,7 @@
 #include "utils/StringUtil.h"
 #include "views/ViewController.h"
 #include "CollectionSystemManager.h"
+#include "GamelistWriter.h"
 #include "Window.h"
 
 GuiCollectionSystemsOptions::GuiCollectionSystemsOptions(Window* window) : GuiComponent(window), mMenu(window, _("GAME COLLECTION SETTINGS"))
@@ -146,7 +147,8 @@ void GuiCollectionSystemsOptions::createCollection(std::string inName)
 	std::string name = collSysMgr->getValidNewCollectionName(inName);
 
 	SystemData* newSys = collSysMgr->addNewCustomCollection(name, true);
-	if (!collSysMgr->saveCustomCollection(newSys)) {
+	// 새 컬렉션 파일은 바로 만들어져야 하므로 백그라운드 쓰기를 기다려 결과 확인
+	if (!collSysMgr->saveCustomCollection(newSys) || !GamelistWriter::getInstance()->flush()) {
 		GuiInfoPopup* s = new GuiInfoPopup(mWindow, "Failed creating '" + Utils::String::toUpper(name) + "' Collection. See log for details.", 8000);
 		mWindow->setInfoPopup(s);
 		return;
@@ -18,6 +18,7 @@
 #include "guis/GuiSettings.h"
 #include "views/UIModeController.h"
 #include "views/ViewController.h"
+#include "AudioManager.h"
 #include "CollectionSystemManager.h"
 #include "EmulationStation.h"
 #include "InputConfig.h"
@@ -330,6 +331,57 @@ void GuiMenu::openSoundSettings()
 		// restart: none
 	}
 
+	// 배경음악/효과음 볼륨 - SYSTEM VOLUME(ALSA 마스터)과 별개로 AudioManager 믹서
+	// 게인(또는 VLC 출력 볼륨)만 조절하므로 ALSA 호출 스로틀이 필요 없음.
+	{
+		std::string raw = cfgReadKey(rpConfPath(), "emulationstation.MusicVolume");
+		float orig = (float)Settings::getInstance()->getInt("MusicVolume");
+		if (!raw.empty()) { try { orig = std::stof(raw); } catch (...) {} }
+		auto mv_sl = std::make_shared<SliderComponent>(mWindow, 0.f, 100.f, 5.f, "%");
+		mv_sl->setValue(orig);
+		mv_sl->setChangedCallback([](float val) {
+			Settings::getInstance()->setInt("MusicVolume", (int)Math::round(val));
+			MusicManager::getInstance()->updateVolume();
+		});
+		s->addWithLabel(_("BACKGROUND MUSIC VOLUME"), mv_sl);
+		s->addSaveFunc([mv_sl] {
+			cfgWriteKey(rpConfPath(), "emulationstation.MusicVolume", std::to_string((int)mv_sl->getValue()), false);
+		});
+		// restart: none
+	}
+	{
+		// 믹서 경유(MixBackgroundMusic)일 때만 적용 - 0이면 곡 사이를 공백 없이 이어붙임
+		std::string raw = cfgReadKey(rpConfPath(), "emulationstation.MusicCrossfade");
+		float orig = (float)Settings::getInstance()->getInt("MusicCrossfade");
+		if (!raw.empty()) { try { orig = std::stof(raw); } catch (...) {} }
+		auto cf_sl = std::make_shared<SliderComponent>(mWindow, 0.f, 5000.f, 500.f, "ms");
+		cf_sl->setValue(orig);
+		cf_sl->setChangedCallback([](float val) {
+			Settings::getInstance()->setInt("MusicCrossfade", (int)Math::round(val));
+		});
+		s->addWithLabel(_("BACKGROUND MUSIC CROSSFADE"), cf_sl);
+		s->addSaveFunc([cf_sl] {
+			cfgWriteKey(rpConfPath(), "emulationstation.MusicCrossfade", std::to_string((int)cf_sl->getValue()), false);
+		});
+		// restart: none
+	}
+	{
+		std::string raw = cfgReadKey(rpConfPath(), "emulationstation.SoundVolume");
+		float orig = (float)Settings::getInstance()->getInt("SoundVolume");
+		if (!raw.empty()) { try { orig = std::stof(raw); } catch (...) {} }
+		auto sv_sl = std::make_shared<SliderComponent>(mWindow, 0.f, 100.f, 5.f, "%");
+		sv_sl->setValue(orig);
+		sv_sl->setChangedCallback([](float val) {
+			Settings::getInstance()->setInt("SoundVolume", (int)Math::round(val));
+			AudioManager::updateGains();
+		});
+		s->addWithLabel(_("NAVIGATION SOUND VOLUME"), sv_sl);
+		s->addSaveFunc([sv_sl] {
+			cfgWriteKey(rpConfPath(), "emulationstation.SoundVolume", std::to_string((int)sv_sl->getValue()), false);
+		});
+		// restart: none
+	}
+
 	// YAML→네이티브 이관(audio_settings): rp.enable_sounds — ENABLE NAVIGATION SOUNDS
 	{
 		std::string orig = cfgReadKey(rpConfPath(), "emulationstation.EnableSounds", "false");
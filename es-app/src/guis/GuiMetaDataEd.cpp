@@ -24,6 +24,7 @@
 #include "Window.h"
 #include "Log.h"
 #include "LocaleES.h"
+#include "MediaIndex.h"
 
 GuiMetaDataEd::GuiMetaDataEd(Window* window, MetaDataList* md, const std::vector<MetaDataDecl>& mdd, ScraperSearchParams scraperParams,
 	const std::string& /*header*/, std::function<void()> saveCallback, std::function<void()> deleteFunc) : GuiComponent(window),
@@ -283,6 +284,8 @@ void GuiMetaDataEd::save()
 
 	// enter game in index
 	mScraperParams.system->getIndex()->addToIndex(mScraperParams.game);
+	mScraperParams.system->getMediaIndex()->refreshFile(mScraperParams.game);
+	mScraperParams.game->getSourceFileData()->getSystem()->updateRecentGame(mScraperParams.game->getSourceFileData());
 
 	if(mSavedCallback)
 		mSavedCallback();
@@ -6,8 +6,10 @@
 #include "components/ScraperSearchComponent.h"
 #include "components/TextComponent.h"
 #include "guis/GuiMsgBox.h"
+#include "scrapers/ScraperBatch.h"
 #include "views/ViewController.h"
 #include "Gamelist.h"
+#include "MediaIndex.h"
 #include "PowerSaver.h"
 #include "SystemData.h"
 #include "Window.h"
@@ -69,6 +71,20 @@ GuiScraperMulti::GuiScraperMulti(Window* window, const std::queue<ScraperSearchP
 	setSize(Renderer::getScreenWidth() * 0.95f, Renderer::getScreenHeight() * 0.849f);
 	setPosition((Renderer::getScreenWidth() - mSize.x()) / 2, (Renderer::getScreenHeight() - mSize.y()) / 2);
 
+	if(!approveResults)
+	{
+		// RetroPangui: 고를 게 없으니 한 게임씩 기다리지 않고 배치로 동시에 검색/다운로드,
+		// gamelist.xml도 게임마다가 아니라 묶어서 저장
+		mBatch.reset(new ScraperBatch(mSearchQueue, ScraperBatch::getConfiguredConcurrency()));
+		mBatch->setProgressFunc([this](const ScraperSearchParams& search, ScraperBatch::Outcome /*outcome*/, const std::string& /*message*/) {
+			onBatchProgress(search);
+		});
+		mSearchComp->setVisible(false);
+		mSystem->setText(Utils::String::toUpper(mSearchQueue.front().system->getFullName()));
+		mSubtitle->setText("GAME 1 OF " + std::to_string(mTotalGames));
+		return;
+	}
+
 	doNextSearch();
 }
 
@@ -90,6 +106,30 @@ void GuiScraperMulti::onSizeChanged()
 	mGrid.setSize(mSize);
 }
 
+void GuiScraperMulti::update(int deltaTime)
+{
+	GuiComponent::update(deltaTime);
+
+	if(mBatch && mIsProcessing)
+	{
+		mBatch->update();
+		if(mBatch->isDone())
+			finish();
+	}
+}
+
+void GuiScraperMulti::onBatchProgress(const ScraperSearchParams& search)
+{
+	mCurrentGame = mBatch->getFinished();
+	mTotalSuccessful = mBatch->getScraped();
+	mTotalSkipped = mBatch->getSkipped() + mBatch->getFailed();
+
+	std::stringstream ss;
+	mSystem->setText(Utils::String::toUpper(search.system->getFullName()));
+	ss << "GAME " << std::min(mCurrentGame + 1, mTotalGames) << " OF " << mTotalGames << " - " << Utils::String::toUpper(Utils::FileSystem::getFileName(search.game->getPath()));
+	mSubtitle->setText(ss.str());
+}
+
 void GuiScraperMulti::doNextSearch()
 {
 	if(mSearchQueue.empty())
@@ -115,6 +155,8 @@ void GuiScraperMulti::acceptResult(const ScraperSearchResult& result)
 	ScraperSearchParams& search = mSearchQueue.front();
 
 	search.game->metadata = result.mdl;
+	search.system->getMediaIndex()->refreshFile(search.game);
+	search.game->getSourceFileData()->getSystem()->updateRecentGame(search.game->getSourceFileData());
 	updateGamelist(search.system);
 
 	mSearchQueue.pop();
@@ -133,6 +175,10 @@ void GuiScraperMulti::skip()
 
 void GuiScraperMulti::finish()
 {
+	// STOP during a batch: drop what is in flight, keep (and save) what is done
+	if(mBatch && !mBatch->isDone())
+		mBatch->cancel();
+
 	std::stringstream ss;
 	if(mTotalSuccessful == 0)
 	{
@@ -7,6 +7,7 @@
 #include "scrapers/Scraper.h"
 #include "GuiComponent.h"
 
+class ScraperBatch;
 class ScraperSearchComponent;
 class TextComponent;
 
@@ -17,12 +18,14 @@ public:
 	virtual ~GuiScraperMulti();
 
 	void onSizeChanged() override;
+	void update(int deltaTime) override;
 	std::vector<HelpPrompt> getHelpPrompts() override;
 
 private:
 	void acceptResult(const ScraperSearchResult& result);
 	void skip();
 	void doNextSearch();
+	void onBatchProgress(const ScraperSearchParams& search);
 
 	void finish();
 
@@ -31,6 +34,8 @@ private:
 	unsigned int mTotalSuccessful;
 	unsigned int mTotalSkipped;
 	std::queue<ScraperSearchParams> mSearchQueue;
+	// RetroPangui: 자동 모드(결과 확인 안 함)는 ScraperBatch로 여러 게임을 동시에 처리
+	std::unique_ptr<ScraperBatch> mBatch;
 
 	NinePatchComponent mBackground;
 	ComponentGrid mGrid;
@@ -13,6 +13,8 @@
 #include "views/ViewController.h"
 #include "CollectionSystemManager.h"
 #include "EmulationStation.h"
+#include "FileFilterIndex.h"
+#include "GamelistWriter.h"
 #include "InputConfig.h"
 #include "InputManager.h"
 #include "LocaleES.h"
@@ -22,6 +24,7 @@
 #include "platform.h"
 #include "PowerSaver.h"
 #include "ScraperCmdLine.h"
+#include "scrapers/ScraperCache.h"
 #include "Settings.h"
 #include "SystemData.h"
 #include "SystemScreenSaver.h"
@@ -51,6 +54,9 @@
 #include <csignal>
 
 bool scrape_cmdline = false;
+std::string scrape_batch_systems;
+bool scrape_missing_only = false;
+bool scrape_hash_roms = false;
 
 // 2026-07-13: 모니터 핫스왑 대응. hdmi-hotplug(udev)가 "다른 모니터로 교체"를
 // 감지하면 ES에 SIGUSR1을 보냄 - ES 프로세스를 죽이지 않고(메뉴 위치 등
@@ -191,6 +197,25 @@ bool parseArgs(int argc, char* argv[])
 		}else if(strcmp(argv[i], "--scrape") == 0)
 		{
 			scrape_cmdline = true;
+		}else if(strcmp(argv[i], "--scrape-batch") == 0 && i + 1 < argc)
+		{
+			scrape_cmdline = true;
+			scrape_batch_systems = argv[i + 1];
+			i++; // skip system list
+		}else if(strcmp(argv[i], "--scrape-missing-only") == 0)
+		{
+			scrape_missing_only = true;
+		}else if(strcmp(argv[i], "--scrape-hash") == 0)
+		{
+			scrape_hash_roms = true;
+		}else if(strcmp(argv[i], "--scrape-jobs") == 0 && i + 1 < argc)
+		{
+			Settings::getInstance()->setInt("ScraperConcurrency", atoi(argv[i + 1]));
+			i++; // skip job count
+		}else if(strcmp(argv[i], "--scraper-url") == 0 && i + 1 < argc)
+		{
+			Settings::getInstance()->setString("ScraperBaseUrl", argv[i + 1]);
+			i++; // skip url
 		}else if(strcmp(argv[i], "--max-vram") == 0)
 		{
 			int maxVRAM = atoi(argv[i + 1]);
@@ -264,7 +289,15 @@ bool parseArgs(int argc, char* argv[])
 				"                               .emulationstation/es_settings.cfg, aso.\n"
 				"                               Subfolder .emulationstation/ will be created.\n"
 				"\nScrape mode:\n"
-				"--scrape                       scrape using command line interface\n\n"
+				"--scrape                       scrape using command line interface\n"
+				"--scrape-batch SYSTEMS|all     scrape without prompting, SYSTEMS is a comma\n"
+				"                               separated list of system names\n"
+				"--scrape-missing-only          with --scrape-batch, only games without an image\n"
+				"--scrape-hash                  with --scrape-batch, compute ROM CRC32/MD5 first\n"
+				"                               so ScreenScraper can match games by checksum\n"
+				"--scrape-jobs N                searches/downloads to keep in flight (p)\n"
+				"--scraper-url URL              send scraper API requests to URL instead, e.g.\n"
+				"                               a local mock server replaying recorded responses\n\n"
 				"Note: Switches marked (p) will be persisted in es_settings.cfg when any\n"
 				"setting is changed via EmulationStation UI.\n\n"
 				"Please refer to the online documentation for additional information:\n"
@@ -444,15 +477,21 @@ int main(int argc, char* argv[])
 	//run the command line scraper then quit
 	if(scrape_cmdline)
 	{
-		return run_scraper_cmdline();
+		int result = scrape_batch_systems.empty() ? run_scraper_cmdline()
+			: run_scraper_batch_cmdline(scrape_batch_systems, scrape_missing_only, scrape_hash_roms);
+		ScraperCache::deinit();
+		GamelistWriter::deinit(); // 배치가 넘긴 gamelist 저장이 끝날 때까지 기다림
+		HttpReq::logStats();
+		return result;
 	}
 
-	Log::flush(); // system config loaded OK — about to preload game lists
-
-	// preload what we can right away instead of waiting for the user to select it
-	// this makes for no delays when accessing content, but a longer startup time
-	ViewController::get()->preload();
-	Log::flush(); // preload complete
+	// RetroPangui: 게임 목록 뷰는 미리 만들지 않는다 - 시스템에 처음 들어갈 때 뷰(테마 적용)를 만들고
+	// 목록은 FileData 포인터 배열을 DataSource로 넘길 뿐이라(항목은 화면에 보일 때 생성) 기다릴 일이 없음.
+	// 예전 preload()가 뷰를 만들며 하던 UI 모드(키오스크/키즈) 필터 적용만 여기서 - 아직 들어가 보지 않은
+	// 시스템도 캐러셀의 표시 게임 수(와 빈 시스템 숨김)가 필터를 따라야 하므로
+	for(auto it = SystemData::sSystemVector.cbegin(); it != SystemData::sSystemVector.cend(); it++)
+		(*it)->getIndex()->resetFilters();
+	Log::flush(); // system config loaded OK
 
 	if(splashScreen)
 		window.renderLoadingScreen("Done.");
@@ -719,8 +758,11 @@ int main(int argc, char* argv[])
 		MusicManager::getInstance()->update(); // 트랙 종료 감지 → 다음 곡
 		window.render();
 		Renderer::swapBuffers();
+		InputManager::getInstance()->onFrameSwapped();
 
-		Log::flush();
+		// RetroPangui: 한동안 입력이 없으면 쌓인 gamelist 저널을 gamelist.xml에 반영 (없으면 no-op)
+		if(window.getTimeSinceLastInput() >= 5000)
+			SystemData::compactGamelistJournals();
 	}
 
 	while(window.peekGui() != ViewController::get())
@@ -730,8 +772,11 @@ int main(int argc, char* argv[])
 	window.deinit();
 
 	MameNames::deinit();
+	ScraperCache::deinit();
 	CollectionSystemManager::deinit();
 	SystemData::deleteSystems();
+	GamelistWriter::deinit(); // 위에서 넘긴 저장까지 모두 끝날 때까지 기다림
+	HttpReq::logStats();
 
 	// call this ONLY when linking with FreeImage as a static library
 #ifdef FREEIMAGE_LIB
@@ -116,7 +116,7 @@ void thegamesdb_generate_json_scraper_requests(const ScraperSearchParams& params
 	std::queue<std::unique_ptr<ScraperRequest>>& requests, std::vector<ScraperSearchResult>& results)
 {
 	resources.prepare();
-	std::string path = "https://api.thegamesdb.net/v1";
+	std::string path = getScraperApiUrl("https://api.thegamesdb.net/v1");
 	bool usingGameID = false;
 	const std::string apiKey = std::string("apikey=") + resources.getApiKey();
 	std::string cleanName = params.nameOverride;
@@ -235,8 +235,8 @@ std::string getDeveloperString(const Value& v)
 	bool first = true;
 	for (int i = 0; i < (int)v.Size(); ++i)
 	{
-		auto mapIt = resources.gamesdb_new_developers_map.find(getIntOrThrow(v[i]));
-		if (mapIt == resources.gamesdb_new_developers_map.cend())
+		const char* name = resources.gamesdb_new_developers_map.find(getIntOrThrow(v[i]));
+		if (name == nullptr)
 		{
 			continue;
 		}
@@ -244,7 +244,7 @@ std::string getDeveloperString(const Value& v)
 		{
 			out += ", ";
 		}
-		out += mapIt->second;
+		out += name;
 		first = false;
 	}
 	return out;
@@ -260,8 +260,8 @@ std::string getPublisherString(const Value& v)
 	bool first = true;
 	for (int i = 0; i < (int)v.Size(); ++i)
 	{
-		auto mapIt = resources.gamesdb_new_publishers_map.find(getIntOrThrow(v[i]));
-		if (mapIt == resources.gamesdb_new_publishers_map.cend())
+		const char* name = resources.gamesdb_new_publishers_map.find(getIntOrThrow(v[i]));
+		if (name == nullptr)
 		{
 			continue;
 		}
@@ -269,7 +269,7 @@ std::string getPublisherString(const Value& v)
 		{
 			out += ", ";
 		}
-		out += mapIt->second;
+		out += name;
 		first = false;
 	}
 	return out;
@@ -285,8 +285,8 @@ std::string getGenreString(const Value& v)
 	bool first = true;
 	for (int i = 0; i < (int)v.Size(); ++i)
 	{
-		auto mapIt = resources.gamesdb_new_genres_map.find(getIntOrThrow(v[i]));
-		if (mapIt == resources.gamesdb_new_genres_map.cend())
+		const char* name = resources.gamesdb_new_genres_map.find(getIntOrThrow(v[i]));
+		if (name == nullptr)
 		{
 			continue;
 		}
@@ -294,7 +294,7 @@ std::string getGenreString(const Value& v)
 		{
 			out += ", ";
 		}
-		out += mapIt->second;
+		out += name;
 		first = false;
 	}
 	return out;
@@ -1,11 +1,14 @@
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <memory>
+#include <sstream>
 #include <thread>
 
 #include "Log.h"
 
 #include "scrapers/GamesDBJSONScraperResources.h"
+#include "scrapers/Scraper.h"
 #include "utils/FileSystemUtil.h"
 
 
@@ -44,9 +47,86 @@ void ensureScrapersResourcesDir()
 		Utils::FileSystem::createDirectory(path);
 }
 
+// gamesdb_genres.json -> gamesdb_genres.tsv
+std::string genTablePath(const std::string& json_path)
+{
+	return Utils::FileSystem::getParent(json_path) + "/" + Utils::FileSystem::getStem(json_path) + ".tsv";
+}
+
 } // namespace
 
 
+void GamesDBResourceTable::add(int id, const std::string& name)
+{
+	Item item;
+	item.id = id;
+	item.offset = (unsigned int)mNames.size();
+	mItems.push_back(item);
+	mNames.append(name);
+	mNames.push_back('\0');
+}
+
+void GamesDBResourceTable::finish()
+{
+	// stable_sort keeps insertion order for equal ids so the last one can win
+	std::stable_sort(mItems.begin(), mItems.end(), [](const Item& a, const Item& b) { return a.id < b.id; });
+
+	std::vector<Item> unique;
+	unique.reserve(mItems.size());
+	for (auto& item : mItems)
+	{
+		if (!unique.empty() && unique.back().id == item.id)
+			unique.back() = item;
+		else
+			unique.push_back(item);
+	}
+	mItems.swap(unique);
+	mItems.shrink_to_fit();
+}
+
+void GamesDBResourceTable::clear()
+{
+	mItems.clear();
+	mNames.clear();
+}
+
+const char* GamesDBResourceTable::find(int id) const
+{
+	auto it = std::lower_bound(mItems.cbegin(), mItems.cend(), id, [](const Item& item, int value) { return item.id < value; });
+	if (it == mItems.cend() || it->id != id)
+		return nullptr;
+
+	return mNames.c_str() + it->offset;
+}
+
+bool GamesDBResourceTable::loadTable(const std::string& path)
+{
+	std::ifstream fin(path);
+	if (!fin.good())
+		return false;
+
+	clear();
+	std::string line;
+	while (std::getline(fin, line))
+	{
+		size_t tab = line.find('\t');
+		if (tab == std::string::npos)
+			continue;
+		add(atoi(line.c_str()), line.substr(tab + 1));
+	}
+	finish();
+	return !empty();
+}
+
+bool GamesDBResourceTable::saveTable(const std::string& path) const
+{
+	std::ofstream fout(path);
+	for (auto& item : mItems)
+		fout << item.id << '\t' << (mNames.c_str() + item.offset) << '\n';
+	return fout.good();
+}
+
+
 std::string getScrapersResouceDir()
 {
 	return Utils::FileSystem::getGenericPath(
@@ -123,7 +203,7 @@ bool TheGamesDBJSONRequestResources::checkLoaded()
 	return !gamesdb_new_genres_map.empty() && !gamesdb_new_developers_map.empty() && !gamesdb_new_publishers_map.empty();
 }
 
-bool TheGamesDBJSONRequestResources::saveResource(HttpReq* req, std::unordered_map<int, std::string>& resource,
+bool TheGamesDBJSONRequestResources::saveResource(HttpReq* req, GamesDBResourceTable& resource,
 	const std::string& resource_name, const std::string& file_name)
 {
 
@@ -147,13 +227,16 @@ bool TheGamesDBJSONRequestResources::saveResource(HttpReq* req, std::unordered_m
 	std::ofstream fout(file_name);
 	fout << req->getContent();
 	fout.close();
+
+	// the compact table is regenerated from the new JSON
+	Utils::FileSystem::removeFile(genTablePath(file_name));
 	loadResource(resource, resource_name, file_name);
 	return true;
 }
 
 std::unique_ptr<HttpReq> TheGamesDBJSONRequestResources::fetchResource(const std::string& endpoint)
 {
-	std::string path = "https://api.thegamesdb.net/v1";
+	std::string path = getScraperApiUrl("https://api.thegamesdb.net/v1");
 	path += endpoint;
 	path += "?apikey=" + getApiKey();
 
@@ -162,9 +245,16 @@ std::unique_ptr<HttpReq> TheGamesDBJSONRequestResources::fetchResource(const std
 
 
 int TheGamesDBJSONRequestResources::loadResource(
-	std::unordered_map<int, std::string>& resource, const std::string& resource_name, const std::string& file_name)
+	GamesDBResourceTable& resource, const std::string& resource_name, const std::string& file_name)
 {
+	// RetroPangui: JSON을 처음 파싱할 때 저장해 둔 압축 테이블이 있으면 그걸 읽음
+	const std::string table_name = genTablePath(file_name);
+	if (resource.loadTable(table_name))
+	{
+		return 0;
+	}
 
+	resource.clear();
 
 	std::ifstream fin(file_name);
 	if (!fin.good())
@@ -201,7 +291,13 @@ int TheGamesDBJSONRequestResources::loadResource(
 		{
 			continue;
 		}
-		resource[entry["id"].GetInt()] = entry["name"].GetString();
+		resource.add(entry["id"].GetInt(), entry["name"].GetString());
+	}
+	resource.finish();
+
+	if (!resource.empty())
+	{
+		resource.saveTable(table_name);
 	}
 	return resource.empty();
 }
@@ -5,10 +5,40 @@
 #include <fstream>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "HttpReq.h"
 
+// RetroPangui: TheGamesDB id -> 이름 조회 테이블. id로 정렬한 배열 하나와 이름을 이어 붙인 문자열 하나라
+// 항목마다 할당이 없고 이진 탐색으로 찾는다. JSON 원본은 받은 직후 한 번만 파싱하고
+// "<이름>.tsv"(id<TAB>이름 한 줄씩)로 저장해 두어, 다음 실행부터는 JSON DOM 없이 바로 읽는다.
+class GamesDBResourceTable
+{
+public:
+	void add(int id, const std::string& name);
+	// add()를 다 한 뒤 한 번 - 정렬, 같은 id는 나중 것
+	void finish();
+	void clear();
+
+	// 없으면 nullptr
+	const char* find(int id) const;
+	inline bool empty() const { return mItems.empty(); }
+	inline size_t size() const { return mItems.size(); }
+
+	bool loadTable(const std::string& path);
+	bool saveTable(const std::string& path) const;
+
+private:
+	struct Item
+	{
+		int id;
+		unsigned int offset; // mNames 안의 위치, '\0'으로 끝남
+	};
+
+	std::vector<Item> mItems;
+	std::string mNames;
+};
+
 
 struct TheGamesDBJSONRequestResources
 {
@@ -18,19 +48,19 @@ struct TheGamesDBJSONRequestResources
 	void ensureResources();
 	std::string getApiKey() const;
 
-	std::unordered_map<int, std::string> gamesdb_new_developers_map;
-	std::unordered_map<int, std::string> gamesdb_new_publishers_map;
-	std::unordered_map<int, std::string> gamesdb_new_genres_map;
+	GamesDBResourceTable gamesdb_new_developers_map;
+	GamesDBResourceTable gamesdb_new_publishers_map;
+	GamesDBResourceTable gamesdb_new_genres_map;
 
   private:
 	bool checkLoaded();
 
-	bool saveResource(HttpReq* req, std::unordered_map<int, std::string>& resource, const std::string& resource_name,
+	bool saveResource(HttpReq* req, GamesDBResourceTable& resource, const std::string& resource_name,
 		const std::string& file_name);
 	std::unique_ptr<HttpReq> fetchResource(const std::string& endpoint);
 
 	int loadResource(
-		std::unordered_map<int, std::string>& resource, const std::string& resource_name, const std::string& file_name);
+		GamesDBResourceTable& resource, const std::string& resource_name, const std::string& file_name);
 
 	std::unique_ptr<HttpReq> gamesdb_developers_resource_request;
 	std::unique_ptr<HttpReq> gamesdb_publishers_resource_request;
@@ -0,0 +1,189 @@
+#include "scrapers/RomHasher.h"
+
+#include "scrapers/GamesDBJSONScraperResources.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/HashUtil.h"
+#include "utils/ThreadPool.h"
+#include "FileData.h"
+#include "Log.h"
+#include <pugixml.hpp>
+#include <SDL_timer.h>
+#include <atomic>
+#include <sys/stat.h>
+
+RomHasher* RomHasher::getInstance()
+{
+	static RomHasher instance;
+	return &instance;
+}
+
+RomHasher::RomHasher() : mDirty(false)
+{
+	load();
+}
+
+bool RomHasher::getFileStamp(const std::string& path, unsigned long long& size, long long& mtime)
+{
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode))
+		return false;
+
+	size = (unsigned long long)info.st_size;
+	mtime = (long long)info.st_mtime;
+	return true;
+}
+
+bool RomHasher::isCurrent(const std::string& path, Entry& entry)
+{
+	unsigned long long size;
+	long long mtime;
+	if (!getFileStamp(path, size, mtime))
+		return false;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto it = mEntries.find(path);
+	if (it == mEntries.end() || it->second.hash.size != size || it->second.mtime != mtime)
+		return false;
+
+	entry = it->second;
+	return true;
+}
+
+bool RomHasher::getHash(const FileData* game, RomHash& out)
+{
+	Entry entry;
+	if (!isCurrent(game->getPath(), entry))
+		return false;
+
+	out = entry.hash;
+	return true;
+}
+
+void RomHasher::hashFile(const std::string& path)
+{
+	Entry entry;
+	unsigned long long size;
+	if (!getFileStamp(path, size, entry.mtime))
+		return;
+
+	if (!Utils::Hash::hashFile(path, entry.hash.crc32, entry.hash.md5, entry.hash.size))
+	{
+		LOG(LogWarning) << "RomHasher: 읽기 실패 - " << path;
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mEntries[path] = entry;
+	mDirty = true;
+}
+
+size_t RomHasher::hashGames(const std::vector<FileData*>& games, const std::function<void(size_t, size_t)>& progress)
+{
+	// 폴더형 게임(디렉터리)이나 이미 최신 해시가 있는 파일은 건너뜀
+	std::vector<std::string> paths;
+	unsigned long long totalBytes = 0;
+	for (auto game : games)
+	{
+		Entry entry;
+		const std::string& path = game->getPath();
+		unsigned long long size;
+		long long mtime;
+		if (!getFileStamp(path, size, mtime) || isCurrent(path, entry))
+			continue;
+
+		paths.push_back(path);
+		totalBytes += size;
+	}
+
+	if (paths.empty())
+		return 0;
+
+	const unsigned int start = SDL_GetTicks();
+	std::atomic<size_t> done(0);
+
+	// 디스크를 여러 파일에서 동시에 읽으면 SD카드/SSD에서는 더 빠르고, 해시 계산도 코어별로 나뉜다
+	if (std::thread::hardware_concurrency() > 2 && paths.size() > 1)
+	{
+		Utils::ThreadPool pool;
+		for (auto& path : paths)
+			pool.queueWorkItem([this, &path, &done] { hashFile(path); done++; });
+
+		pool.wait([&progress, &done, &paths] { if (progress) progress(done, paths.size()); }, 100);
+	}
+	else
+	{
+		for (auto& path : paths)
+		{
+			hashFile(path);
+			done++;
+			if (progress)
+				progress(done, paths.size());
+		}
+	}
+
+	const unsigned int elapsed = SDL_GetTicks() - start;
+	LOG(LogInfo) << "RomHasher: " << paths.size() << "개 파일 " << (totalBytes / (1024 * 1024)) << " MiB 해시 ("
+		<< elapsed << "ms, " << (elapsed > 0 ? totalBytes / 1024 / elapsed : 0) << " MiB/s)";
+
+	save();
+	return paths.size();
+}
+
+std::string RomHasher::getCachePath() const
+{
+	return getScrapersResouceDir() + "/rom_hashes.xml";
+}
+
+void RomHasher::load()
+{
+	const std::string path = getCachePath();
+	if (!Utils::FileSystem::exists(path))
+		return;
+
+	pugi::xml_document doc;
+	pugi::xml_parse_result result = doc.load_file(path.c_str());
+	if (!result)
+	{
+		LOG(LogWarning) << "RomHasher: 파싱 실패 (" << path << ") - " << result.description();
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	for (pugi::xml_node node = doc.child("romHashes").child("rom"); node; node = node.next_sibling("rom"))
+	{
+		Entry& entry = mEntries[node.attribute("path").as_string()];
+		entry.hash.crc32 = node.attribute("crc32").as_uint();
+		entry.hash.md5 = node.attribute("md5").as_string();
+		entry.hash.size = node.attribute("size").as_ullong();
+		entry.mtime = node.attribute("mtime").as_llong();
+	}
+}
+
+void RomHasher::save()
+{
+	pugi::xml_document doc;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (!mDirty)
+			return;
+		mDirty = false;
+
+		pugi::xml_node root = doc.append_child("romHashes");
+		for (auto it = mEntries.cbegin(); it != mEntries.cend(); ++it)
+		{
+			pugi::xml_node node = root.append_child("rom");
+			node.append_attribute("path").set_value(it->first.c_str());
+			node.append_attribute("crc32").set_value(it->second.hash.crc32);
+			node.append_attribute("md5").set_value(it->second.hash.md5.c_str());
+			node.append_attribute("size").set_value(it->second.hash.size);
+			node.append_attribute("mtime").set_value(it->second.mtime);
+		}
+	}
+
+	const std::string dir = getScrapersResouceDir();
+	if (!Utils::FileSystem::exists(dir))
+		Utils::FileSystem::createDirectory(dir);
+
+	if (!doc.save_file(getCachePath().c_str()))
+		LOG(LogWarning) << "RomHasher: 저장 실패 - " << getCachePath();
+}
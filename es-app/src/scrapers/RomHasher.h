@@ -0,0 +1,58 @@
+#pragma once
+#ifndef ES_APP_SCRAPERS_ROM_HASHER_H
+#define ES_APP_SCRAPERS_ROM_HASHER_H
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FileData;
+
+struct RomHash
+{
+	unsigned int crc32;
+	std::string md5;
+	unsigned long long size;
+};
+
+// RetroPangui: ROM 파일 CRC32/MD5 서비스. ScreenScraper는 체크섬으로 게임을 정확히 찾을 수 있는데
+// (파일 이름이 달라도 맞음), 스크랩할 때마다 ROM을 다시 읽지 않도록 계산한 값을 경로별로
+// 크기+수정 시각과 함께 ~/.emulationstation/scrapers/rom_hashes.xml에 저장해 둔다.
+// getHash()는 저장된 값만 돌려주고 파일을 읽지 않으므로 UI 스레드에서 불러도 된다.
+// 계산은 hashGames()가 ThreadPool로 여러 파일을 동시에 읽으며 한다(스레드 안전).
+class RomHasher
+{
+public:
+	static RomHasher* getInstance();
+
+	// 저장된 해시가 있고 파일이 그 뒤로 바뀌지 않았으면 true
+	bool getHash(const FileData* game, RomHash& out);
+
+	// 해시가 없거나 오래된 게임만 계산, 계산한 개수 반환. progress(끝난 수, 전체)는 호출 스레드에서 불림
+	size_t hashGames(const std::vector<FileData*>& games, const std::function<void(size_t, size_t)>& progress = nullptr);
+
+	void save();
+
+private:
+	struct Entry
+	{
+		RomHash hash;
+		long long mtime;
+	};
+
+	RomHasher();
+
+	static bool getFileStamp(const std::string& path, unsigned long long& size, long long& mtime);
+	bool isCurrent(const std::string& path, Entry& entry);
+	void hashFile(const std::string& path);
+	void load();
+	std::string getCachePath() const;
+
+	std::mutex mMutex;
+	std::unordered_map<std::string, Entry> mEntries;
+	bool mDirty;
+};
+
+#endif // ES_APP_SCRAPERS_ROM_HASHER_H
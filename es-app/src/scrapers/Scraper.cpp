@@ -1,13 +1,21 @@
 #include "scrapers/Scraper.h"
 
+#include "scrapers/ScraperCache.h"
 #include "FileData.h"
 #include "GamesDBJSONScraper.h"
 #include "ScreenScraper.h"
 #include "Log.h"
 #include "Settings.h"
 #include "SystemData.h"
+#include "utils/FileSystemUtil.h"
 #include <FreeImage.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <thread>
 
 const std::map<std::string, generate_scraper_requests_func> scraper_request_funcs {
 	{ "TheGamesDB", &thegamesdb_generate_json_scraper_requests },
@@ -24,6 +32,11 @@ std::unique_ptr<ScraperSearchHandle> startScraperSearch(const ScraperSearchParam
 	{
 		LOG(LogWarning) << "Configured scraper (" << name << ") unavailable, scraping aborted.";
 	}
+	else if (ScraperCache::getInstance()->find(handle->mCacheKey = ScraperCache::getKey(name, params), handle->mResults))
+	{
+		// RetroPangui: 캐시된 검색 결과 - 요청 없이 다음 update()에서 바로 끝남
+		handle->mCacheKey.clear();
+	}
 	else
 	{
 		scraper_request_funcs.at(name)(params, handle->mRequestQueue, handle->mResults);
@@ -49,6 +62,21 @@ bool isValidConfiguredScraper()
 	return scraper_request_funcs.find(name) != scraper_request_funcs.end();
 }
 
+std::string getScraperApiUrl(const std::string& defaultBase)
+{
+	const std::string& override = Settings::getInstance()->getString("ScraperBaseUrl");
+	if (override.empty())
+		return defaultBase;
+
+	// keep the API path ("/v1", "/api2") so a mock server can tell the sources apart
+	size_t scheme = defaultBase.find("://");
+	size_t path = defaultBase.find('/', scheme == std::string::npos ? 0 : scheme + 3);
+	std::string base = override;
+	if (!base.empty() && base.back() == '/')
+		base.pop_back();
+	return path == std::string::npos ? base : base + defaultBase.substr(path);
+}
+
 // ScraperSearchHandle
 ScraperSearchHandle::ScraperSearchHandle()
 {
@@ -91,6 +119,9 @@ void ScraperSearchHandle::update()
 	// we finished without any errors!
 	if(mRequestQueue.empty())
 	{
+		if(!mCacheKey.empty())
+			ScraperCache::getInstance()->store(mCacheKey, mResults);
+
 		setStatus(ASYNC_DONE);
 		return;
 	}
@@ -160,9 +191,19 @@ MDResolveHandle::MDResolveHandle(const ScraperSearchResult& result, const Scrape
 
 		std::string imgPath = getSaveAsPath(search, "image", ext);
 
-		mFuncs.push_back(ResolvePair(downloadImageAsync(result.imageUrl, imgPath), [this, imgPath]
+		// RetroPangui: 썸네일을 켰으면 같은 다운로드로 표시용 썸네일도 만든다
+		std::string thumbPath;
+		if (Settings::getInstance()->getInt("ScraperThumbnailWidth") > 0)
+			thumbPath = getSaveAsPath(search, "thumb", ext);
+
+		std::unique_ptr<ImageDownloadHandle> download = downloadImageAsync(result.imageUrl, imgPath, thumbPath);
+		ImageDownloadHandle* downloadPtr = download.get();
+
+		mFuncs.push_back(ResolvePair(std::move(download), [this, imgPath, thumbPath, downloadPtr]
 		{
 			mResult.mdl.set("image", imgPath);
+			if (downloadPtr->hasThumbnail())
+				mResult.mdl.set("thumbnail", thumbPath);
 			mResult.imageUrl = "";
 		}));
 	}
@@ -193,19 +234,278 @@ void MDResolveHandle::update()
 		setStatus(ASYNC_DONE);
 }
 
-std::unique_ptr<ImageDownloadHandle> downloadImageAsync(const std::string& url, const std::string& saveAs)
+std::unique_ptr<ImageDownloadHandle> downloadImageAsync(const std::string& url, const std::string& saveAs, const std::string& thumbnailSaveAs)
 {
+	int thumbnailWidth = thumbnailSaveAs.empty() ? 0 : Settings::getInstance()->getInt("ScraperThumbnailWidth");
+
 	return std::unique_ptr<ImageDownloadHandle>(new ImageDownloadHandle(url, saveAs,
-		Settings::getInstance()->getInt("ScraperResizeWidth"), Settings::getInstance()->getInt("ScraperResizeHeight")));
+		Settings::getInstance()->getInt("ScraperResizeWidth"), Settings::getInstance()->getInt("ScraperResizeHeight"),
+		thumbnailSaveAs, thumbnailWidth));
 }
 
-ImageDownloadHandle::ImageDownloadHandle(const std::string& url, const std::string& path, int maxWidth, int maxHeight) :
-	mSavePath(path), mMaxWidth(maxWidth), mMaxHeight(maxHeight), mReq(new HttpReq(url))
+// RetroPangui: 이미지 후처리 작업 스레드. 다운로드는 네트워크 스레드가, 디코드/축소/인코드는 여기서 한다.
+// 스크랩 중에만 일이 있으므로 처음 쓸 때 띄우고, 일이 없으면 조건 변수에서 잠들어 있는다.
+namespace
 {
+	typedef std::chrono::steady_clock ImageClock;
+
+	double elapsedMs(ImageClock::time_point since)
+	{
+		return std::chrono::duration<double, std::milli>(ImageClock::now() - since).count();
+	}
+
+	std::mutex sImageStatsMutex;
+	ImageProcessStats sImageStats = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	class ImageWorkerPool
+	{
+	public:
+		static ImageWorkerPool& get()
+		{
+			static ImageWorkerPool pool;
+			return pool;
+		}
+
+		void queueWork(const std::function<void()>& work)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mQueue.push_back(work);
+			}
+			mCond.notify_one();
+		}
+
+	private:
+		ImageWorkerPool() : mExit(false)
+		{
+			// 디코드/인코드는 CPU만 쓰므로 UI 스레드 몫 하나를 남기고 최대 4개
+			int count = std::min(4, std::max(1, (int)std::thread::hardware_concurrency() - 1));
+			for (int i = 0; i < count; i++)
+				mThreads.push_back(std::thread(&ImageWorkerPool::run, this));
+
+			LOG(LogDebug) << "ImageWorkerPool: " << count << " threads";
+		}
+
+		~ImageWorkerPool()
+		{
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mExit = true;
+				mQueue.clear();
+			}
+			mCond.notify_all();
+
+			for (auto& thread : mThreads)
+				thread.join();
+		}
+
+		void run()
+		{
+			while (true)
+			{
+				std::function<void()> work;
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+					mCond.wait(lock, [this] { return mExit || !mQueue.empty(); });
+					if (mExit)
+						return;
+
+					work = mQueue.front();
+					mQueue.pop_front();
+				}
+				work();
+			}
+		}
+
+		std::mutex mMutex;
+		std::condition_variable mCond;
+		std::deque< std::function<void()> > mQueue;
+		std::vector<std::thread> mThreads;
+		bool mExit;
+	};
+
+	//you can pass 0 for width or height to keep aspect ratio
+	FIBITMAP* rescaleImage(FIBITMAP* image, int maxWidth, int maxHeight)
+	{
+		float width = (float)FreeImage_GetWidth(image);
+		float height = (float)FreeImage_GetHeight(image);
+
+		if(maxWidth == 0)
+		{
+			maxWidth = (int)((maxHeight / height) * width);
+		}else if(maxHeight == 0)
+		{
+			maxHeight = (int)((maxWidth / width) * height);
+		}
+
+		return FreeImage_Rescale(image, maxWidth, maxHeight, FILTER_BILINEAR);
+	}
+}
+
+struct ImageDownloadHandle::Job
+{
+	enum State
+	{
+		QUEUED,
+		DONE,
+		FAILED
+	};
+
+	std::shared_ptr<HttpReq> req; // 받은 본문 - 복사하지 않고 그대로 디코드
+	std::string savePath;
+	std::string thumbnailPath;
+	int maxWidth;
+	int maxHeight;
+	int thumbnailWidth;
+
+	std::atomic<int> state;
+	std::atomic<bool> cancelled;
+	// state가 QUEUED가 아니게 된 뒤에만 읽는다
+	std::string error;
+	bool thumbnailSaved;
+
+	double downloadMs;
+	ImageClock::time_point queuedTime;
+
+	void run();
+};
+
+void ImageDownloadHandle::Job::run()
+{
+	if (cancelled)
+		return;
+
+	double queueMs = elapsedMs(queuedTime);
+	double decodeMs = 0, resizeMs = 0, encodeMs = 0, thumbnailMs = 0;
+
+	const std::string& data = req->getContent();
+	ImageClock::time_point start = ImageClock::now();
+
+	// FreeImage는 읽기 전용 메모리 스트림을 고치지 않는다
+	FIMEMORY* stream = FreeImage_OpenMemory((BYTE*)data.data(), (DWORD)data.size());
+	FREE_IMAGE_FORMAT format = FreeImage_GetFileTypeFromMemory(stream, 0);
+	if (format == FIF_UNKNOWN)
+		format = FreeImage_GetFIFFromFilename(savePath.c_str());
+
+	FIBITMAP* image = NULL;
+	if (format == FIF_UNKNOWN)
+		error = "could not detect filetype";
+	else if (!FreeImage_FIFSupportsReading(format))
+		error = "file format reading not supported";
+	else if ((image = FreeImage_LoadFromMemory(format, stream)) == NULL)
+		error = "could not decode image";
+
+	FreeImage_CloseMemory(stream);
+	decodeMs = elapsedMs(start);
+
+	if (image != NULL && (maxWidth != 0 || maxHeight != 0))
+	{
+		start = ImageClock::now();
+		FIBITMAP* imageRescaled = rescaleImage(image, maxWidth, maxHeight);
+		resizeMs = elapsedMs(start);
+
+		start = ImageClock::now();
+		if (imageRescaled == NULL)
+			error = "could not resize image (not enough memory? invalid bitdepth?)";
+		else if (!FreeImage_Save(format, imageRescaled, savePath.c_str()))
+			error = "failed to save resized image";
+		encodeMs = elapsedMs(start);
+
+		if (imageRescaled != NULL)
+			FreeImage_Unload(imageRescaled);
+	}
+	else if (image != NULL)
+	{
+		// 원본 그대로 - 다시 인코드하지 않고 받은 바이트를 쓴다
+		start = ImageClock::now();
+		std::ofstream file(savePath.c_str(), std::ios::binary | std::ios::trunc);
+		file.write(data.data(), data.size());
+		if (!file.good())
+			error = "failed to save image";
+		encodeMs = elapsedMs(start);
+	}
+
+	thumbnailSaved = false;
+	if (image != NULL && error.empty() && thumbnailWidth > 0 && !cancelled)
+	{
+		// 축소본이 아니라 원본 디코드 결과에서 만들어야 화질이 덜 떨어진다. 원본이 더 작으면 키우지 않음
+		start = ImageClock::now();
+		FIBITMAP* thumbnail = ((int)FreeImage_GetWidth(image) > thumbnailWidth) ? rescaleImage(image, thumbnailWidth, 0) : image;
+		thumbnailSaved = (thumbnail != NULL && FreeImage_Save(format, thumbnail, thumbnailPath.c_str()));
+		if (thumbnail != NULL && thumbnail != image)
+			FreeImage_Unload(thumbnail);
+		thumbnailMs = elapsedMs(start);
+
+		// 썸네일은 덤이라 실패해도 이미지는 성공으로 둔다
+		if (!thumbnailSaved)
+			LOG(LogWarning) << "Failed to save thumbnail \"" << thumbnailPath << "\"";
+	}
+
+	if (image != NULL)
+		FreeImage_Unload(image);
+
+	{
+		std::unique_lock<std::mutex> lock(sImageStatsMutex);
+		sImageStats.images++;
+		if (!error.empty())
+			sImageStats.failures++;
+		sImageStats.downloadMs += downloadMs;
+		sImageStats.queueMs += queueMs;
+		sImageStats.decodeMs += decodeMs;
+		sImageStats.resizeMs += resizeMs;
+		sImageStats.encodeMs += encodeMs;
+		sImageStats.thumbnailMs += thumbnailMs;
+	}
+
+	LOG(LogDebug) << "Scraper image \"" << Utils::FileSystem::getFileName(savePath) << "\" (" << (data.size() / 1024) << " KiB): download "
+		<< (int)downloadMs << " ms, queue " << (int)queueMs << " ms, decode " << (int)decodeMs << " ms, resize " << (int)resizeMs
+		<< " ms, encode " << (int)encodeMs << " ms, thumbnail " << (int)thumbnailMs << " ms";
+
+	state = error.empty() ? DONE : FAILED;
+}
+
+ImageProcessStats getImageProcessStats()
+{
+	std::unique_lock<std::mutex> lock(sImageStatsMutex);
+	return sImageStats;
+}
+
+ImageDownloadHandle::ImageDownloadHandle(const std::string& url, const std::string& path, int maxWidth, int maxHeight,
+	const std::string& thumbnailPath, int thumbnailWidth) :
+	mSavePath(path), mThumbnailPath(thumbnailPath), mMaxWidth(maxWidth), mMaxHeight(maxHeight),
+	mThumbnailWidth(thumbnailPath.empty() ? 0 : thumbnailWidth), mThumbnailSaved(false), mStartTime(std::chrono::steady_clock::now())
+{
+	// 후처리할 게 없으면 받는 대로 파일에 쓰고, 있으면 메모리로 받아 작업 스레드에서 디코드
+	bool process = (mMaxWidth != 0 || mMaxHeight != 0 || mThumbnailWidth > 0);
+	mReq = std::make_shared<HttpReq>(url, process ? "" : path);
+	if (!process)
+		return;
+
+	mJob = std::make_shared<Job>();
+	mJob->req = mReq;
+	mJob->savePath = mSavePath;
+	mJob->thumbnailPath = mThumbnailPath;
+	mJob->maxWidth = mMaxWidth;
+	mJob->maxHeight = mMaxHeight;
+	mJob->thumbnailWidth = mThumbnailWidth;
+	mJob->state = Job::QUEUED;
+	mJob->cancelled = false;
+	mJob->thumbnailSaved = false;
+	mJob->downloadMs = 0;
+}
+
+ImageDownloadHandle::~ImageDownloadHandle()
+{
+	// 작업 스레드가 아직 안 집은 작업은 건너뛰게 - 작업은 자기 Job/HttpReq를 공유 포인터로 잡고 있어서 먼저 지워져도 안전
+	if (mJob)
+		mJob->cancelled = true;
 }
 
 void ImageDownloadHandle::update()
 {
+	if(mStatus != ASYNC_IN_PROGRESS)
+		return;
+
 	if(mReq->status() == HttpReq::REQ_IN_PROGRESS)
 		return;
 
@@ -217,31 +517,37 @@ void ImageDownloadHandle::update()
 		return;
 	}
 
-	// download is done, save it to disk
-	std::ofstream stream(mSavePath, std::ios_base::out | std::ios_base::binary);
-	if(stream.bad())
+	// no post-processing needed, the body was streamed straight into mSavePath
+	if(!mJob)
 	{
-		setError("Failed to open image path to write. Permission error? Disk full?");
+		setStatus(ASYNC_DONE);
 		return;
 	}
 
-	const std::string& content = mReq->getContent();
-	stream.write(content.data(), content.length());
-	stream.close();
-	if(stream.bad())
+	if(mJob->queuedTime == ImageClock::time_point())
 	{
-		setError("Failed to save image. Disk full?");
+		mJob->downloadMs = elapsedMs(mStartTime);
+		mJob->queuedTime = ImageClock::now();
+
+		std::shared_ptr<Job> job = mJob;
+		ImageWorkerPool::get().queueWork([job] { job->run(); });
 		return;
 	}
 
-	// resize it
-	if(!resizeImage(mSavePath, mMaxWidth, mMaxHeight))
+	switch(mJob->state)
 	{
+	case Job::DONE:
+		mThumbnailSaved = mJob->thumbnailSaved;
+		mJob.reset();
+		mReq.reset(); // 다운로드 버퍼 해제
+		setStatus(ASYNC_DONE);
+		break;
+
+	case Job::FAILED:
+		LOG(LogError) << "Error processing image \"" << mSavePath << "\": " << mJob->error;
 		setError("Error saving resized image. Out of memory? Disk full?");
-		return;
+		break;
 	}
-
-	setStatus(ASYNC_DONE);
 }
 
 //you can pass 0 for width or height to keep aspect ratio
@@ -273,18 +579,7 @@ bool resizeImage(const std::string& path, int maxWidth, int maxHeight)
 		return false;
 	}
 
-	float width = (float)FreeImage_GetWidth(image);
-	float height = (float)FreeImage_GetHeight(image);
-
-	if(maxWidth == 0)
-	{
-		maxWidth = (int)((maxHeight / height) * width);
-	}else if(maxHeight == 0)
-	{
-		maxHeight = (int)((maxWidth / width) * height);
-	}
-
-	FIBITMAP* imageRescaled = FreeImage_Rescale(image, maxWidth, maxHeight, FILTER_BILINEAR);
+	FIBITMAP* imageRescaled = rescaleImage(image, maxWidth, maxHeight);
 	FreeImage_Unload(image);
 
 	if(imageRescaled == NULL)
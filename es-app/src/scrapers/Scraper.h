@@ -5,6 +5,7 @@
 #include "AsyncHandle.h"
 #include "HttpReq.h"
 #include "MetaData.h"
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <queue>
@@ -105,6 +106,7 @@ protected:
 
 	std::queue< std::unique_ptr<ScraperRequest> > mRequestQueue;
 	std::vector<ScraperSearchResult> mResults;
+	std::string mCacheKey; // RetroPangui: 끝나면 결과를 ScraperCache에 저장할 키, 캐시 안 쓰면 빈 문자열
 };
 
 // will use the current scraper settings to pick the result source
@@ -116,6 +118,10 @@ std::vector<std::string> getScraperList();
 // returns true if the scraper configured in the settings is still valid
 bool isValidConfiguredScraper();
 
+// RetroPangui: 스크래퍼 API 기본 URL. Settings "ScraperBaseUrl"(--scraper-url)이 있으면 defaultBase의
+// scheme://host 부분만 그걸로 바꿔서 반환 - 녹화해 둔 응답을 돌려주는 로컬 목 서버로 시험할 때 사용
+std::string getScraperApiUrl(const std::string& defaultBase);
+
 typedef void (*generate_scraper_requests_func)(const ScraperSearchParams& params, std::queue< std::unique_ptr<ScraperRequest> >& requests, std::vector<ScraperSearchResult>& results);
 
 // -------------------------------------------------------------------------
@@ -138,18 +144,48 @@ private:
 	std::vector<ResolvePair> mFuncs;
 };
 
+// RetroPangui: 이미지 후처리 단계별 누적 시간(ms). 축소/썸네일이 필요한 이미지만 센다
+struct ImageProcessStats
+{
+	unsigned int images;
+	unsigned int failures;
+	double downloadMs;  // 요청 시작 ~ 다운로드 완료
+	double queueMs;     // 다운로드 완료 ~ 작업 스레드가 집어 들 때까지
+	double decodeMs;
+	double resizeMs;
+	double encodeMs;    // 인코드 + 파일 쓰기
+	double thumbnailMs; // 썸네일 축소 + 인코드 + 쓰기
+};
+ImageProcessStats getImageProcessStats();
+
+// RetroPangui: 축소(또는 썸네일)가 필요하면 파일 대신 메모리로 받아서, 그 버퍼를 작업 스레드에서
+// 디코드 -> 축소 -> 인코드해 savePath에 쓴다(디스크에서 다시 읽지 않고 update()를 부르는 UI 스레드도 막지 않음).
+// thumbnailWidth > 0이면 같은 디코드 결과로 그 너비의 썸네일도 thumbnailPath에 만든다.
+// 둘 다 필요 없으면 예전처럼 받는 대로 바로 파일에 쓴다.
 class ImageDownloadHandle : public AsyncHandle
 {
 public:
-	ImageDownloadHandle(const std::string& url, const std::string& path, int maxWidth, int maxHeight);
+	ImageDownloadHandle(const std::string& url, const std::string& path, int maxWidth, int maxHeight,
+		const std::string& thumbnailPath = "", int thumbnailWidth = 0);
+	~ImageDownloadHandle();
 
 	void update() override;
 
+	// ASYNC_DONE 이후에만 의미 있음
+	inline bool hasThumbnail() const { return mThumbnailSaved; }
+
 private:
-	std::unique_ptr<HttpReq> mReq;
+	struct Job;
+
+	std::shared_ptr<HttpReq> mReq;
+	std::shared_ptr<Job> mJob;
 	std::string mSavePath;
+	std::string mThumbnailPath;
 	int mMaxWidth;
 	int mMaxHeight;
+	int mThumbnailWidth;
+	bool mThumbnailSaved;
+	std::chrono::steady_clock::time_point mStartTime;
 };
 
 //About the same as "~/.emulationstation/downloaded_images/[system_name]/[game_name].[url's extension]".
@@ -157,7 +193,8 @@ private:
 std::string getSaveAsPath(const ScraperSearchParams& params, const std::string& suffix, const std::string& url);
 
 //Will resize according to Settings::getInt("ScraperResizeWidth") and Settings::getInt("ScraperResizeHeight").
-std::unique_ptr<ImageDownloadHandle> downloadImageAsync(const std::string& url, const std::string& saveAs);
+//RetroPangui: thumbnailSaveAs가 있으면 Settings "ScraperThumbnailWidth"(0이면 안 만듦) 너비의 썸네일도 만든다.
+std::unique_ptr<ImageDownloadHandle> downloadImageAsync(const std::string& url, const std::string& saveAs, const std::string& thumbnailSaveAs = "");
 
 // Resolves all metadata assets that need to be downloaded.
 std::unique_ptr<MDResolveHandle> resolveMetaDataAssets(const ScraperSearchResult& result, const ScraperSearchParams& search);
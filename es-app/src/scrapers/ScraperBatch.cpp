@@ -0,0 +1,277 @@
+#include "scrapers/ScraperBatch.h"
+
+#include "scrapers/ScraperCache.h"
+#include "FileData.h"
+#include "Gamelist.h"
+#include "Log.h"
+#include "MediaIndex.h"
+#include "Settings.h"
+#include "SystemData.h"
+#include "utils/FileSystemUtil.h"
+#include <algorithm>
+
+ScraperBatch::ScraperBatch(const std::queue<ScraperSearchParams>& searches, int concurrency) :
+	mConcurrency(std::max(1, concurrency)), mUnflushed(0),
+	mScraped(0), mSkipped(0), mFailed(0), mRetries(0), mStartTime(Clock::now())
+{
+	std::queue<ScraperSearchParams> queue(searches);
+	while (!queue.empty())
+	{
+		Job* job = new Job();
+		job->params = queue.front();
+		job->hasChosen = false;
+		job->attempts = 0;
+		job->notBefore = mStartTime;
+		mPending.push_back(job);
+		queue.pop();
+	}
+	mTotal = (unsigned int)mPending.size();
+
+	LOG(LogInfo) << "ScraperBatch: " << mTotal << " games, " << mConcurrency << " concurrent";
+}
+
+ScraperBatch::~ScraperBatch()
+{
+	cancel();
+}
+
+int ScraperBatch::getConfiguredConcurrency()
+{
+	return std::min(16, std::max(1, Settings::getInstance()->getInt("ScraperConcurrency")));
+}
+
+void ScraperBatch::update()
+{
+	Clock::time_point now = Clock::now();
+
+	// 진행 중인 작업 - finishJob()/retryOrFail()이 mActive에서 빼므로 인덱스로 순회
+	for (size_t i = 0; i < mActive.size(); )
+	{
+		Job* job = mActive[i];
+
+		if (job->resolve)
+		{
+			AsyncHandleStatus status = job->resolve->status();
+			if (status == ASYNC_DONE)
+			{
+				ScraperSearchResult result = job->resolve->getResult();
+				applyResult(job, result);
+				finishJob(job, SCRAPED, result.mdl.get("name"));
+				continue;
+			}
+			if (status == ASYNC_ERROR)
+			{
+				retryOrFail(job, job->resolve->getStatusString(), now);
+				continue;
+			}
+		}
+		else if (job->search)
+		{
+			AsyncHandleStatus status = job->search->status();
+			if (status == ASYNC_DONE)
+			{
+				onSearchDone(job);
+				continue;
+			}
+			if (status == ASYNC_ERROR)
+			{
+				retryOrFail(job, job->search->getStatusString(), now);
+				continue;
+			}
+		}
+		else
+		{
+			// 검색은 끝났고 이미지 호스트 차례를 기다리는 중
+			tryStart(job, now);
+		}
+		i++;
+	}
+
+	// 빈 자리에 새 작업(또는 백오프가 끝난 재시도) 투입
+	for (auto it = mPending.begin(); it != mPending.end() && (int)mActive.size() < mConcurrency; )
+	{
+		Job* job = *it;
+		if (job->notBefore > now || !tryStart(job, now))
+		{
+			++it;
+			continue;
+		}
+		mActive.push_back(job);
+		it = mPending.erase(it);
+	}
+
+	if (isDone() && mTotal > 0)
+		flush();
+}
+
+void ScraperBatch::cancel()
+{
+	for (auto job : mPending)
+		delete job;
+	for (auto job : mActive)
+		delete job;
+	mPending.clear();
+	mActive.clear();
+	flush();
+}
+
+bool ScraperBatch::tryStart(Job* job, Clock::time_point now)
+{
+	if (job->hasChosen)
+	{
+		job->host = getUrlHost(job->chosen.imageUrl);
+		if (!acquireHost(job->host, DOWNLOAD_INTERVAL_MS, now))
+			return false;
+		job->resolve = resolveMetaDataAssets(job->chosen, job->params);
+	}
+	else
+	{
+		// 검색 URL은 스크래퍼 구현 안에서 만들어지므로 소스 이름을 호스트로 취급.
+		// 캐시에 결과가 있으면 요청이 나가지 않으니 호스트 차례를 기다리지 않음
+		job->host = Settings::getInstance()->getString("Scraper");
+		if (!ScraperCache::getInstance()->has(ScraperCache::getKey(job->host, job->params)) && !acquireHost(job->host, SEARCH_INTERVAL_MS, now))
+			return false;
+		job->search = startScraperSearch(job->params);
+	}
+	return true;
+}
+
+bool ScraperBatch::acquireHost(const std::string& host, int intervalMs, Clock::time_point now)
+{
+	auto it = mHostNextStart.find(host);
+	if (it != mHostNextStart.end() && now < it->second)
+		return false;
+
+	mHostNextStart[host] = now + std::chrono::milliseconds(intervalMs);
+	return true;
+}
+
+void ScraperBatch::onSearchDone(Job* job)
+{
+	std::vector<ScraperSearchResult> results = job->search->getResults();
+	job->search.reset();
+
+	if (results.empty())
+	{
+		finishJob(job, SKIPPED, "no results");
+		return;
+	}
+
+	int index = mChooseFunc ? mChooseFunc(job->params, results) : 0;
+	if (index < 0 || index >= (int)results.size())
+	{
+		finishJob(job, SKIPPED, "skipped");
+		return;
+	}
+
+	const ScraperSearchResult& result = results.at(index);
+	if (result.imageUrl.empty())
+	{
+		applyResult(job, result);
+		finishJob(job, SCRAPED, result.mdl.get("name"));
+		return;
+	}
+
+	// 이미지 받기 단계 - 다음 update()부터 호스트 차례가 오면 시작
+	job->chosen = result;
+	job->hasChosen = true;
+	job->attempts = 0;
+	tryStart(job, Clock::now());
+}
+
+void ScraperBatch::retryOrFail(Job* job, const std::string& error, Clock::time_point now)
+{
+	job->search.reset();
+	job->resolve.reset();
+	job->attempts++;
+
+	if (job->attempts >= MAX_ATTEMPTS)
+	{
+		finishJob(job, FAILED, error);
+		return;
+	}
+
+	// 지수 백오프 - 그 호스트 전체도 같은 시간만큼 쉬게 해서 서버 쪽 제한(429 등)을 더 두드리지 않음
+	std::chrono::milliseconds backoff(RETRY_BACKOFF_MS << (job->attempts - 1));
+	job->notBefore = now + backoff;
+	Clock::time_point& hostNext = mHostNextStart[job->host];
+	hostNext = std::max(hostNext, job->notBefore);
+	mRetries++;
+
+	LOG(LogWarning) << "ScraperBatch: \"" << Utils::FileSystem::getFileName(job->params.game->getPath()) << "\" failed (" << error
+		<< "), retry " << job->attempts << "/" << (MAX_ATTEMPTS - 1) << " in " << backoff.count() << " ms";
+
+	mActive.erase(std::find(mActive.begin(), mActive.end(), job));
+	mPending.push_back(job);
+}
+
+void ScraperBatch::finishJob(Job* job, Outcome outcome, const std::string& message)
+{
+	switch (outcome)
+	{
+		case SCRAPED: mScraped++; break;
+		case SKIPPED: mSkipped++; break;
+		case FAILED:  mFailed++; LOG(LogError) << "ScraperBatch: \"" << job->params.game->getPath() << "\" failed: " << message; break;
+	}
+
+	mActive.erase(std::find(mActive.begin(), mActive.end(), job));
+
+	if (mProgressFunc)
+		mProgressFunc(job->params, outcome, message);
+
+	delete job;
+
+	if (isDone())
+	{
+		long long elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - mStartTime).count();
+		LOG(LogInfo) << "ScraperBatch: done in " << elapsedMs << " ms - " << mScraped << " scraped, " << mSkipped << " skipped, "
+			<< mFailed << " failed, " << mRetries << " retries ("
+			<< (elapsedMs > 0 ? (getFinished() * 60000LL / elapsedMs) : 0) << " games/min)";
+
+		HttpReq::Stats net = HttpReq::getStats();
+		if (net.requests > 0)
+			LOG(LogInfo) << "ScraperBatch: network " << net.requests << " requests, " << (net.bytes / 1024) << " KiB, avg first byte "
+				<< (int)(net.totalFirstByteMs / net.requests) << " ms, " << (net.reusedConnections * 100 / net.requests) << "% reused connections";
+
+		ImageProcessStats images = getImageProcessStats();
+		if (images.images > 0)
+			LOG(LogInfo) << "ScraperBatch: " << images.images << " images processed (" << images.failures << " failed), avg download "
+				<< (int)(images.downloadMs / images.images) << " ms, queue " << (int)(images.queueMs / images.images) << " ms, decode "
+				<< (int)(images.decodeMs / images.images) << " ms, resize " << (int)(images.resizeMs / images.images) << " ms, encode "
+				<< (int)(images.encodeMs / images.images) << " ms, thumbnail " << (int)(images.thumbnailMs / images.images) << " ms";
+	}
+}
+
+void ScraperBatch::applyResult(Job* job, const ScraperSearchResult& result)
+{
+	FileData* game = job->params.game;
+	game->metadata = result.mdl;
+	job->params.system->getMediaIndex()->refreshFile(game);
+	game->getSourceFileData()->getSystem()->updateRecentGame(game->getSourceFileData());
+
+	mDirtySystems.insert(job->params.system);
+	if (++mUnflushed >= FLUSH_EVERY)
+		flush();
+}
+
+void ScraperBatch::flush()
+{
+	if (mDirtySystems.empty())
+		return;
+
+	for (auto system : mDirtySystems)
+		updateGamelist(system);
+	ScraperCache::getInstance()->save();
+
+	LOG(LogDebug) << "ScraperBatch: saved " << mUnflushed << " results to " << mDirtySystems.size() << " gamelist(s)";
+	mDirtySystems.clear();
+	mUnflushed = 0;
+}
+
+std::string ScraperBatch::getUrlHost(const std::string& url)
+{
+	size_t start = url.find("://");
+	start = (start == std::string::npos) ? 0 : start + 3;
+	size_t end = url.find_first_of("/?#", start);
+	return url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
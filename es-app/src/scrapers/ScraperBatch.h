@@ -0,0 +1,104 @@
+#pragma once
+#ifndef ES_APP_SCRAPERS_SCRAPER_BATCH_H
+#define ES_APP_SCRAPERS_SCRAPER_BATCH_H
+
+#include "scrapers/Scraper.h"
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <set>
+
+// RetroPangui: 여러 게임을 한 번에 스크랩하는 배치 엔진. 게임 하나씩 검색 -> 이미지 받기 -> 저장을
+// 차례로 기다리던 GuiScraperMulti/명령행 스크래퍼 대신, 최대 concurrency개의 검색/다운로드를
+// 동시에 띄워 두고(모두 HttpReq의 공용 curl multi 핸들 위에서 진행) 끝나는 대로 다음 게임을 넣는다.
+// - 호스트별 속도 제한: 같은 호스트(검색은 스크래퍼 소스, 다운로드는 이미지 URL 호스트)에는
+//   최소 간격을 두고 요청을 시작
+// - 재시도: 네트워크 오류는 지수 백오프(1s, 2s, 4s..)로 MAX_ATTEMPTS번까지, 그동안 그 호스트도 쉼
+// - 일괄 저장: gamelist.xml은 FLUSH_EVERY개마다/끝날 때 시스템별로 한 번씩만 다시 씀
+// update()를 부르는 스레드(UI 루프 또는 명령행 루프)에서만 쓴다.
+class ScraperBatch
+{
+public:
+	enum Outcome
+	{
+		SCRAPED,
+		SKIPPED,  // 검색 결과 없음 또는 선택 안 함
+		FAILED    // 재시도까지 모두 실패
+	};
+
+	// 결과 목록 중 쓸 것의 인덱스, -1이면 건너뜀. 지정 안 하면 항상 첫 결과
+	typedef std::function<int(const ScraperSearchParams&, const std::vector<ScraperSearchResult>&)> ChooseFunc;
+	// 게임 하나가 끝날 때마다. message: 성공 시 결과 이름, 실패 시 오류
+	typedef std::function<void(const ScraperSearchParams&, Outcome, const std::string& message)> ProgressFunc;
+
+	ScraperBatch(const std::queue<ScraperSearchParams>& searches, int concurrency);
+	~ScraperBatch();
+
+	inline void setChooseFunc(const ChooseFunc& func) { mChooseFunc = func; }
+	inline void setProgressFunc(const ProgressFunc& func) { mProgressFunc = func; }
+
+	void update();
+	// 진행 중인 작업을 버리고 지금까지 받은 결과만 저장
+	void cancel();
+	inline bool isDone() const { return mPending.empty() && mActive.empty(); }
+
+	inline unsigned int getTotal() const { return mTotal; }
+	inline unsigned int getFinished() const { return mScraped + mSkipped + mFailed; }
+	inline unsigned int getScraped() const { return mScraped; }
+	inline unsigned int getSkipped() const { return mSkipped; }
+	inline unsigned int getFailed() const { return mFailed; }
+
+	// Settings "ScraperConcurrency"(1..16)
+	static int getConfiguredConcurrency();
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	static const int MAX_ATTEMPTS = 3;
+	static const int SEARCH_INTERVAL_MS = 250;   // 같은 스크래퍼 소스에 검색 시작 간격
+	static const int DOWNLOAD_INTERVAL_MS = 50;  // 같은 이미지 호스트에 다운로드 시작 간격
+	static const int RETRY_BACKOFF_MS = 1000;
+	static const unsigned int FLUSH_EVERY = 50;
+
+	struct Job
+	{
+		ScraperSearchParams params;
+		std::unique_ptr<ScraperSearchHandle> search;
+		std::unique_ptr<MDResolveHandle> resolve;
+		ScraperSearchResult chosen; // 검색이 끝나고 고른 결과 - 이미지가 있으면 resolve 단계로
+		bool hasChosen;
+		int attempts;               // 현재 단계에서 실패한 횟수
+		std::string host;           // 현재 단계가 요청하는 호스트
+		Clock::time_point notBefore;
+	};
+
+	bool tryStart(Job* job, Clock::time_point now);
+	bool acquireHost(const std::string& host, int intervalMs, Clock::time_point now);
+	void onSearchDone(Job* job);
+	void retryOrFail(Job* job, const std::string& error, Clock::time_point now);
+	void finishJob(Job* job, Outcome outcome, const std::string& message);
+	void applyResult(Job* job, const ScraperSearchResult& result);
+	void flush();
+
+	static std::string getUrlHost(const std::string& url);
+
+	int mConcurrency;
+	std::deque<Job*> mPending;   // 아직 시작 안 했거나 백오프 중
+	std::vector<Job*> mActive;   // 검색/다운로드 중이거나 다음 단계 시작 대기
+	std::map<std::string, Clock::time_point> mHostNextStart;
+	std::set<SystemData*> mDirtySystems;
+	unsigned int mUnflushed;
+
+	ChooseFunc mChooseFunc;
+	ProgressFunc mProgressFunc;
+
+	unsigned int mTotal;
+	unsigned int mScraped;
+	unsigned int mSkipped;
+	unsigned int mFailed;
+	unsigned int mRetries;
+	Clock::time_point mStartTime;
+};
+
+#endif // ES_APP_SCRAPERS_SCRAPER_BATCH_H
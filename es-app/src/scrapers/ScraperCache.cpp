@@ -0,0 +1,197 @@
+#include "scrapers/ScraperCache.h"
+
+#include "scrapers/GamesDBJSONScraperResources.h"
+#include "scrapers/RomHasher.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/HashUtil.h"
+#include "FileData.h"
+#include "Log.h"
+#include "PlatformId.h"
+#include "Settings.h"
+#include "SystemData.h"
+#include <pugixml.hpp>
+#include <SDL_timer.h>
+
+ScraperCache* ScraperCache::sInstance = nullptr;
+
+ScraperCache* ScraperCache::getInstance()
+{
+	if (!sInstance)
+		sInstance = new ScraperCache();
+
+	return sInstance;
+}
+
+void ScraperCache::deinit()
+{
+	if (sInstance)
+	{
+		sInstance->save();
+		delete sInstance;
+		sInstance = nullptr;
+	}
+}
+
+ScraperCache::ScraperCache() : mHits(0), mMisses(0), mDirty(false)
+{
+	mTtl = (time_t)Settings::getInstance()->getInt("ScraperCacheDays") * 24 * 60 * 60;
+	if (mTtl > 0)
+		load();
+}
+
+std::string ScraperCache::getKey(const std::string& scraper, const ScraperSearchParams& params)
+{
+	if (Settings::getInstance()->getInt("ScraperCacheDays") <= 0)
+		return "";
+
+	std::string key = scraper + "|";
+	for (auto platform : params.system->getPlatformIds())
+		key += std::to_string((int)platform) + ",";
+
+	// 사용자가 이름을 직접 입력했으면 그 이름, 아니면 ROM 내용(해시가 있을 때) 또는 파일 이름
+	RomHash hash;
+	if (!params.nameOverride.empty())
+		key += "|name:" + params.nameOverride;
+	else if (RomHasher::getInstance()->getHash(params.game, hash))
+		key += "|crc:" + Utils::Hash::crc32ToHex(hash.crc32) + ":" + std::to_string(hash.size);
+	else
+		key += "|file:" + Utils::FileSystem::getFileName(params.game->getPath());
+
+	return key;
+}
+
+bool ScraperCache::isFresh(const Entry& entry, time_t now) const
+{
+	return now - entry.stored < (entry.results.empty() ? std::min(mTtl, (time_t)NEGATIVE_TTL_SECONDS) : mTtl);
+}
+
+bool ScraperCache::has(const std::string& key)
+{
+	if (key.empty())
+		return false;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto it = mEntries.find(key);
+	return it != mEntries.end() && isFresh(it->second, time(NULL));
+}
+
+bool ScraperCache::find(const std::string& key, std::vector<ScraperSearchResult>& results)
+{
+	if (key.empty())
+		return false;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto it = mEntries.find(key);
+	if (it == mEntries.end() || !isFresh(it->second, time(NULL)))
+	{
+		mMisses++;
+		return false;
+	}
+
+	mHits++;
+	results = it->second.results;
+	LOG(LogDebug) << "ScraperCache: hit \"" << key << "\" (" << results.size() << " results, " << mHits << " hits / " << mMisses << " misses)";
+	return true;
+}
+
+void ScraperCache::store(const std::string& key, const std::vector<ScraperSearchResult>& results)
+{
+	if (key.empty())
+		return;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	Entry& entry = mEntries[key];
+	entry.stored = time(NULL);
+	entry.results = results;
+	mDirty = true;
+}
+
+std::string ScraperCache::getCachePath() const
+{
+	return getScrapersResouceDir() + "/search_cache.xml";
+}
+
+void ScraperCache::load()
+{
+	const std::string path = getCachePath();
+	if (!Utils::FileSystem::exists(path))
+		return;
+
+	const unsigned int start = SDL_GetTicks();
+	pugi::xml_document doc;
+	pugi::xml_parse_result result = doc.load_file(path.c_str());
+	if (!result)
+	{
+		LOG(LogWarning) << "ScraperCache: 파싱 실패 (" << path << ") - " << result.description();
+		return;
+	}
+
+	const time_t now = time(NULL);
+	size_t expired = 0;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	for (pugi::xml_node entryNode = doc.child("scraperCache").child("search"); entryNode; entryNode = entryNode.next_sibling("search"))
+	{
+		Entry entry;
+		entry.stored = (time_t)entryNode.attribute("time").as_llong();
+		for (pugi::xml_node resultNode = entryNode.child("result"); resultNode; resultNode = resultNode.next_sibling("result"))
+		{
+			ScraperSearchResult result;
+			pugi::xml_node gameNode = resultNode.child("game");
+			result.mdl = MetaDataList::createFromXML(GAME_METADATA, gameNode, "");
+			result.imageUrl = resultNode.attribute("imageUrl").as_string();
+			result.thumbnailUrl = resultNode.attribute("thumbnailUrl").as_string();
+			result.imageType = resultNode.attribute("imageType").as_string();
+			entry.results.push_back(result);
+		}
+
+		// 만료된 항목은 읽을 때 버려서 파일이 끝없이 커지지 않게
+		if (!isFresh(entry, now))
+		{
+			expired++;
+			mDirty = true;
+			continue;
+		}
+		mEntries[entryNode.attribute("key").as_string()] = entry;
+	}
+
+	LOG(LogDebug) << "ScraperCache: " << mEntries.size() << "개 로드, " << expired << "개 만료 (" << SDL_GetTicks() - start << "ms)";
+}
+
+void ScraperCache::save()
+{
+	pugi::xml_document doc;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (!mDirty)
+			return;
+		mDirty = false;
+
+		pugi::xml_node root = doc.append_child("scraperCache");
+		for (auto it = mEntries.cbegin(); it != mEntries.cend(); ++it)
+		{
+			pugi::xml_node entryNode = root.append_child("search");
+			entryNode.append_attribute("key").set_value(it->first.c_str());
+			entryNode.append_attribute("time").set_value((long long)it->second.stored);
+			for (auto& result : it->second.results)
+			{
+				pugi::xml_node resultNode = entryNode.append_child("result");
+				if (!result.imageUrl.empty())
+					resultNode.append_attribute("imageUrl").set_value(result.imageUrl.c_str());
+				if (!result.thumbnailUrl.empty())
+					resultNode.append_attribute("thumbnailUrl").set_value(result.thumbnailUrl.c_str());
+				if (!result.imageType.empty())
+					resultNode.append_attribute("imageType").set_value(result.imageType.c_str());
+				pugi::xml_node gameNode = resultNode.append_child("game");
+				result.mdl.appendToXML(gameNode, true, "");
+			}
+		}
+	}
+
+	const std::string dir = getScrapersResouceDir();
+	if (!Utils::FileSystem::exists(dir))
+		Utils::FileSystem::createDirectory(dir);
+
+	if (!doc.save_file(getCachePath().c_str()))
+		LOG(LogWarning) << "ScraperCache: 저장 실패 - " << getCachePath();
+}
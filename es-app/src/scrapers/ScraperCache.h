@@ -0,0 +1,58 @@
+#pragma once
+#ifndef ES_APP_SCRAPERS_SCRAPER_CACHE_H
+#define ES_APP_SCRAPERS_SCRAPER_CACHE_H
+
+#include "scrapers/Scraper.h"
+#include <ctime>
+#include <mutex>
+#include <unordered_map>
+
+// RetroPangui: 스크래퍼 검색 결과 디스크 캐시. 같은 게임을 다시 스크랩할 때마다 ScreenScraper/
+// TheGamesDB에 같은 질의를 보내지 않도록, 검색 결과(메타데이터 + 이미지 URL)를
+// (스크래퍼, 플랫폼, ROM CRC/크기 또는 이름) 키로 ~/.emulationstation/scrapers/search_cache.xml에 둔다.
+// - 유효 기간: Settings "ScraperCacheDays"(0이면 캐시 안 씀), 결과가 없던 검색은 하루만
+// - 처음 쓸 때 한 번 읽어 메모리 해시 맵으로 들고 있고, 저장은 save()를 부를 때만
+//   (배치 스크래퍼가 gamelist를 저장할 때, 종료할 때)
+// 검색 핸들(UI 스레드)과 배치 스크래퍼가 같은 스레드에서 쓰지만 저장만 따로 불릴 수 있어 잠금을 잡는다.
+class ScraperCache
+{
+public:
+	static ScraperCache* getInstance();
+	// 쓴 적이 있으면 저장하고 해제 - 종료할 때
+	static void deinit();
+
+	// 캐시를 안 쓰는 설정이면 빈 문자열
+	static std::string getKey(const std::string& scraper, const ScraperSearchParams& params);
+
+	bool has(const std::string& key);
+	bool find(const std::string& key, std::vector<ScraperSearchResult>& results);
+	void store(const std::string& key, const std::vector<ScraperSearchResult>& results);
+
+	void save();
+
+private:
+	static const int NEGATIVE_TTL_SECONDS = 24 * 60 * 60;
+
+	struct Entry
+	{
+		time_t stored;
+		std::vector<ScraperSearchResult> results;
+	};
+
+	ScraperCache();
+
+	static ScraperCache* sInstance;
+
+	bool isFresh(const Entry& entry, time_t now) const;
+	void load();
+	std::string getCachePath() const;
+
+	std::mutex mMutex;
+	std::unordered_map<std::string, Entry> mEntries;
+	time_t mTtl;
+	unsigned int mHits;
+	unsigned int mMisses;
+	bool mDirty;
+};
+
+#endif // ES_APP_SCRAPERS_SCRAPER_CACHE_H
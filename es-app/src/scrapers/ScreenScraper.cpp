@@ -1,5 +1,7 @@
 #include "scrapers/ScreenScraper.h"
 
+#include "scrapers/RomHasher.h"
+#include "utils/HashUtil.h"
 #include "utils/TimeUtil.h"
 #include "utils/StringUtil.h"
 #include "FileData.h"
@@ -148,6 +150,16 @@ void screenscraper_generate_scraper_requests(const ScraperSearchParams& params,
 	// Check if the user has overridden the file name
 	path = ssConfig.getGameSearchUrl(params.nameOverride.empty() ? params.game->getFileName() : params.nameOverride);
 
+	// RetroPangui: ROM 해시가 이미 계산돼 있으면 체크섬도 보내서 파일 이름이 데이터베이스와 달라도 찾게 한다
+	// (이름을 직접 입력한 검색은 그 이름만으로)
+	RomHash hash;
+	if (params.nameOverride.empty() && RomHasher::getInstance()->getHash(params.game, hash))
+	{
+		path += "&crc=" + Utils::Hash::crc32ToHex(hash.crc32);
+		path += "&md5=" + hash.md5;
+		path += "&romtaille=" + std::to_string(hash.size);
+	}
+
 	auto& platforms = params.system->getPlatformIds();
 	std::vector<unsigned short> p_ids;
 
@@ -360,7 +372,7 @@ void ScreenScraperRequest::processList(const pugi::xml_document& xmldoc, std::ve
 
 std::string ScreenScraperRequest::ScreenScraperConfig::getGameSearchUrl(const std::string gameName) const
 {
-	return API_URL_BASE
+	return getScraperApiUrl(API_URL_BASE)
 		+ "/jeuInfos.php?devid=" + Utils::String::scramble(API_DEV_U, API_DEV_KEY)
 		+ "&devpassword=" + Utils::String::scramble(API_DEV_P, API_DEV_KEY)
 		+ "&softname=" + HttpReq::urlEncode(API_SOFT_NAME)
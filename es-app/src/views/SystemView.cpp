@@ -9,6 +9,7 @@
 #include "guis/GuiMsgBox.h"
 #include "views/UIModeController.h"
 #include "views/ViewController.h"
+#include "FileFilterIndex.h"
 #include "LocaleES.h"
 #include "Log.h"
 #include "MusicManager.h"
@@ -16,7 +17,6 @@
 #include "Settings.h"
 #include "SystemData.h"
 #include "Window.h"
-#include "utils/FileSystemUtil.h"
 #include <ctime>
 
 // buffer values for scrolling velocity (left, stopped, right)
@@ -34,7 +34,10 @@ SystemView::SystemView(Window* window) : IList<SystemViewData, SystemData*>(wind
 	mCamOffset = 0;
 	mExtrasCamOffset = 0;
 	mExtrasFadeOpacity = 0.0f;
-	mClockAccumulator = 0;
+	mExtraTasksDirty = true;
+	mRecentCardsSystem = nullptr;
+	mRecentCardsVersion = 0;
+	mRecentCardsDirty = true;
 
 	setSize((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
 	populate();
@@ -43,6 +46,9 @@ SystemView::SystemView(Window* window) : IList<SystemViewData, SystemData*>(wind
 void SystemView::populate()
 {
 	mEntries.clear();
+	// extras를 새로 만들므로 이름 있는 extra들도 바로 다시 채움
+	mRecentCardsDirty = true;
+	mExtraTasksDirty = true;
 
 	for(auto it = SystemData::sSystemVector.cbegin(); it != SystemData::sSystemVector.cend(); it++)
 	{
@@ -61,8 +67,8 @@ void SystemView::populate()
 			const ThemeData::ThemeElement* logoElem = theme->getElement("system", "logo", "image");
 			if(logoElem)
 			{
-				std::string path = logoElem->get<std::string>("path");
-				std::string defaultPath = logoElem->has("default") ? logoElem->get<std::string>("default") : "";
+				std::string path = logoElem->get<std::string>(ThemeProperty::PATH);
+				std::string defaultPath = logoElem->has(ThemeProperty::DEFAULT) ? logoElem->get<std::string>(ThemeProperty::DEFAULT) : "";
 				if((!path.empty() && ResourceManager::getInstance()->fileExists(path))
 				   || (!defaultPath.empty() && ResourceManager::getInstance()->fileExists(defaultPath)))
 				{
@@ -118,17 +124,15 @@ void SystemView::populate()
 			for (auto extra : e.data.backgroundExtras)
 				delete extra;
 			e.data.backgroundExtras.clear();
-			e.data.namedExtras.clear();
 
 			// make background extras
-			// RetroPangui: RECENTLY PLAYED 카드(rp-card-N)처럼 이름으로 다시 찾아야 하는
-			// extra가 생겨서 이름도 같이 보관(namedExtras) - backgroundExtras는 기존처럼
-			// z-index 정렬/렌더/삭제용 GuiComponent* 목록 그대로 유지.
-			for (auto& kv : ThemeData::makeExtras((*it)->getTheme(), "system", mWindow))
-			{
+			// RetroPangui: ES가 값을 채우는 extra(rp-card-N, bgmTitle 등)는 여기서 한 번만
+			// 이름으로 찾아 핸들로 보관 - backgroundExtras는 기존처럼 z-index 정렬/렌더/삭제용
+			// GuiComponent* 목록 그대로 유지.
+			std::vector<std::pair<std::string, GuiComponent*>> extras = ThemeData::makeExtras((*it)->getTheme(), "system", mWindow);
+			for (auto& kv : extras)
 				e.data.backgroundExtras.push_back(kv.second);
-				e.data.namedExtras.push_back(kv);
-			}
+			resolveNamedExtras(e.data, extras, theme);
 
 			// sort the extras by z-index
 			std::stable_sort(e.data.backgroundExtras.begin(), e.data.backgroundExtras.end(),  [](GuiComponent* a, GuiComponent* b) {
@@ -168,17 +172,18 @@ bool SystemView::input(InputConfig* config, Input input)
 			return true;
 		}
 
+		const unsigned int actions = config->getActions(input);
 		switch (mCarousel.type)
 		{
 		case VERTICAL:
 		case VERTICAL_WHEEL:
-			if (config->isMappedLike("up", input))
+			if (actions & ACTION_UP)
 			{
 				InputManager::getInstance()->rumbleNav(config->getDeviceId());
 				listInput(-1);
 				return true;
 			}
-			if (config->isMappedLike("down", input))
+			if (actions & ACTION_DOWN)
 			{
 				InputManager::getInstance()->rumbleNav(config->getDeviceId());
 				listInput(1);
@@ -188,13 +193,13 @@ bool SystemView::input(InputConfig* config, Input input)
 		case HORIZONTAL:
 		case HORIZONTAL_WHEEL:
 		default:
-			if (config->isMappedLike("left", input))
+			if (actions & ACTION_LEFT)
 			{
 				InputManager::getInstance()->rumbleNav(config->getDeviceId());
 				listInput(-1);
 				return true;
 			}
-			if (config->isMappedLike("right", input))
+			if (actions & ACTION_RIGHT)
 			{
 				InputManager::getInstance()->rumbleNav(config->getDeviceId());
 				listInput(1);
@@ -203,7 +208,7 @@ bool SystemView::input(InputConfig* config, Input input)
 			break;
 		}
 
-		if(config->isMappedToAction("accept", input))
+		if(actions & ACTION_ACCEPT)
 		{
 			// RetroPangui: 시스템 선택 진동 - ComponentList(메뉴)엔 있는데
 			// 여기(시스템→게임목록 진입)엔 원래 호출이 빠져있었음(2026-07-24
@@ -221,10 +226,7 @@ bool SystemView::input(InputConfig* config, Input input)
 			return true;
 		}
 	}else{
-		if(config->isMappedLike("left", input) ||
-			config->isMappedLike("right", input) ||
-			config->isMappedLike("up", input) ||
-			config->isMappedLike("down", input))
+		if(config->isAction(input, ACTION_DIRECTIONS))
 			listInput(0);
 		Scripting::fireEvent("system-select", this->IList::getSelected()->getName(), "input");
 		if(!UIModeController::getInstance()->isUIModeKid() && config->isMappedTo("select", input) && Settings::getInstance()->getBool("ScreenSaverControls"))
@@ -247,54 +249,127 @@ void SystemView::update(int deltaTime)
 	{
 		for(auto extra : mEntries.at(mCursor).data.backgroundExtras)
 			extra->update(deltaTime);
-		updateRecentlyPlayed(mEntries.at(mCursor).data, mEntries.at(mCursor).object);
-		updateBgmTitle(mEntries.at(mCursor).data);
-		updateClock(mEntries.at(mCursor).data, deltaTime);
+		runExtraTasks(deltaTime);
 	}
 	GuiComponent::update(deltaTime);
 }
 
+const SystemView::ExtraTask SystemView::sExtraTasks[] =
+{
+	{ EXTRA_EVERY_SECOND,     "bgmTitle",   &SystemView::updateBgmTitle },
+	{ EXTRA_EVERY_SECOND,     "clock-time", &SystemView::updateClock },
+	{ EXTRA_ON_CURSOR_CHANGE, nullptr,      &SystemView::updateRecentlyPlayed },
+};
+
+// RetroPangui: 이번 프레임에 주기가 돌아온 extra 작업만 실행. 커서 이동/화면 표시/populate()
+// 직후(mExtraTasksDirty)에는 주기와 상관없이 전부 한 번 실행한다.
+void SystemView::runExtraTasks(int deltaTime)
+{
+	static const size_t TASK_COUNT = sizeof(sExtraTasks) / sizeof(sExtraTasks[0]);
+
+	bool all = mExtraTasksDirty;
+	mExtraTasksDirty = false;
+	mExtraTaskElapsed.resize(TASK_COUNT, 0);
+
+	SystemViewData& data = mEntries.at(mCursor).data;
+	SystemData* system = mEntries.at(mCursor).object;
+	for (size_t i = 0; i < TASK_COUNT; i++)
+	{
+		const ExtraTask& task = sExtraTasks[i];
+
+		// 테마 값 우선, 없으면 표의 주기 (-1: 주기 없음, 커서 이동 등으로 all일 때만)
+		int interval = i < data.extraTaskIntervals.size() ? data.extraTaskIntervals[i] : -1;
+		if (interval < 0)
+		{
+			switch (task.cadence)
+			{
+				case EXTRA_EVERY_FRAME:      interval = 0; break;
+				case EXTRA_EVERY_SECOND:     interval = 1000; break;
+				case EXTRA_ON_CURSOR_CHANGE: interval = -1; break;
+			}
+		}
+
+		mExtraTaskElapsed[i] += deltaTime;
+		if (all || interval == 0 || (interval > 0 && mExtraTaskElapsed[i] >= interval))
+		{
+			mExtraTaskElapsed[i] = 0;
+			(this->*task.run)(data, system);
+		}
+	}
+}
+
 // RetroPangui: RECENTLY PLAYED 카드(rp-card-1..N, 테마 쪽 이름 있는 extra)에 최근 플레이한
 // 게임의 썸네일/이름을 채워줌 - 몇 장을 보여줄지/배치/스타일은 테마(retropangui-slate)
 // 책임이고, ES는 데이터(경로/이름)만 이름으로 조회 가능한 extra에 넘겨줌(bgmTitle과 동일 원칙).
 // 이름 있는 extra를 못 찾으면(테마가 아직 rp-card-N을 안 뒀으면) 조용히 스킵.
-static GuiComponent* findNamedExtra(SystemViewData& data, const std::string& name)
+static GuiComponent* findNamedExtra(const std::vector<std::pair<std::string, GuiComponent*>>& extras, const std::string& name)
 {
-	for (auto& kv : data.namedExtras)
+	for (auto& kv : extras)
 		if (kv.first == name)
 			return kv.second;
 	return nullptr;
 }
 
+void SystemView::resolveNamedExtras(SystemViewData& data, const std::vector<std::pair<std::string, GuiComponent*>>& extras, const std::shared_ptr<ThemeData>& theme)
+{
+	// 테마(retropangui-slate)의 rp-card-1..6(디자인 목업 System View.png 기준 6장)에 맞춤
+	// - 카드 수가 바뀌면 여기 숫자도 같이 조정
+	static const int MAX_RECENT_CARDS = 6;
+
+	data.bgmTitle = findNamedExtra(extras, "bgmTitle");
+	data.clockTime = findNamedExtra(extras, "clock-time");
+	data.clockDate = findNamedExtra(extras, "clock-date");
+
+	data.recentCards.clear();
+	for (int i = 0; i < MAX_RECENT_CARDS; ++i)
+	{
+		std::string cardName = "rp-card-" + std::to_string(i + 1);
+		SystemViewData::RecentCard card;
+		card.image = dynamic_cast<ImageComponent*>(findNamedExtra(extras, cardName));
+		card.name = findNamedExtra(extras, cardName + "-name");
+		card.shadow = findNamedExtra(extras, cardName + "-shadow");
+		data.recentCards.push_back(card);
+	}
+
+	data.extraTaskIntervals.clear();
+	for (const ExtraTask& task : sExtraTasks)
+	{
+		int interval = -1;
+		if (task.extra != nullptr && theme)
+		{
+			const ThemeData::ThemeElement* elem = theme->getElement("system", task.extra, "");
+			if (elem != nullptr && elem->has(ThemeProperty::UPDATE_INTERVAL))
+				interval = std::max(0, (int)elem->get<float>(ThemeProperty::UPDATE_INTERVAL));
+		}
+		data.extraTaskIntervals.push_back(interval);
+	}
+}
+
 // RetroPangui: 하단 푸터 우측 bgmTitle 텍스트에 현재 재생 트랙 제목 반영
 // (2026-07-06, 게임리스트 사이드바에서 메인 화면 푸터로 이동 - 게임리스트에선
 // 더 이상 표시 안 함, ES는 값만 넘겨주고 표시 위치/스타일은 테마 책임 원칙 동일)
-void SystemView::updateBgmTitle(SystemViewData& data)
+void SystemView::updateBgmTitle(SystemViewData& data, SystemData* /*system*/)
 {
-	GuiComponent* bgmTitleExtra = findNamedExtra(data, "bgmTitle");
-	if (bgmTitleExtra == nullptr)
+	if (data.bgmTitle == nullptr)
 		return;
 
 	auto& music = MusicManager::getInstance();
 	std::string title = music->isPlaying() ? music->getCurrentTrackTitle() : "";
-	bgmTitleExtra->setValue(title);
+	// setValue()는 텍스트 캐시를 다시 만드므로 제목이 바뀌었을 때만
+	if (data.bgmTitle->getValue() != title)
+		data.bgmTitle->setValue(title);
 }
 
 // RetroPangui: 메인 화면 우측 상단 시계(clock-time/clock-date, 테마 쪽 이름 있는 extra) -
 // 요일 이름은 대상 기기에 ko_KR 로케일이 없어 strftime("%A")로는 로케일화가 안 되므로
 // 직접 배열로 관리하고 _()로 번역함(2026-07-23).
-void SystemView::updateClock(SystemViewData& data, int deltaTime)
+void SystemView::updateClock(SystemViewData& data, SystemData* /*system*/)
 {
-	GuiComponent* clockTimeExtra = findNamedExtra(data, "clock-time");
-	GuiComponent* clockDateExtra = findNamedExtra(data, "clock-date");
+	GuiComponent* clockTimeExtra = data.clockTime;
+	GuiComponent* clockDateExtra = data.clockDate;
 	if (clockTimeExtra == nullptr && clockDateExtra == nullptr)
 		return;
 
-	mClockAccumulator += deltaTime;
-	if (mClockAccumulator < 1000)
-		return;
-	mClockAccumulator = 0;
-
 	time_t now = time(nullptr);
 	tm localNow;
 	localtime_r(&now, &localNow);
@@ -335,10 +410,22 @@ void SystemView::updateClock(SystemViewData& data, int deltaTime)
 
 void SystemView::updateRecentlyPlayed(SystemViewData& data, SystemData* system)
 {
-	// 테마(retropangui-slate)의 rp-card-1..6(디자인 목업 System View.png 기준 6장)에 맞춤
-	// - 카드 수가 바뀌면 여기 숫자도 같이 조정
-	static const int MAX_RECENT_CARDS = 6;
+	const int MAX_RECENT_CARDS = (int)data.recentCards.size();
 
+	// RetroPangui: 시스템별 최근 플레이 인덱스(SystemData::getRecentGames())가 게임 실행/메타데이터
+	// 저장 때만 바뀌고 버전을 올리므로, 같은 시스템에 버전도 그대로면 바로 끝냄. 예전엔 매 프레임
+	// "recent" 컬렉션 전체를 getFilesRecursive()로 훑고 썸네일마다 exists()를 불렀음.
+	if (!mRecentCardsDirty && system == mRecentCardsSystem &&
+		(system == nullptr || system->getRecentGamesVersion() == mRecentCardsVersion))
+		return;
+	mRecentCardsDirty = false;
+	mRecentCardsSystem = system;
+	mRecentCardsVersion = system != nullptr ? system->getRecentGamesVersion() : 0;
+
+	// 2026-07-06: 지금 보고 있는 시스템 소속 게임만 보여줌("모든 시스템에 동일하게
+	// 나타난다" 피드백) - 이제 인덱스 자체가 시스템별이라 따로 거를 필요 없음.
+	// "recent" 컬렉션이 꺼져 있으면 카드도 비우고, 켜져 있으면 그 컬렉션에 걸린
+	// 필터(키즈 모드 등)를 그대로 적용해 목록 화면과 같은 게임만 보여줌.
 	SystemData* recentSystem = nullptr;
 	for (auto sys : SystemData::sSystemVector)
 	{
@@ -349,46 +436,30 @@ void SystemView::updateRecentlyPlayed(SystemViewData& data, SystemData* system)
 		}
 	}
 
-	// 2026-07-06: "recent"는 전체 시스템을 합친 자동 컬렉션이라 필터링 없이 쓰면
-	// 지금 보고 있는 시스템과 무관하게 항상 똑같은 목록이 보임("모든 시스템에
-	// 동일하게 나타난다" 피드백으로 발견) - 컬렉션 안의 각 항목은 원본 게임을
-	// 감싸는 래퍼(CollectionFileData)라 getSourceFileData()로 원래 게임을 찾아
-	// 그 게임이 지금 보고 있는 시스템 소속인 것만 남김.
-	std::vector<FileData*> games;
+	std::vector<const SystemData::RecentGame*> games;
 	if (recentSystem != nullptr && system != nullptr)
 	{
-		std::vector<FileData*> allRecent = recentSystem->getRootFolder()->getFilesRecursive(GAME, true);
-		for (FileData* game : allRecent)
+		FileFilterIndex* idx = recentSystem->getIndex();
+		const std::vector<SystemData::RecentGame>& recentGames = system->getRecentGames();
+		for (auto it = recentGames.cbegin(); it != recentGames.cend() && (int)games.size() < MAX_RECENT_CARDS; ++it)
 		{
-			if (game->getSourceFileData()->getSystem() == system)
-				games.push_back(game);
+			if (!idx->isFiltered() || idx->showFile(it->game))
+				games.push_back(&(*it));
 		}
-		if ((int)games.size() > MAX_RECENT_CARDS)
-			games.resize(MAX_RECENT_CARDS);
 	}
 
-	// RetroPangui: update()가 매 프레임 호출하므로 위 스캔 자체는 어쩔 수 없이 매번
-	// 돌지만, 그 결과가 지난 프레임과 똑같으면 아래 setImage()/setVisible() 호출은
-	// 건너뜀 - 썸네일이 없는 카드(예: 롬이 1개뿐인 시스템)에서 매 프레임 이미지 없는
-	// setImage("")가 반복 호출되며 깜빡이던 문제 수정(2026-07-18).
-	static SystemData* sLastSystem = nullptr;
-	static std::vector<FileData*> sLastGames;
-	if (system == sLastSystem && games == sLastGames)
-		return;
-	sLastSystem = system;
-	sLastGames = games;
-
 	// 최근 플레이한 게임 수만큼만 카드를 보여줌 - 빈 슬롯을 놔두지 않고 아예 숨김
 	for (int i = 0; i < MAX_RECENT_CARDS; ++i)
 	{
 		bool hasGame = i < (int)games.size();
 		// RetroPangui: 플레이는 했지만 썸네일이 없는 게임(예: 롬이 1개뿐인 시스템)은
 		// 플레이스홀더를 보여주는 대신 카드 자체를 아예 숨김 - 사용자 확인(2026-07-18).
-		std::string thumbnailPath = hasGame ? games[i]->getThumbnailPath() : "";
-		bool hasThumbnail = hasGame && !thumbnailPath.empty() && Utils::FileSystem::exists(thumbnailPath);
-		std::string cardName = "rp-card-" + std::to_string(i + 1);
+		// 썸네일 존재 여부는 인덱스가 처음 읽힐 때 한 번만 확인해 둠
+		const std::string thumbnailPath = hasGame ? games[i]->thumbnail : "";
+		bool hasThumbnail = !thumbnailPath.empty();
+		const SystemViewData::RecentCard& card = data.recentCards[i];
 
-		if (auto img = dynamic_cast<ImageComponent*>(findNamedExtra(data, cardName)))
+		if (auto img = card.image)
 		{
 			img->setVisible(hasThumbnail);
 			if (hasThumbnail)
@@ -396,16 +467,16 @@ void SystemView::updateRecentlyPlayed(SystemViewData& data, SystemData* system)
 		}
 
 		// 테마가 카드별 이름 텍스트(예: rp-card-1-name)를 아직 안 뒀으면 nullptr - 안전하게 스킵
-		if (auto nameExtra = findNamedExtra(data, cardName + "-name"))
+		if (auto nameExtra = card.name)
 		{
 			nameExtra->setVisible(hasThumbnail);
 			if (hasThumbnail)
-				nameExtra->setValue(games[i]->getDisplayName());
+				nameExtra->setValue(games[i]->game->getDisplayName());
 		}
 
 		// 테마가 카드별 그림자(예: rp-card-1-shadow)를 뒀으면 카드와 동일하게 보임/숨김
 		// 처리 - 안 뒀으면 nullptr이라 안전하게 스킵.
-		if (auto shadowExtra = findNamedExtra(data, cardName + "-shadow"))
+		if (auto shadowExtra = card.shadow)
 			shadowExtra->setVisible(hasThumbnail);
 	}
 	// 플레이 이력이 하나도 없어도 rp-header("RECENTLY PLAYED" 제목)는 그대로 둠 -
@@ -417,6 +488,9 @@ void SystemView::onCursorChanged(const CursorState& /*state*/)
 	// update help style
 	updateHelpPrompts();
 
+	// RetroPangui: 도착한 시스템의 이름 있는 extra는 다음 update()에서 바로 채움
+	mExtraTasksDirty = true;
+
 	// RetroPangui: 도착한 시스템의 scrollable text extra는 처음부터 다시 스크롤
 	if(mCursor >= 0 && mCursor < (int)mEntries.size())
 	{
@@ -873,53 +947,53 @@ void  SystemView::getDefaultElements(void)
 
 void SystemView::getCarouselFromTheme(const ThemeData::ThemeElement* elem)
 {
-	if (elem->has("type"))
+	if (elem->has(ThemeProperty::TYPE))
 	{
-		if (!(elem->get<std::string>("type").compare("vertical")))
+		if (!(elem->get<std::string>(ThemeProperty::TYPE).compare("vertical")))
 			mCarousel.type = VERTICAL;
-		else if (!(elem->get<std::string>("type").compare("vertical_wheel")))
+		else if (!(elem->get<std::string>(ThemeProperty::TYPE).compare("vertical_wheel")))
 			mCarousel.type = VERTICAL_WHEEL;
-		else if (!(elem->get<std::string>("type").compare("horizontal_wheel")))
+		else if (!(elem->get<std::string>(ThemeProperty::TYPE).compare("horizontal_wheel")))
 			mCarousel.type = HORIZONTAL_WHEEL;
 		else
 			mCarousel.type = HORIZONTAL;
 	}
-	if (elem->has("size"))
-		mCarousel.size = elem->get<Vector2f>("size") * mSize;
-	if (elem->has("pos"))
-		mCarousel.pos = elem->get<Vector2f>("pos") * mSize;
-	if (elem->has("origin"))
-		mCarousel.origin = elem->get<Vector2f>("origin");
-	if (elem->has("color"))
+	if (elem->has(ThemeProperty::SIZE))
+		mCarousel.size = elem->get<Vector2f>(ThemeProperty::SIZE) * mSize;
+	if (elem->has(ThemeProperty::POS))
+		mCarousel.pos = elem->get<Vector2f>(ThemeProperty::POS) * mSize;
+	if (elem->has(ThemeProperty::ORIGIN))
+		mCarousel.origin = elem->get<Vector2f>(ThemeProperty::ORIGIN);
+	if (elem->has(ThemeProperty::COLOR))
 	{
-		mCarousel.color = elem->get<unsigned int>("color");
+		mCarousel.color = elem->get<unsigned int>(ThemeProperty::COLOR);
 		mCarousel.colorEnd = mCarousel.color;
 	}
-	if (elem->has("colorEnd"))
-		mCarousel.colorEnd = elem->get<unsigned int>("colorEnd");
-	if (elem->has("gradientType"))
-		mCarousel.colorGradientHorizontal = !(elem->get<std::string>("gradientType").compare("horizontal"));
-	if (elem->has("logoScale"))
-		mCarousel.logoScale = elem->get<float>("logoScale");
-	if (elem->has("logoSize"))
-		mCarousel.logoSize = elem->get<Vector2f>("logoSize") * mSize;
-	if (elem->has("maxLogoCount"))
-		mCarousel.maxLogoCount = (int)Math::round(elem->get<float>("maxLogoCount"));
-	if (elem->has("zIndex"))
-		mCarousel.zIndex = elem->get<float>("zIndex");
-	if (elem->has("logoRotation"))
-		mCarousel.logoRotation = elem->get<float>("logoRotation");
-	if (elem->has("logoRotationOrigin"))
-		mCarousel.logoRotationOrigin = elem->get<Vector2f>("logoRotationOrigin");
-	if (elem->has("logoAlignment"))
+	if (elem->has(ThemeProperty::COLOR_END))
+		mCarousel.colorEnd = elem->get<unsigned int>(ThemeProperty::COLOR_END);
+	if (elem->has(ThemeProperty::GRADIENT_TYPE))
+		mCarousel.colorGradientHorizontal = !(elem->get<std::string>(ThemeProperty::GRADIENT_TYPE).compare("horizontal"));
+	if (elem->has(ThemeProperty::LOGO_SCALE))
+		mCarousel.logoScale = elem->get<float>(ThemeProperty::LOGO_SCALE);
+	if (elem->has(ThemeProperty::LOGO_SIZE))
+		mCarousel.logoSize = elem->get<Vector2f>(ThemeProperty::LOGO_SIZE) * mSize;
+	if (elem->has(ThemeProperty::MAX_LOGO_COUNT))
+		mCarousel.maxLogoCount = (int)Math::round(elem->get<float>(ThemeProperty::MAX_LOGO_COUNT));
+	if (elem->has(ThemeProperty::Z_INDEX))
+		mCarousel.zIndex = elem->get<float>(ThemeProperty::Z_INDEX);
+	if (elem->has(ThemeProperty::LOGO_ROTATION))
+		mCarousel.logoRotation = elem->get<float>(ThemeProperty::LOGO_ROTATION);
+	if (elem->has(ThemeProperty::LOGO_ROTATION_ORIGIN))
+		mCarousel.logoRotationOrigin = elem->get<Vector2f>(ThemeProperty::LOGO_ROTATION_ORIGIN);
+	if (elem->has(ThemeProperty::LOGO_ALIGNMENT))
 	{
-		if (!(elem->get<std::string>("logoAlignment").compare("left")))
+		if (!(elem->get<std::string>(ThemeProperty::LOGO_ALIGNMENT).compare("left")))
 			mCarousel.logoAlignment = ALIGN_LEFT;
-		else if (!(elem->get<std::string>("logoAlignment").compare("right")))
+		else if (!(elem->get<std::string>(ThemeProperty::LOGO_ALIGNMENT).compare("right")))
 			mCarousel.logoAlignment = ALIGN_RIGHT;
-		else if (!(elem->get<std::string>("logoAlignment").compare("top")))
+		else if (!(elem->get<std::string>(ThemeProperty::LOGO_ALIGNMENT).compare("top")))
 			mCarousel.logoAlignment = ALIGN_TOP;
-		else if (!(elem->get<std::string>("logoAlignment").compare("bottom")))
+		else if (!(elem->get<std::string>(ThemeProperty::LOGO_ALIGNMENT).compare("bottom")))
 			mCarousel.logoAlignment = ALIGN_BOTTOM;
 		else
 			mCarousel.logoAlignment = ALIGN_CENTER;
@@ -929,6 +1003,9 @@ void SystemView::getCarouselFromTheme(const ThemeData::ThemeElement* elem)
 void SystemView::onShow()
 {
 	mShowing = true;
+	// 게임 목록에서 게임을 실행했거나 필터를 바꾸고 돌아왔을 수 있음 - 카드의 표시 대상 다시 확인
+	mRecentCardsDirty = true;
+	mExtraTasksDirty = true;
 }
 
 void SystemView::onHide()
@@ -10,6 +10,7 @@
 
 class AnimatedImageComponent;
 class FileData;
+class ImageComponent;
 class SystemData;
 
 enum CarouselType : unsigned int
@@ -25,10 +26,22 @@ struct SystemViewData
 	std::shared_ptr<GuiComponent> logo;
 	std::vector<GuiComponent*> backgroundExtras;
 
-	// RetroPangui: RECENTLY PLAYED 카드(rp-card-N)처럼 이름으로 찾아서 값을 갱신해야
-	// 하는 extra만 별도 보관 - backgroundExtras와 같은 포인터를 가리키므로 소유권/삭제는
-	// backgroundExtras 쪽에서만 수행(여긴 조회용 raw pointer만 들고 있음).
-	std::vector<std::pair<std::string, GuiComponent*>> namedExtras;
+	// RetroPangui: ES가 값을 채워 넣는 이름 있는 extra(bgmTitle, clock-*, rp-card-N)를
+	// populate() 때 한 번 이름으로 찾아 둔 핸들 - 매 프레임 문자열 검색/조합을 하지 않음.
+	// backgroundExtras와 같은 포인터를 가리키므로 소유권/삭제는 backgroundExtras 쪽에서만
+	// 수행(여긴 조회용 raw pointer만 들고 있음). 테마가 안 뒀으면 nullptr.
+	struct RecentCard
+	{
+		ImageComponent* image; // rp-card-N
+		GuiComponent* name;    // rp-card-N-name
+		GuiComponent* shadow;  // rp-card-N-shadow
+	};
+	GuiComponent* bgmTitle;
+	GuiComponent* clockTime;
+	GuiComponent* clockDate;
+	std::vector<RecentCard> recentCards;
+	// SystemView::sExtraTasks와 같은 순서 - 테마가 extra에 updateInterval(ms)을 주면 그 값, 아니면 -1(표 기본값)
+	std::vector<int> extraTaskIntervals;
 };
 
 struct SystemViewCarousel
@@ -82,17 +95,42 @@ private:
 	void renderInfoBar(const Transform4x4f& trans);
 	void renderFade(const Transform4x4f& trans);
 
-	// RetroPangui: RECENTLY PLAYED 카드(rp-card-1..N) 이미지/이름을 매 프레임 최신 상태로 갱신
-	// system: 지금 보고 있는 시스템 - 이 시스템 소속 게임만 필터링하기 위함(2026-07-06)
+	// RetroPangui: 이름 있는 extra 갱신 작업과 그 주기. extras 자체의 update()(스크롤 등)는
+	// 매 프레임, 아래 작업들은 update()가 주기가 돌아온 것만 실행한다. 커서 이동/화면 표시/
+	// populate() 직후에는 모든 작업을 한 번씩 바로 실행해서 첫 값이 1초 늦게 뜨지 않게 함.
+	// 표의 주기는 기본값 - 테마가 extra 요소에 updateInterval(ms, 0이면 매 프레임)을 두면 그 값을 쓴다.
+	enum ExtraCadence
+	{
+		EXTRA_EVERY_FRAME,
+		EXTRA_EVERY_SECOND,
+		EXTRA_ON_CURSOR_CHANGE
+	};
+	struct ExtraTask
+	{
+		ExtraCadence cadence;
+		const char* extra; // updateInterval을 읽을 테마 요소 이름, 없으면 nullptr
+		void (SystemView::*run)(SystemViewData& data, SystemData* system);
+	};
+	static const ExtraTask sExtraTasks[];
+	void resolveNamedExtras(SystemViewData& data, const std::vector<std::pair<std::string, GuiComponent*>>& extras, const std::shared_ptr<ThemeData>& theme);
+	void runExtraTasks(int deltaTime);
+	std::vector<int> mExtraTaskElapsed; // 작업별 마지막 실행 이후 지난 시간(ms)
+	bool mExtraTasksDirty; // 다음 update()에서 주기와 무관하게 모든 작업 실행
+
+	// RetroPangui: RECENTLY PLAYED 카드(rp-card-1..N) 이미지/이름을 최신 상태로 갱신 - 시스템이
+	// 바뀌었거나 그 시스템의 최근 플레이 인덱스 버전이 올랐을 때만 카드를 다시 채움
+	// system: 지금 보고 있는 시스템 - 이 시스템 소속 게임만 보여주기 위함(2026-07-06)
 	void updateRecentlyPlayed(SystemViewData& data, SystemData* system);
+	SystemData* mRecentCardsSystem;
+	unsigned int mRecentCardsVersion;
+	bool mRecentCardsDirty;
 
-	// RetroPangui: 하단 푸터 우측 bgmTitle 텍스트에 현재 재생 트랙 제목을 매 프레임 반영
-	void updateBgmTitle(SystemViewData& data);
+	// RetroPangui: 하단 푸터 우측 bgmTitle 텍스트에 현재 재생 트랙 제목 반영(1초 주기, 바뀔 때만 setValue)
+	void updateBgmTitle(SystemViewData& data, SystemData* system);
 
 	// RetroPangui: 메인 화면 우측 상단 시계(clock-time/clock-date, 테마 쪽 이름 있는 extra) -
 	// 1초에 한 번만 텍스트를 다시 그려서 매 프레임 setText() 비용을 피함(2026-07-23)
-	void updateClock(SystemViewData& data, int deltaTime);
-	int mClockAccumulator;
+	void updateClock(SystemViewData& data, SystemData* system);
 
 
 	SystemViewCarousel mCarousel;
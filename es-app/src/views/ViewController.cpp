@@ -15,12 +15,14 @@
 #include "views/UIModeController.h"
 #include "FileFilterIndex.h"
 #include "Log.h"
+#include "MediaIndex.h"
 #include "Scripting.h"
 #include "Settings.h"
 #include "SystemData.h"
 #include "Window.h"
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
+#include <SDL_timer.h>
 
 ViewController* ViewController::sInstance = NULL;
 
@@ -305,7 +307,6 @@ void ViewController::launch(FileData* game, Vector3f center, int entrySlot, bool
 		{
 			game->launchGame(mWindow, entrySlot);
 			setAnimation(new LambdaAnimation(fadeFunc, 800), 0, [this, game] { mLockInput = false; }, true);
-			this->onFileChanged(game, FILE_METADATA_CHANGED);
 			if (mCurrentView) {
 				this->getGameListView(game->getSystem())->setCursor(game, true);
 				mCurrentView->onShow();
@@ -318,7 +319,6 @@ void ViewController::launch(FileData* game, Vector3f center, int entrySlot, bool
 			game->launchGame(mWindow, entrySlot);
 			mCamera = origCamera;
 			setAnimation(new LaunchAnimation(mCamera, mFadeOpacity, center, 600), 0, [this, game] { mLockInput = false; }, true);
-			this->onFileChanged(game, FILE_METADATA_CHANGED);
 			if (mCurrentView) {
 				this->getGameListView(game->getSystem())->setCursor(game, true);
 				mCurrentView->onShow();
@@ -330,7 +330,6 @@ void ViewController::launch(FileData* game, Vector3f center, int entrySlot, bool
 			game->launchGame(mWindow, entrySlot);
 			mCamera = origCamera;
 			setAnimation(new LaunchAnimation(mCamera, mFadeOpacity, center, 10), 0, [this, game] { mLockInput = false; }, true);
-			this->onFileChanged(game, FILE_METADATA_CHANGED);
 			if (mCurrentView) {
 				this->getGameListView(game->getSystem())->setCursor(game, true);
 				mCurrentView->onShow();
@@ -386,7 +385,19 @@ std::shared_ptr<IGameListView> ViewController::getGameListView(SystemData* syste
 
 	if (selectedViewType == AUTOMATIC)
 	{
-		std::vector<FileData*> files = system->getRootFolder()->getFilesRecursive(GAME | FOLDER);
+		// RetroPangui: 게임은 미디어 인덱스 개수로 바로 판정하고, 인덱스에 없는 폴더(컬렉션이면 전부)만 훑는다
+		unsigned int typeMask = GAME | FOLDER;
+		if (!system->isCollection())
+		{
+			MediaIndex* mediaIndex = system->getMediaIndex();
+			if (themeHasVideoView && mediaIndex->getCount(MEDIA_VIDEO) > 0)
+				selectedViewType = VIDEO;
+			else if (mediaIndex->getCount(MEDIA_THUMBNAIL) > 0)
+				selectedViewType = DETAILED;
+			typeMask = FOLDER;
+		}
+
+		std::vector<FileData*> files = selectedViewType == VIDEO ? std::vector<FileData*>() : system->getRootFolder()->getFilesRecursive(typeMask);
 		for (auto it = files.cbegin(); it != files.cend(); it++)
 		{
 			if (themeHasVideoView && !(*it)->getVideoPath().empty())
@@ -519,28 +530,6 @@ void ViewController::render(const Transform4x4f& parentTrans)
 	}
 }
 
-void ViewController::preload()
-{
-	int i = 1;
-	int max = SystemData::sSystemVector.size() + 1;
-
-	bool splash = Settings::getInstance()->getBool("SplashScreen");
-	if (splash)
-		mWindow->renderLoadingScreen("Preloading UI", (float)i / (float)max);
-
-	for(auto it = SystemData::sSystemVector.cbegin(); it != SystemData::sSystemVector.cend(); it++)
-	{
-		if (splash)
-		{
-			i++;
-			mWindow->renderLoadingScreen("Preloading UI", (float)i / (float)max);
-		}
-
-		(*it)->getIndex()->resetFilters();
-		getGameListView(*it);
-	}
-}
-
 void ViewController::reloadGameListView(IGameListView* view, bool reloadTheme)
 {
 	for(auto it = mGameListViews.cbegin(); it != mGameListViews.cend(); it++)
@@ -587,10 +576,16 @@ void ViewController::reloadAll(bool themeChanged)
 	}
 	mGameListViews.clear();
 
-	// load themes, create gamelistviews and reset filters
+	// load themes (in parallel), create gamelistviews and reset filters
+	const Uint32 startTime = SDL_GetTicks();
+	std::vector<SystemData*> systems;
+	for(auto it = cursorMap.cbegin(); it != cursorMap.cend(); it++)
+		systems.push_back(it->first);
+	SystemData::loadThemes(systems);
+	const Uint32 themeTime = SDL_GetTicks();
+
 	for(auto it = cursorMap.cbegin(); it != cursorMap.cend(); it++)
 	{
-		it->first->loadTheme();
 		it->first->getIndex()->resetFilters();
 		getGameListView(it->first)->setCursor(it->second);
 	}
@@ -608,6 +603,10 @@ void ViewController::reloadAll(bool themeChanged)
 	mSystemListView.reset();
 	getSystemListView();
 
+	// RetroPangui: 테마 속성 조회 비용(뷰 생성 시 applyTheme)을 비교하는 기준 수치
+	LOG(LogInfo) << "ViewController: reloaded themes in " << (themeTime - startTime) << " ms, applied them to "
+		<< systems.size() << " gamelist views and the system view in " << (SDL_GetTicks() - themeTime) << " ms";
+
 	// update mCurrentView since the pointers changed
 	if(mState.viewing == GAME_LIST)
 	{
@@ -9,6 +9,25 @@
 #include "Settings.h"
 #include "SystemData.h"
 
+namespace
+{
+	// RetroPangui: 목록 항목(이름/폴더 색/즐겨찾기 표시)은 화면에 보일 때만 FileData에서 만든다
+	class GameListSource : public TextListComponent<FileData*>::VectorDataSource
+	{
+	public:
+		GameListSource(const std::vector<FileData*>& files) : TextListComponent<FileData*>::VectorDataSource(files) {}
+
+		void getEntry(int index, Entry& entry) const override
+		{
+			FileData* file = getObject(index);
+			entry.name = file->getName();
+			entry.object = file;
+			entry.data.colorId = (file->getType() == FOLDER);
+			entry.data.marker = file->getType() == GAME && file->metadata.get("favorite") == "true";
+		}
+	};
+}
+
 BasicGameListView::BasicGameListView(Window* window, FileData* root)
 	: ISimpleGameListView(window, root), mList(window)
 {
@@ -46,17 +65,9 @@ void BasicGameListView::populateList(const std::vector<FileData*>& files)
 	mList.clear();
 	mHeaderText.setText(mRoot->getSystem()->getFullName());
 	if (files.size() > 0)
-	{
-		for(auto it = files.cbegin(); it != files.cend(); it++)
-		{
-			bool isFavorite = (*it)->getType() == GAME && (*it)->metadata.get("favorite") == "true";
-			mList.add((*it)->getName(), *it, ((*it)->getType() == FOLDER), isFavorite);
-		}
-	}
+		mList.setDataSource(std::make_shared<GameListSource>(files));
 	else
-	{
 		addPlaceholder();
-	}
 }
 
 FileData* BasicGameListView::getCursor()
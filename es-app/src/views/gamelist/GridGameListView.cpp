@@ -128,6 +128,24 @@ GridGameListView::~GridGameListView()
 	delete mVideo;
 }
 
+// RetroPangui: 타일 항목(이름/이미지 경로)은 화면에 보일 때만 FileData에서 만든다
+class GridGameListView::GameGridSource : public ImageGridComponent<FileData*>::VectorDataSource
+{
+public:
+	GameGridSource(GridGameListView* view, const std::vector<FileData*>& files) : ImageGridComponent<FileData*>::VectorDataSource(files), mView(view) {}
+
+	void getEntry(int index, Entry& entry) const override
+	{
+		FileData* file = getObject(index);
+		entry.name = file->getName();
+		entry.object = file;
+		entry.data.texturePath = mView->getImagePath(file);
+	}
+
+private:
+	GridGameListView* mView;
+};
+
 FileData* GridGameListView::getCursor()
 {
 	return mGrid.getSelected();
@@ -177,16 +195,9 @@ void GridGameListView::populateList(const std::vector<FileData*>& files)
 	mGrid.clear();
 	mHeaderText.setText(mRoot->getSystem()->getFullName());
 	if (files.size() > 0)
-	{
-		for (auto it = files.cbegin(); it != files.cend(); it++)
-		{
-			mGrid.add((*it)->getName(), getImagePath(*it), *it);
-		}
-	}
+		mGrid.setDataSource(std::make_shared<GameGridSource>(this, files));
 	else
-	{
 		addPlaceholder();
-	}
 }
 
 void GridGameListView::onThemeChanged(const std::shared_ptr<ThemeData>& theme)
@@ -44,6 +44,8 @@ protected:
 	ImageGridComponent<FileData*> mGrid;
 
 private:
+	class GameGridSource;
+
 	void updateInfoPanel();
 	const std::string getImagePath(FileData* file);
 
@@ -7,6 +7,7 @@
 #include "components/VideoVlcComponent.h"
 #include "utils/FileSystemUtil.h"
 #include "views/ViewController.h"
+#include "MediaIndex.h"
 #ifdef _OMX_
 #include "Settings.h"
 #endif
@@ -259,16 +260,18 @@ void VideoGameListView::updateInfoPanel()
 		fadingOut = true;
 
 	}else{
-		if (!mVideo->setVideo(file->getVideoPath()))
+		// RetroPangui: 미디어 인덱스에 해석해 둔 경로 사용 - 선택이 바뀔 때마다 로컬 아트 exists() 탐색 안 함
+		if (!mVideo->setVideo(MediaIndex::getMediaPath(file, MEDIA_VIDEO)))
 		{
 			mVideo->setDefaultVideo();
 		}
 		mVideoPlaying = true;
 
-		mVideo->setImage(file->getThumbnailPath());
-		mThumbnail.setImage(file->getThumbnailPath());
-		mMarquee.setImage(file->getMarqueePath());
-		mImage.setImage(file->getImagePath());
+		const std::string thumbnail = MediaIndex::getMediaPath(file, MEDIA_THUMBNAIL);
+		mVideo->setImage(thumbnail);
+		mThumbnail.setImage(thumbnail);
+		mMarquee.setImage(MediaIndex::getMediaPath(file, MEDIA_MARQUEE));
+		mImage.setImage(MediaIndex::getMediaPath(file, MEDIA_IMAGE));
 
 		mDescription.setText(file->metadata.get("desc"));
 		mDescContainer.reset();
@@ -4,53 +4,262 @@
 #include "Settings.h"
 #include "Sound.h"
 #include <SDL.h>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
 std::vector<std::shared_ptr<Sound>> AudioManager::sSoundVector;
 SDL_AudioSpec AudioManager::sAudioFormat;
 std::shared_ptr<AudioManager> AudioManager::sInstance;
 
+AudioManager::Command AudioManager::sCommands[AudioManager::COMMAND_QUEUE_SIZE];
+std::atomic<unsigned int> AudioManager::sCommandHead(0);
+std::atomic<unsigned int> AudioManager::sCommandTail(0);
+
+AudioManager::Voice AudioManager::sVoices[AudioManager::MAX_VOICES];
+
+Sint16 AudioManager::sMusicBuffer[AudioManager::MUSIC_BUFFER_FRAMES * AudioManager::OUTPUT_CHANNELS];
+std::atomic<unsigned int> AudioManager::sMusicHead(0);
+std::atomic<unsigned int> AudioManager::sMusicTail(0);
+std::atomic<bool> AudioManager::sMusicActive(false);
+std::atomic<bool> AudioManager::sMusicFlush(false);
+
+std::atomic<bool> AudioManager::sDeviceOpen(false);
+
+std::atomic<Sint32> AudioManager::sSoundGain(16384);
+std::atomic<Sint32> AudioManager::sMusicGain(16384);
+
+// accum[i] += (src[i] * gain) >> 14, gain is Q14 and fits in a Sint16
+static void mixSamples(Sint32* accum, const Sint16* src, unsigned int count, Sint32 gain)
+{
+	unsigned int i = 0;
+
+#if defined(__SSE2__)
+	const __m128i g = _mm_set1_epi16((short)gain);
+	for(; i + 8 <= count; i += 8)
+	{
+		__m128i s  = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_mullo_epi16(s, g);
+		__m128i hi = _mm_mulhi_epi16(s, g);
+		__m128i p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 14);
+		__m128i p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 14);
+		__m128i* a = (__m128i*)(accum + i);
+		_mm_storeu_si128(a,     _mm_add_epi32(_mm_loadu_si128(a),     p0));
+		_mm_storeu_si128(a + 1, _mm_add_epi32(_mm_loadu_si128(a + 1), p1));
+	}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	const int16_t g = (int16_t)gain;
+	for(; i + 8 <= count; i += 8)
+	{
+		int16x8_t s = vld1q_s16(src + i);
+		int32x4_t p0 = vshrq_n_s32(vmull_n_s16(vget_low_s16(s), g), 14);
+		int32x4_t p1 = vshrq_n_s32(vmull_n_s16(vget_high_s16(s), g), 14);
+		vst1q_s32(accum + i,     vaddq_s32(vld1q_s32(accum + i),     p0));
+		vst1q_s32(accum + i + 4, vaddq_s32(vld1q_s32(accum + i + 4), p1));
+	}
+#endif
+
+	for(; i < count; i++)
+		accum[i] += (src[i] * gain) >> 14;
+}
+
+// saturate the 32-bit accumulator down to the 16-bit output stream
+static void writeSaturated(Sint16* dst, const Sint32* accum, unsigned int count)
+{
+	unsigned int i = 0;
+
+#if defined(__SSE2__)
+	for(; i + 8 <= count; i += 8)
+	{
+		__m128i a0 = _mm_loadu_si128((const __m128i*)(accum + i));
+		__m128i a1 = _mm_loadu_si128((const __m128i*)(accum + i + 4));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(a0, a1));
+	}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	for(; i + 8 <= count; i += 8)
+	{
+		int16x4_t lo = vqmovn_s32(vld1q_s32(accum + i));
+		int16x4_t hi = vqmovn_s32(vld1q_s32(accum + i + 4));
+		vst1q_s16(dst + i, vcombine_s16(lo, hi));
+	}
+#endif
+
+	for(; i < count; i++)
+		dst[i] = (Sint16)std::max(-32768, std::min(32767, accum[i]));
+}
+
+static Sint32 percentToGain(int percent)
+{
+	// Q14, clamped to unity. 100% == 16384
+	return (Sint32)(std::max(0, std::min(100, percent)) * 16384 / 100);
+}
 
 void AudioManager::mixAudio(void* /*unused*/, Uint8 *stream, int len)
 {
-	bool stillPlaying = false;
+	static Sint32 accum[MIX_CHUNK_SAMPLES];
 
-	//initialize the buffer to "silence"
-	SDL_memset(stream, 0, len);
+	processCommands();
 
-	//iterate through all our samples
-	std::vector<std::shared_ptr<Sound>>::const_iterator soundIt = sSoundVector.cbegin();
-	while (soundIt != sSoundVector.cend())
+	//drop buffered music on request, and keep the ring drained while nobody is listening
+	const bool musicActive = sMusicActive.load(std::memory_order_acquire);
+	if(sMusicFlush.exchange(false, std::memory_order_acq_rel) || !musicActive)
+		sMusicTail.store(sMusicHead.load(std::memory_order_acquire), std::memory_order_release);
+
+	Sint16* out = (Sint16*)stream;
+	const unsigned int totalSamples = (unsigned int)len / sizeof(Sint16);
+	const Sint32 musicGain = sMusicGain.load(std::memory_order_relaxed);
+	bool stillPlaying = musicActive;
+
+	for(unsigned int offset = 0; offset < totalSamples; offset += MIX_CHUNK_SAMPLES)
 	{
-		std::shared_ptr<Sound> sound = *soundIt;
-		if(sound->isPlaying())
+		const unsigned int samples = std::min((unsigned int)MIX_CHUNK_SAMPLES, totalSamples - offset);
+		memset(accum, 0, samples * sizeof(Sint32));
+
+		//iterate through all our voices
+		for(int i = 0; i < MAX_VOICES; i++)
 		{
-			//calculate rest length of current sample
-			Uint32 restLength = (sound->getLength() - sound->getPosition());
-			if (restLength > (Uint32)len) {
-				//if stream length is smaller than smaple lenght, clip it
-				restLength = len;
-			}
-			//mix sample into stream
-			SDL_MixAudio(stream, &(sound->getData()[sound->getPosition()]), restLength, SDL_MIX_MAXVOLUME);
-			if (sound->getPosition() + restLength < sound->getLength())
-			{
-				//sample hasn't ended yet
+			Voice& voice = sVoices[i];
+			if(voice.sound == nullptr)
+				continue;
+
+			//clip to the rest of the sample or the chunk, whichever is shorter
+			const unsigned int count = std::min(samples, voice.length - voice.position);
+			mixSamples(accum, voice.data + voice.position, count, voice.gain);
+			voice.position += count;
+
+			if(voice.position >= voice.length)
+				stopVoice(voice);
+			else
 				stillPlaying = true;
-			}
-			//set new sound position. if this is at or beyond the end of the sample, it will stop automatically
-			sound->setPosition(sound->getPosition() + restLength);
 		}
-		//advance to next sound
-		++soundIt;
+
+		if(musicActive)
+			mixMusic(accum, samples, musicGain);
+
+		writeSaturated(out + offset, accum, samples);
 	}
 
 	//we have processed all samples. check if some will still be playing
-	if (!stillPlaying) {
+	if(!stillPlaying)
+	{
 		//no. pause audio till a Sound::play() wakes us up
 		SDL_PauseAudio(1);
 	}
 }
 
+unsigned int AudioManager::mixMusic(Sint32* accum, unsigned int samples, Sint32 gain)
+{
+	unsigned int tail = sMusicTail.load(std::memory_order_relaxed);
+	const unsigned int head = sMusicHead.load(std::memory_order_acquire);
+	unsigned int frames = std::min(head - tail, samples / OUTPUT_CHANNELS);
+	const unsigned int mixed = frames;
+
+	// the ring may wrap once inside this block
+	while(frames > 0)
+	{
+		const unsigned int index = tail & (MUSIC_BUFFER_FRAMES - 1);
+		const unsigned int run = std::min(frames, MUSIC_BUFFER_FRAMES - index);
+		mixSamples(accum, sMusicBuffer + index * OUTPUT_CHANNELS, run * OUTPUT_CHANNELS, gain);
+		accum += run * OUTPUT_CHANNELS;
+		tail += run;
+		frames -= run;
+	}
+
+	sMusicTail.store(tail, std::memory_order_release);
+	return mixed;
+}
+
+void AudioManager::processCommands()
+{
+	unsigned int tail = sCommandTail.load(std::memory_order_relaxed);
+	const unsigned int head = sCommandHead.load(std::memory_order_acquire);
+
+	while(tail != head)
+	{
+		const Command& cmd = sCommands[tail & (COMMAND_QUEUE_SIZE - 1)];
+		switch(cmd.type)
+		{
+		case CMD_PLAY:
+			startVoice(cmd.sound);
+			break;
+		case CMD_STOP:
+			for(int i = 0; i < MAX_VOICES; i++)
+				if(sVoices[i].sound == cmd.sound)
+					stopVoice(sVoices[i]);
+			break;
+		case CMD_STOP_ALL:
+			for(int i = 0; i < MAX_VOICES; i++)
+				if(sVoices[i].sound != nullptr)
+					stopVoice(sVoices[i]);
+			break;
+		}
+		++tail;
+	}
+
+	sCommandTail.store(tail, std::memory_order_release);
+}
+
+void AudioManager::startVoice(Sound* sound)
+{
+	if(sound->getSampleCount() == 0)
+	{
+		sound->mPending.store(false, std::memory_order_release);
+		return;
+	}
+
+	Voice* target = nullptr;
+
+	for(int i = 0; i < MAX_VOICES && target == nullptr; i++)
+	{
+		//replay from start if this sound is already playing
+		if(sVoices[i].sound == sound)
+			target = &sVoices[i];
+	}
+
+	for(int i = 0; i < MAX_VOICES && target == nullptr; i++)
+	{
+		if(sVoices[i].sound == nullptr)
+			target = &sVoices[i];
+	}
+
+	if(target == nullptr)
+	{
+		//all voices busy, steal the one that has played the longest
+		target = &sVoices[0];
+		for(int i = 1; i < MAX_VOICES; i++)
+			if(sVoices[i].position > target->position)
+				target = &sVoices[i];
+	}
+
+	if(target->sound != sound)
+	{
+		if(target->sound != nullptr)
+			stopVoice(*target);
+		sound->mActiveVoices.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	target->sound = sound;
+	target->data = sound->getSamples();
+	target->length = sound->getSampleCount();
+	target->position = 0;
+	target->gain = (sound->getGain() * sSoundGain.load(std::memory_order_relaxed)) >> 14;
+	sound->mPending.store(false, std::memory_order_release);
+}
+
+void AudioManager::stopVoice(Voice& voice)
+{
+	voice.sound->mActiveVoices.fetch_sub(1, std::memory_order_release);
+	voice.sound->mPending.store(false, std::memory_order_release);
+	voice.sound = nullptr;
+	voice.data = nullptr;
+	voice.length = 0;
+	voice.position = 0;
+}
+
 AudioManager::AudioManager()
 {
 	init();
@@ -78,19 +287,20 @@ void AudioManager::init()
 		return;
 	}
 
-	//stop playing all Sounds
-	for(unsigned int i = 0; i < sSoundVector.size(); i++)
-	{
-		if(sSoundVector.at(i)->isPlaying())
-		{
-			sSoundVector[i]->stop();
-		}
-	}
+	//stop playing all Sounds. the callback isn't running yet so we can reset the mixer directly
+	processCommands();
+	for(int i = 0; i < MAX_VOICES; i++)
+		if(sVoices[i].sound != nullptr)
+			stopVoice(sVoices[i]);
+	sMusicTail.store(sMusicHead.load(std::memory_order_acquire), std::memory_order_release);
+	sMusicFlush.store(false);
+
+	updateGains();
 
 	//Set up format and callback. Play 16-bit stereo audio at 44.1Khz
-	sAudioFormat.freq = 44100;
+	sAudioFormat.freq = OUTPUT_FREQUENCY;
 	sAudioFormat.format = AUDIO_S16;
-	sAudioFormat.channels = 2;
+	sAudioFormat.channels = OUTPUT_CHANNELS;
 	sAudioFormat.samples = 4096;
 	sAudioFormat.callback = mixAudio;
 	sAudioFormat.userdata = NULL;
@@ -98,7 +308,9 @@ void AudioManager::init()
 	//Open the audio device and pause
 	if (SDL_OpenAudio(&sAudioFormat, NULL) < 0) {
 		LOG(LogError) << "AudioManager Error - Unable to open SDL audio: " << SDL_GetError() << std::endl;
+		return;
 	}
+	sDeviceOpen = true;
 }
 
 void AudioManager::deinit()
@@ -108,6 +320,14 @@ void AudioManager::deinit()
 	//completely tear down SDL audio. else SDL hogs audio resources and emulators might fail to start...
 	SDL_CloseAudio();
 	SDL_QuitSubSystem(SDL_INIT_AUDIO);
+	sDeviceOpen = false;
+
+	//the callback is gone, drop anything that was still queued or playing
+	processCommands();
+	for(int i = 0; i < MAX_VOICES; i++)
+		if(sVoices[i].sound != nullptr)
+			stopVoice(sVoices[i]);
+
 	sInstance = NULL;
 }
 
@@ -132,6 +352,61 @@ void AudioManager::unregisterSound(std::shared_ptr<Sound> & sound)
 	LOG(LogError) << "AudioManager Error - tried to unregister a sound that wasn't registered!";
 }
 
+bool AudioManager::pushCommand(CommandType type, Sound* sound)
+{
+	const unsigned int head = sCommandHead.load(std::memory_order_relaxed);
+	if(head - sCommandTail.load(std::memory_order_acquire) >= COMMAND_QUEUE_SIZE)
+	{
+		LOG(LogWarning) << "AudioManager - command queue full, dropping command";
+		return false;
+	}
+
+	Command& cmd = sCommands[head & (COMMAND_QUEUE_SIZE - 1)];
+	cmd.type = type;
+	cmd.sound = sound;
+	sCommandHead.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+void AudioManager::updateGains()
+{
+	sSoundGain.store(percentToGain(Settings::getInstance()->getInt("SoundVolume")), std::memory_order_relaxed);
+	sMusicGain.store(percentToGain(Settings::getInstance()->getInt("MusicVolume")), std::memory_order_relaxed);
+}
+
+void AudioManager::playSound(Sound* sound)
+{
+	updateGains();
+
+	if(pushCommand(CMD_PLAY, sound))
+	{
+		sound->mPending.store(true, std::memory_order_release);
+		//unpause audio, the mixer will pick the command up on its next block
+		play();
+	}
+}
+
+void AudioManager::stopSound(Sound* sound)
+{
+	//deinit() already stopped every voice; queueing would only replay a stale stop on the next init()
+	if(!sDeviceOpen)
+		return;
+
+	pushCommand(CMD_STOP, sound);
+}
+
+void AudioManager::forgetSound(Sound* sound)
+{
+	//the sample data is about to go away: make sure the callback isn't running and
+	//no voice or queued command still points at it
+	SDL_LockAudio();
+	processCommands();
+	for(int i = 0; i < MAX_VOICES; i++)
+		if(sVoices[i].sound == sound)
+			stopVoice(sVoices[i]);
+	SDL_UnlockAudio();
+}
+
 void AudioManager::play()
 {
 	getInstance();
@@ -142,14 +417,52 @@ void AudioManager::play()
 
 void AudioManager::stop()
 {
+	if(!sDeviceOpen)
+		return;
+
 	//stop playing all Sounds
-	for(unsigned int i = 0; i < sSoundVector.size(); i++)
-	{
-		if(sSoundVector.at(i)->isPlaying())
-		{
-			sSoundVector[i]->stop();
-		}
-	}
+	pushCommand(CMD_STOP_ALL, nullptr);
 	//pause audio
 	SDL_PauseAudio(1);
 }
+
+size_t AudioManager::writeMusic(const Sint16* samples, size_t frames)
+{
+	const unsigned int head = sMusicHead.load(std::memory_order_relaxed);
+	const unsigned int used = head - sMusicTail.load(std::memory_order_acquire);
+	const unsigned int count = (unsigned int)std::min(frames, (size_t)(MUSIC_BUFFER_FRAMES - used));
+
+	for(unsigned int written = 0; written < count; )
+	{
+		const unsigned int index = (head + written) & (MUSIC_BUFFER_FRAMES - 1);
+		const unsigned int run = std::min(count - written, MUSIC_BUFFER_FRAMES - index);
+		memcpy(sMusicBuffer + index * OUTPUT_CHANNELS, samples + written * OUTPUT_CHANNELS, run * OUTPUT_CHANNELS * sizeof(Sint16));
+		written += run;
+	}
+
+	sMusicHead.store(head + count, std::memory_order_release);
+	return count;
+}
+
+size_t AudioManager::getMusicFreeFrames()
+{
+	return MUSIC_BUFFER_FRAMES - (sMusicHead.load(std::memory_order_acquire) - sMusicTail.load(std::memory_order_acquire));
+}
+
+void AudioManager::flushMusic()
+{
+	sMusicFlush.store(true, std::memory_order_release);
+}
+
+void AudioManager::setMusicStreamActive(bool active)
+{
+	updateGains();
+	sMusicActive.store(active, std::memory_order_release);
+	if(active && getInstance())
+		getInstance()->play();
+}
+
+bool AudioManager::isMusicStreamActive()
+{
+	return sMusicActive.load(std::memory_order_acquire);
+}
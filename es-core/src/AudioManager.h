@@ -3,22 +3,26 @@
 #define ES_CORE_AUDIO_MANAGER_H
 
 #include <SDL_audio.h>
+#include <atomic>
 #include <memory>
 #include <vector>
 
 class Sound;
 
+// Software mixer running on SDL's audio thread.
+// The UI thread never touches mixer state directly: Sound::play()/stop() push commands into a
+// single-producer/single-consumer queue that the audio callback drains at the start of each block.
+// Voices reference raw sample data; a Sound tearing down its data calls forgetSound() which
+// synchronizes with the callback through SDL_LockAudio (load/unload path only, never per frame).
 class AudioManager
 {
-	static SDL_AudioSpec sAudioFormat;
-	static std::vector<std::shared_ptr<Sound>> sSoundVector;
-	static std::shared_ptr<AudioManager> sInstance;
-
-	static void mixAudio(void *unused, Uint8 *stream, int len);
-
-	AudioManager();
-
 public:
+	// device format. Sound converts its samples to this at load time so the mixer never resamples
+	static const int OUTPUT_FREQUENCY = 44100;
+	static const int OUTPUT_CHANNELS = 2;
+	// simultaneous sample voices, the oldest voice gets stolen when all are busy
+	static const int MAX_VOICES = 8;
+
 	static std::shared_ptr<AudioManager> & getInstance();
 
 	void init();
@@ -27,10 +31,85 @@ public:
 	void registerSound(std::shared_ptr<Sound> & sound);
 	void unregisterSound(std::shared_ptr<Sound> & sound);
 
+	// UI thread only. stopSound()/forgetSound() are safe to call while the device is closed
+	void playSound(Sound* sound);
+	static void stopSound(Sound* sound);
+	static void forgetSound(Sound* sound);
+
 	void play();
 	void stop();
 
+	// re-read SoundVolume/MusicVolume. new gains apply to music immediately and to sounds on their next play()
+	static void updateGains();
+
+	// RetroPangui: 배경음악(MusicManager) 믹스 입력 - OUTPUT_FREQUENCY/OUTPUT_CHANNELS S16 PCM.
+	// 생산자(디코더 스레드) 1개 전용 링버퍼. 꽉 차면 실제로 쓴 프레임 수만 반환한다.
+	// 인스턴스가 deinit()으로 사라져도 디코더 스레드가 안전하게 부를 수 있도록 전부 static.
+	static size_t writeMusic(const Sint16* samples, size_t frames);
+	static size_t getMusicFreeFrames();
+	static void flushMusic();
+	static void setMusicStreamActive(bool active);
+	static bool isMusicStreamActive();
+
 	virtual ~AudioManager();
+
+private:
+	enum CommandType
+	{
+		CMD_PLAY,
+		CMD_STOP,
+		CMD_STOP_ALL
+	};
+
+	struct Command
+	{
+		CommandType type;
+		Sound* sound;
+	};
+
+	struct Voice
+	{
+		Sound* sound;
+		const Sint16* data;
+		Uint32 length;   // in samples (frames * channels)
+		Uint32 position; // in samples
+		Sint32 gain;     // Q14, 16384 = unity
+	};
+
+	static const unsigned int COMMAND_QUEUE_SIZE = 64;  // power of two
+	static const unsigned int MUSIC_BUFFER_FRAMES = 32768; // power of two, ~0.75s at 44.1kHz
+	static const unsigned int MIX_CHUNK_SAMPLES = 1024;
+
+	static SDL_AudioSpec sAudioFormat;
+	static std::vector<std::shared_ptr<Sound>> sSoundVector;
+	static std::shared_ptr<AudioManager> sInstance;
+
+	static Command sCommands[COMMAND_QUEUE_SIZE];
+	static std::atomic<unsigned int> sCommandHead; // written by the UI thread
+	static std::atomic<unsigned int> sCommandTail; // written by the audio thread
+
+	static Voice sVoices[MAX_VOICES];
+
+	static Sint16 sMusicBuffer[MUSIC_BUFFER_FRAMES * OUTPUT_CHANNELS];
+	static std::atomic<unsigned int> sMusicHead; // frames, written by the music producer
+	static std::atomic<unsigned int> sMusicTail; // frames, written by the audio thread
+	static std::atomic<bool> sMusicActive;
+	static std::atomic<bool> sMusicFlush;
+
+	static std::atomic<bool> sDeviceOpen; // stop/pause while closed are dropped - nothing can be playing
+
+	static std::atomic<Sint32> sSoundGain;
+	static std::atomic<Sint32> sMusicGain;
+
+	static void mixAudio(void *unused, Uint8 *stream, int len);
+	static void processCommands();
+	static void startVoice(Sound* sound);
+	static void stopVoice(Voice& voice);
+	static unsigned int mixMusic(Sint32* accum, unsigned int samples, Sint32 gain);
+
+	static bool pushCommand(CommandType type, Sound* sound);
+
+	AudioManager();
 };
 
 #endif // ES_CORE_AUDIO_MANAGER_H
@@ -412,33 +412,33 @@ void GuiComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std
 		return;
 
 	using namespace ThemeFlags;
-	if(properties & POSITION && elem->has("pos"))
+	if(properties & POSITION && elem->has(ThemeProperty::POS))
 	{
-		Vector2f denormalized = elem->get<Vector2f>("pos") * scale;
+		Vector2f denormalized = elem->get<Vector2f>(ThemeProperty::POS) * scale;
 		setPosition(Vector3f(denormalized.x(), denormalized.y(), 0));
 	}
 
-	if(properties & ThemeFlags::SIZE && elem->has("size"))
-		setSize(elem->get<Vector2f>("size") * scale);
+	if(properties & ThemeFlags::SIZE && elem->has(ThemeProperty::SIZE))
+		setSize(elem->get<Vector2f>(ThemeProperty::SIZE) * scale);
 
 	// position + size also implies origin
-	if((properties & ORIGIN || (properties & POSITION && properties & ThemeFlags::SIZE)) && elem->has("origin"))
-		setOrigin(elem->get<Vector2f>("origin"));
+	if((properties & ORIGIN || (properties & POSITION && properties & ThemeFlags::SIZE)) && elem->has(ThemeProperty::ORIGIN))
+		setOrigin(elem->get<Vector2f>(ThemeProperty::ORIGIN));
 
 	if(properties & ThemeFlags::ROTATION) {
-		if(elem->has("rotation"))
-			setRotationDegrees(elem->get<float>("rotation"));
-		if(elem->has("rotationOrigin"))
-			setRotationOrigin(elem->get<Vector2f>("rotationOrigin"));
+		if(elem->has(ThemeProperty::ROTATION))
+			setRotationDegrees(elem->get<float>(ThemeProperty::ROTATION));
+		if(elem->has(ThemeProperty::ROTATION_ORIGIN))
+			setRotationOrigin(elem->get<Vector2f>(ThemeProperty::ROTATION_ORIGIN));
 	}
 
-	if(properties & ThemeFlags::Z_INDEX && elem->has("zIndex"))
-		setZIndex(elem->get<float>("zIndex"));
+	if(properties & ThemeFlags::Z_INDEX && elem->has(ThemeProperty::Z_INDEX))
+		setZIndex(elem->get<float>(ThemeProperty::Z_INDEX));
 	else
 		setZIndex(getDefaultZIndex());
 
-	if(properties & ThemeFlags::VISIBLE && elem->has("visible"))
-		setVisible(elem->get<bool>("visible"));
+	if(properties & ThemeFlags::VISIBLE && elem->has(ThemeProperty::VISIBLE))
+		setVisible(elem->get<bool>(ThemeProperty::VISIBLE));
 	else
 		setVisible(true);
 }
@@ -21,18 +21,18 @@ void HelpStyle::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::s
 	if(!elem)
 		return;
 
-	if(elem->has("pos"))
-		position = elem->get<Vector2f>("pos") * Vector2f((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
+	if(elem->has(ThemeProperty::POS))
+		position = elem->get<Vector2f>(ThemeProperty::POS) * Vector2f((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
 
-	if(elem->has("origin"))
-		origin = elem->get<Vector2f>("origin");
+	if(elem->has(ThemeProperty::ORIGIN))
+		origin = elem->get<Vector2f>(ThemeProperty::ORIGIN);
 
-	if(elem->has("textColor"))
-		textColor = elem->get<unsigned int>("textColor");
+	if(elem->has(ThemeProperty::TEXT_COLOR))
+		textColor = elem->get<unsigned int>(ThemeProperty::TEXT_COLOR);
 
-	if(elem->has("iconColor"))
-		iconColor = elem->get<unsigned int>("iconColor");
+	if(elem->has(ThemeProperty::ICON_COLOR))
+		iconColor = elem->get<unsigned int>(ThemeProperty::ICON_COLOR);
 
-	if(elem->has("fontPath") || elem->has("fontSize"))
+	if(elem->has(ThemeProperty::FONT_PATH) || elem->has(ThemeProperty::FONT_SIZE))
 		font = Font::getFromTheme(elem, ThemeFlags::ALL, font);
 }
@@ -3,209 +3,528 @@
 #include "utils/FileSystemUtil.h"
 #include "Log.h"
 #include <assert.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+struct HttpReq::Transfer
+{
+	std::string url;
+	std::string saveAs;
+	FILE* file;
+	CURL* handle;                  // network thread only
+
+	std::string content;           // written by the network thread until status leaves REQ_IN_PROGRESS
+	std::string errorMsg;
+	long httpCode;
+	unsigned long long bytes;
+	std::atomic<int> status;
+
+	std::mutex callbackMutex;      // the owner's destructor waits for a running callback
+	CompletionFunc onComplete;
+	std::atomic<bool> cancelled;
+};
+
+// owns the curl multi handle and the thread that drives it
+class HttpNetwork
+{
+public:
+	static HttpNetwork& get()
+	{
+		static HttpNetwork instance;
+		return instance;
+	}
+	// false until the first request - stats can be read without starting the network thread
+	static bool isStarted() { return sStarted; }
 
-CURLM* HttpReq::s_multi_handle = curl_multi_init();
+	void submit(const std::shared_ptr<HttpReq::Transfer>& transfer);
+	void cancel(const std::shared_ptr<HttpReq::Transfer>& transfer);
+	HttpReq::Stats getStats();
 
-std::map<CURL*, HttpReq*> HttpReq::s_requests;
+private:
+	static const size_t MAX_IDLE_HANDLES = 8;
 
-std::string HttpReq::urlEncode(const std::string &s)
+	HttpNetwork();
+	~HttpNetwork();
+
+	void run();
+	void wake();
+	void start(const std::shared_ptr<HttpReq::Transfer>& transfer);
+	void finish(CURL* handle, CURLcode result);
+	void complete(const std::shared_ptr<HttpReq::Transfer>& transfer, HttpReq::Status status);
+	void release(CURL* handle);
+	bool setup(CURL* handle, HttpReq::Transfer* transfer);
+
+	static size_t writeContent(void* buff, size_t size, size_t nmemb, void* transfer_ptr);
+
+	static std::atomic<bool> sStarted;
+
+	CURLM* mMulti;
+	CURLSH* mShare;
+	std::thread mThread;
+
+	std::mutex mMutex;
+	std::vector<std::shared_ptr<HttpReq::Transfer>> mSubmitted;
+	std::vector<std::shared_ptr<HttpReq::Transfer>> mCancelled;
+	bool mQuit;
+	HttpReq::Stats mStats;
+
+	// network thread only
+	std::map<CURL*, std::shared_ptr<HttpReq::Transfer>> mRunning;
+	std::vector<CURL*> mIdleHandles;
+};
+
+std::atomic<bool> HttpNetwork::sStarted(false);
+
+HttpNetwork::HttpNetwork() : mQuit(false)
 {
-    const std::string unreserved = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_.~";
+	curl_global_init(CURL_GLOBAL_DEFAULT);
+	mStats = HttpReq::Stats();
 
-    std::string escaped="";
-    for(size_t i=0; i<s.length(); i++)
-    {
-        if (unreserved.find_first_of(s[i]) != std::string::npos)
-        {
-            escaped.push_back(s[i]);
-        }
-        else
-        {
-            escaped.append("%");
-            char buf[3];
-            sprintf(buf, "%.2X", (unsigned char)s[i]);
-            escaped.append(buf);
-        }
-    }
-    return escaped;
+	mMulti = curl_multi_init();
+
+	// DNS answers and TLS sessions outlive the easy handle that produced them.
+	// everything runs on mThread so the share needs no lock callbacks
+	mShare = curl_share_init();
+	curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+	curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+	mThread = std::thread(&HttpNetwork::run, this);
+	sStarted = true;
 }
 
-bool HttpReq::isUrl(const std::string& str)
+HttpNetwork::~HttpNetwork()
 {
-	//the worst guess
-	return (!str.empty() && !Utils::FileSystem::exists(str) &&
-		(str.find("http://") != std::string::npos || str.find("https://") != std::string::npos || str.find("www.") != std::string::npos));
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mQuit = true;
+	}
+	wake();
+	mThread.join();
+
+	for(auto it = mRunning.cbegin(); it != mRunning.cend(); it++)
+	{
+		curl_multi_remove_handle(mMulti, it->first);
+		curl_easy_cleanup(it->first);
+		if(it->second->file)
+			fclose(it->second->file);
+	}
+	for(auto handle : mIdleHandles)
+		curl_easy_cleanup(handle);
+
+	curl_multi_cleanup(mMulti);
+	curl_share_cleanup(mShare);
 }
 
-HttpReq::HttpReq(const std::string& url)
-	: mStatus(REQ_IN_PROGRESS), mHandle(NULL)
+void HttpNetwork::submit(const std::shared_ptr<HttpReq::Transfer>& transfer)
 {
-	mHandle = curl_easy_init();
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mSubmitted.push_back(transfer);
+	}
+	wake();
+}
 
-	if(mHandle == NULL)
+void HttpNetwork::cancel(const std::shared_ptr<HttpReq::Transfer>& transfer)
+{
 	{
-		mStatus = REQ_IO_ERROR;
-		onError("curl_easy_init failed");
-		return;
+		std::unique_lock<std::mutex> lock(mMutex);
+		mCancelled.push_back(transfer);
 	}
+	wake();
+}
 
-	//set the url
-	CURLcode err = curl_easy_setopt(mHandle, CURLOPT_URL, url.c_str());
-	if(err != CURLE_OK)
+HttpReq::Stats HttpNetwork::getStats()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	return mStats;
+}
+
+void HttpNetwork::wake()
+{
+#if CURL_AT_LEAST_VERSION(7,68,0)
+	curl_multi_wakeup(mMulti);
+#endif
+}
+
+void HttpNetwork::run()
+{
+	std::vector<std::shared_ptr<HttpReq::Transfer>> submitted;
+	std::vector<std::shared_ptr<HttpReq::Transfer>> cancelled;
+
+	while(true)
 	{
-		mStatus = REQ_IO_ERROR;
-		onError(curl_easy_strerror(err));
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			if(mQuit)
+				break;
+			submitted.swap(mSubmitted);
+			cancelled.swap(mCancelled);
+		}
+
+		// start new transfers first, a request can be cancelled before it ever started
+		for(auto& transfer : submitted)
+		{
+			if(!transfer->cancelled)
+				start(transfer);
+		}
+		submitted.clear();
+
+		for(auto& transfer : cancelled)
+		{
+			CURL* handle = transfer->handle;
+			if(handle == NULL || mRunning.find(handle) == mRunning.cend())
+				continue;
+
+			curl_multi_remove_handle(mMulti, handle);
+			if(transfer->file)
+			{
+				fclose(transfer->file);
+				transfer->file = NULL;
+				Utils::FileSystem::removeFile(transfer->saveAs);
+			}
+			release(handle);
+			mRunning.erase(handle);
+		}
+		cancelled.clear();
+
+		int running = 0;
+		CURLMcode merr = curl_multi_perform(mMulti, &running);
+		if(merr != CURLM_OK)
+			LOG(LogError) << "HttpReq: curl_multi_perform failed: " << curl_multi_strerror(merr);
+
+		int msgs_left;
+		CURLMsg* msg;
+		while((msg = curl_multi_info_read(mMulti, &msgs_left)) != nullptr)
+		{
+			if(msg->msg == CURLMSG_DONE)
+				finish(msg->easy_handle, msg->data.result);
+		}
+
+#if CURL_AT_LEAST_VERSION(7,68,0)
+		// sleeps until a socket is ready, the timeout expires or submit()/cancel() wakes us up
+		curl_multi_poll(mMulti, NULL, 0, 1000, NULL);
+#else
+		// no wakeup call, keep the timeout short so new requests are picked up quickly
+		curl_multi_wait(mMulti, NULL, 0, 20, NULL);
+#endif
+	}
+}
+
+void HttpNetwork::start(const std::shared_ptr<HttpReq::Transfer>& transfer)
+{
+	CURL* handle = NULL;
+	if(!mIdleHandles.empty())
+	{
+		handle = mIdleHandles.back();
+		mIdleHandles.pop_back();
+	}
+	else
+	{
+		handle = curl_easy_init();
+	}
+
+	if(handle == NULL)
+	{
+		transfer->errorMsg = "curl_easy_init failed";
+		complete(transfer, HttpReq::REQ_IO_ERROR);
 		return;
 	}
 
-	//set curl to handle redirects
-	err = curl_easy_setopt(mHandle, CURLOPT_FOLLOWLOCATION, 1L);
-	if(err != CURLE_OK)
+	if(!setup(handle, transfer.get()))
 	{
-		mStatus = REQ_IO_ERROR;
-		onError(curl_easy_strerror(err));
+		release(handle);
+		complete(transfer, HttpReq::REQ_IO_ERROR);
 		return;
 	}
 
-	//set curl max redirects
-	err = curl_easy_setopt(mHandle, CURLOPT_MAXREDIRS, 2L);
-	if(err != CURLE_OK)
+	//add the handle to our multi
+	CURLMcode merr = curl_multi_add_handle(mMulti, handle);
+	if(merr != CURLM_OK)
 	{
-		mStatus = REQ_IO_ERROR;
-		onError(curl_easy_strerror(err));
+		release(handle);
+		transfer->errorMsg = curl_multi_strerror(merr);
+		complete(transfer, HttpReq::REQ_IO_ERROR);
 		return;
 	}
 
+	transfer->handle = handle;
+	mRunning[handle] = transfer;
+}
+
+bool HttpNetwork::setup(CURL* handle, HttpReq::Transfer* transfer)
+{
+	CURLcode err = CURLE_OK;
+
+#define SETOPT(opt, value) \
+	if((err = curl_easy_setopt(handle, opt, value)) != CURLE_OK) \
+	{ \
+		transfer->errorMsg = curl_easy_strerror(err); \
+		return false; \
+	}
+
+	//set the url
+	SETOPT(CURLOPT_URL, transfer->url.c_str());
+
+	//set curl to handle redirects
+	SETOPT(CURLOPT_FOLLOWLOCATION, 1L);
+
+	//set curl max redirects
+	SETOPT(CURLOPT_MAXREDIRS, 2L);
+
 	//set curl restrict redirect protocols
 	//starting with 7.85.0, CURLOPT_REDIR_PROTOCOLS is deprecated
 	// and CURLOPT_REDIR_PROTOCOLS_STR should be used instead
 #if CURL_AT_LEAST_VERSION(7,85,0)
-	err = curl_easy_setopt(mHandle, CURLOPT_REDIR_PROTOCOLS_STR, "http,https");
+	SETOPT(CURLOPT_REDIR_PROTOCOLS_STR, "http,https");
 #else
-	err = curl_easy_setopt(mHandle, CURLOPT_REDIR_PROTOCOLS, CURLPROTO_HTTP | CURLPROTO_HTTPS);
+	SETOPT(CURLOPT_REDIR_PROTOCOLS, CURLPROTO_HTTP | CURLPROTO_HTTPS);
 #endif
-	if(err != CURLE_OK)
+
+	//share DNS cache and TLS sessions with every other transfer
+	SETOPT(CURLOPT_SHARE, mShare);
+
+	//tell curl how to write the data
+	SETOPT(CURLOPT_WRITEFUNCTION, &HttpNetwork::writeContent);
+
+	//give curl a pointer to the transfer so we know where to write the data *to* in our write function
+	SETOPT(CURLOPT_WRITEDATA, transfer);
+
+#undef SETOPT
+
+	if(!transfer->saveAs.empty())
 	{
-		mStatus = REQ_IO_ERROR;
-		onError(curl_easy_strerror(err));
-		return;
+		transfer->file = fopen(transfer->saveAs.c_str(), "wb");
+		if(transfer->file == NULL)
+		{
+			transfer->errorMsg = "Failed to open \"" + transfer->saveAs + "\" for writing";
+			return false;
+		}
 	}
 
-	//tell curl how to write the data
-	err = curl_easy_setopt(mHandle, CURLOPT_WRITEFUNCTION, &HttpReq::write_content);
-	if(err != CURLE_OK)
+	return true;
+}
+
+void HttpNetwork::finish(CURL* handle, CURLcode result)
+{
+	auto it = mRunning.find(handle);
+	if(it == mRunning.cend())
 	{
-		mStatus = REQ_IO_ERROR;
-		onError(curl_easy_strerror(err));
+		LOG(LogError) << "Cannot find easy handle!";
 		return;
 	}
 
-	//give curl a pointer to this HttpReq so we know where to write the data *to* in our write function
-	err = curl_easy_setopt(mHandle, CURLOPT_WRITEDATA, this);
-	if(err != CURLE_OK)
+	std::shared_ptr<HttpReq::Transfer> transfer = it->second;
+	mRunning.erase(it);
+	curl_multi_remove_handle(mMulti, handle);
+
+	HttpReq::Status status = HttpReq::REQ_SUCCESS;
+	if(result != CURLE_OK)
 	{
-		mStatus = REQ_IO_ERROR;
-		onError(curl_easy_strerror(err));
-		return;
+		status = HttpReq::REQ_IO_ERROR;
+		transfer->errorMsg = curl_easy_strerror(result);
+	}
+	else
+	{
+		curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &transfer->httpCode);
+		if(transfer->httpCode >= 400)
+		{
+			status = HttpReq::REQ_BAD_STATUS_CODE;
+			transfer->errorMsg = "HTTP status " + std::to_string(transfer->httpCode);
+		}
 	}
 
-	//add the handle to our multi
-	CURLMcode merr = curl_multi_add_handle(s_multi_handle, mHandle);
-	if(merr != CURLM_OK)
+	if(transfer->file && fclose(transfer->file) != 0 && status == HttpReq::REQ_SUCCESS)
 	{
-		mStatus = REQ_IO_ERROR;
-		onError(curl_multi_strerror(merr));
-		return;
+		status = HttpReq::REQ_IO_ERROR;
+		transfer->errorMsg = "Failed to write \"" + transfer->saveAs + "\". Disk full?";
 	}
+	transfer->file = NULL;
 
-	s_requests[mHandle] = this;
+	double firstByte = 0, total = 0;
+	long connects = 0;
+	curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME, &firstByte);
+	curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME, &total);
+	curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects);
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mStats.requests++;
+		if(status != HttpReq::REQ_SUCCESS)
+			mStats.failures++;
+		if(result == CURLE_OK && connects == 0)
+			mStats.reusedConnections++;
+		mStats.bytes += transfer->bytes;
+		mStats.totalFirstByteMs += firstByte * 1000.0;
+		mStats.totalTimeMs += total * 1000.0;
+	}
+
+	release(handle);
+	transfer->handle = NULL;
+
+	complete(transfer, status);
 }
 
-HttpReq::~HttpReq()
+void HttpNetwork::complete(const std::shared_ptr<HttpReq::Transfer>& transfer, HttpReq::Status status)
 {
-	if(mHandle)
+	if(transfer->file)
 	{
-		s_requests.erase(mHandle);
+		fclose(transfer->file);
+		transfer->file = NULL;
+	}
+	if(status != HttpReq::REQ_SUCCESS && !transfer->saveAs.empty())
+		Utils::FileSystem::removeFile(transfer->saveAs);
 
-		CURLMcode merr = curl_multi_remove_handle(s_multi_handle, mHandle);
+	// content/errorMsg are complete before the owner can see the new status
+	transfer->status = status;
 
-		if(merr != CURLM_OK)
-			LOG(LogError) << "Error removing curl_easy handle from curl_multi: " << curl_multi_strerror(merr);
+	std::unique_lock<std::mutex> lock(transfer->callbackMutex);
+	if(transfer->onComplete && !transfer->cancelled)
+		transfer->onComplete(status);
+}
 
-		curl_easy_cleanup(mHandle);
+void HttpNetwork::release(CURL* handle)
+{
+	// the connection itself stays in the multi handle's cache, reset only drops per-request options
+	if(mIdleHandles.size() < MAX_IDLE_HANDLES)
+	{
+		curl_easy_reset(handle);
+		mIdleHandles.push_back(handle);
+	}
+	else
+	{
+		curl_easy_cleanup(handle);
 	}
 }
 
-HttpReq::Status HttpReq::status()
+//used as a curl callback
+//size = size of an element, nmemb = number of elements
+//return value is number of bytes successfully written
+size_t HttpNetwork::writeContent(void* buff, size_t size, size_t nmemb, void* transfer_ptr)
 {
-	if(mStatus == REQ_IN_PROGRESS)
+	HttpReq::Transfer* transfer = (HttpReq::Transfer*)transfer_ptr;
+	size_t length = size * nmemb;
+
+	if(transfer->file)
 	{
-		int handle_count;
-		CURLMcode merr = curl_multi_perform(s_multi_handle, &handle_count);
-		if(merr != CURLM_OK && merr != CURLM_CALL_MULTI_PERFORM)
+		if(fwrite(buff, 1, length, transfer->file) != length)
+			return 0; // aborts the transfer with CURLE_WRITE_ERROR
+	}
+	else
+	{
+#if CURL_AT_LEAST_VERSION(7,55,0)
+		// grow the buffer once instead of doubling through the whole body
+		if(transfer->content.empty())
 		{
-			mStatus = REQ_IO_ERROR;
-			onError(curl_multi_strerror(merr));
-			return mStatus;
+			curl_off_t expected = -1;
+			if(curl_easy_getinfo(transfer->handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &expected) == CURLE_OK && expected > 0)
+				transfer->content.reserve((size_t)expected);
 		}
+#endif
+		transfer->content.append((const char*)buff, length);
+	}
 
-		int msgs_left;
-		CURLMsg* msg;
-		while((msg = curl_multi_info_read(s_multi_handle, &msgs_left)) != nullptr)
-		{
-			if(msg->msg == CURLMSG_DONE)
-			{
-				HttpReq* req = s_requests[msg->easy_handle];
-
-				if(req == NULL)
-				{
-					LOG(LogError) << "Cannot find easy handle!";
-					continue;
-				}
-
-				if(msg->data.result == CURLE_OK)
-				{
-					req->mStatus = REQ_SUCCESS;
-				}else{
-					req->mStatus = REQ_IO_ERROR;
-					req->onError(curl_easy_strerror(msg->data.result));
-				}
-			}
-		}
+	transfer->bytes += length;
+	return length;
+}
+
+std::string HttpReq::urlEncode(const std::string &s)
+{
+    const std::string unreserved = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_.~";
+
+    std::string escaped="";
+    for(size_t i=0; i<s.length(); i++)
+    {
+        if (unreserved.find_first_of(s[i]) != std::string::npos)
+        {
+            escaped.push_back(s[i]);
+        }
+        else
+        {
+            escaped.append("%");
+            char buf[3];
+            sprintf(buf, "%.2X", (unsigned char)s[i]);
+            escaped.append(buf);
+        }
+    }
+    return escaped;
+}
+
+bool HttpReq::isUrl(const std::string& str)
+{
+	//the worst guess
+	return (!str.empty() && !Utils::FileSystem::exists(str) &&
+		(str.find("http://") != std::string::npos || str.find("https://") != std::string::npos || str.find("www.") != std::string::npos));
+}
+
+HttpReq::HttpReq(const std::string& url, const std::string& saveAs, const CompletionFunc& onComplete)
+	: mTransfer(std::make_shared<Transfer>())
+{
+	mTransfer->url = url;
+	mTransfer->saveAs = saveAs;
+	mTransfer->file = NULL;
+	mTransfer->handle = NULL;
+	mTransfer->httpCode = 0;
+	mTransfer->bytes = 0;
+	mTransfer->status = REQ_IN_PROGRESS;
+	mTransfer->onComplete = onComplete;
+	mTransfer->cancelled = false;
+
+	HttpNetwork::get().submit(mTransfer);
+}
+
+HttpReq::~HttpReq()
+{
+	{
+		// waits for a completion callback that is running right now
+		std::unique_lock<std::mutex> lock(mTransfer->callbackMutex);
+		mTransfer->cancelled = true;
 	}
 
-	return mStatus;
+	if(mTransfer->status == REQ_IN_PROGRESS)
+		HttpNetwork::get().cancel(mTransfer);
 }
 
-std::string HttpReq::getContent() const
+HttpReq::Status HttpReq::status()
 {
-	assert(mStatus == REQ_SUCCESS);
-	return mContent.str();
+	return (Status)mTransfer->status.load();
 }
 
-void HttpReq::onError(const char* msg)
+const std::string& HttpReq::getContent() const
 {
-	mErrorMsg = msg;
+	assert(mTransfer->status == REQ_SUCCESS);
+	return mTransfer->content;
 }
 
-std::string HttpReq::getErrorMsg()
+long HttpReq::getHttpCode() const
 {
-	return mErrorMsg;
+	return mTransfer->status == REQ_IN_PROGRESS ? 0 : mTransfer->httpCode;
 }
 
-//used as a curl callback
-//size = size of an element, nmemb = number of elements
-//return value is number of elements successfully read
-size_t HttpReq::write_content(void* buff, size_t size, size_t nmemb, void* req_ptr)
+std::string HttpReq::getErrorMsg()
 {
-	std::stringstream& ss = ((HttpReq*)req_ptr)->mContent;
-	ss.write((char*)buff, size * nmemb);
+	if(mTransfer->status == REQ_IN_PROGRESS)
+		return "";
+	return mTransfer->errorMsg;
+}
 
-	return nmemb;
+HttpReq::Stats HttpReq::getStats()
+{
+	return HttpNetwork::get().getStats();
 }
 
-//used as a curl callback
-/*int HttpReq::update_progress(void* req_ptr, double dlTotal, double dlNow, double ulTotal, double ulNow)
+void HttpReq::logStats()
 {
+	if(!HttpNetwork::isStarted())
+		return;
 
-}*/
+	const Stats stats = getStats();
+	if(stats.requests > 0)
+	{
+		LOG(LogInfo) << "HttpReq: " << stats.requests << " requests (" << stats.failures << " failed), " << (stats.bytes / 1024) << " KiB, "
+			<< "avg first byte " << (int)(stats.totalFirstByteMs / stats.requests) << " ms, "
+			<< (stats.reusedConnections * 100 / stats.requests) << "% reused connections";
+	}
+}
@@ -3,8 +3,9 @@
 #define ES_CORE_HTTP_REQ_H
 
 #include <curl/curl.h>
-#include <map>
-#include <sstream>
+#include <functional>
+#include <memory>
+#include <string>
 
 /* Usage:
  * HttpReq myRequest("www.google.com", "/index.html");
@@ -23,50 +24,61 @@
  * //process contents...
 */
 
+// Transfers run on a dedicated network thread (curl_multi_poll loop), so they make progress
+// regardless of how often status() is polled - status() only reads the result.
+// Easy handles are recycled and DNS/TLS sessions are shared between transfers, and the multi
+// handle keeps connections alive, so consecutive requests to the same host skip the handshake.
 class HttpReq
 {
 public:
-	HttpReq(const std::string& url);
-
-	~HttpReq();
-
 	enum Status
 	{
 		REQ_IN_PROGRESS,		//request is in progress
 		REQ_SUCCESS,			//request completed successfully, get it with getContent()
 
 		REQ_IO_ERROR,			//some error happened, get it with getErrorMsg()
-		REQ_BAD_STATUS_CODE,	//some invalid HTTP response status code happened (non-200)
+		REQ_BAD_STATUS_CODE,	//some invalid HTTP response status code happened (>= 400)
 		REQ_INVALID_RESPONSE	//the HTTP response was invalid
 	};
 
-	Status status(); //process any received data and return the status afterwards
+	// called once on the network thread when the request finishes - keep it short (set a flag, push an event).
+	// not called if the request is destroyed before it finishes
+	typedef std::function<void(Status status)> CompletionFunc;
 
-	std::string getErrorMsg();
+	// if saveAs is set the body is streamed straight to that file instead of memory (getContent() stays empty),
+	// a partial file is removed when the transfer fails
+	HttpReq(const std::string& url, const std::string& saveAs = "", const CompletionFunc& onComplete = nullptr);
 
-	std::string getContent() const; // mStatus must be REQ_SUCCESS
+	~HttpReq();
 
-	static std::string urlEncode(const std::string &s);
-	static bool isUrl(const std::string& s);
+	Status status(); //return the status, never blocks
 
-private:
-	static size_t write_content(void* buff, size_t size, size_t nmemb, void* req_ptr);
-	//static int update_progress(void* req_ptr, double dlTotal, double dlNow, double ulTotal, double ulNow);
-
-	//god dammit libcurl why can't you have some way to check the status of an individual handle
-	//why do I have to handle ALL messages at once
-	static std::map<CURL*, HttpReq*> s_requests;
+	std::string getErrorMsg();
 
-	static CURLM* s_multi_handle;
+	const std::string& getContent() const; // mStatus must be REQ_SUCCESS
+	long getHttpCode() const; // 0 until the request finished
 
-	void onError(const char* msg);
+	struct Stats
+	{
+		unsigned int requests;          // finished transfers
+		unsigned int failures;
+		unsigned int reusedConnections; // transfers that did not open a new connection
+		unsigned long long bytes;
+		double totalFirstByteMs;        // sum of time-to-first-byte
+		double totalTimeMs;
+	};
+	static Stats getStats();
+	// logs the totals so far - call before shutdown, the log is closed before static destructors run
+	static void logStats();
 
-	CURL* mHandle;
+	static std::string urlEncode(const std::string &s);
+	static bool isUrl(const std::string& s);
 
-	Status mStatus;
+private:
+	friend class HttpNetwork;
+	struct Transfer;
 
-	std::stringstream mContent;
-	std::string mErrorMsg;
+	std::shared_ptr<Transfer> mTransfer;
 };
 
 #endif // ES_CORE_HTTP_REQ_H
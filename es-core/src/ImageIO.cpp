@@ -88,3 +88,23 @@ void ImageIO::flipPixelsVert(unsigned char* imagePx, const size_t& width, const
 		}
 	}
 }
+
+bool ImageIO::loadImageSize(const std::string& path, unsigned int& width, unsigned int& height)
+{
+	width = 0;
+	height = 0;
+	FREE_IMAGE_FORMAT format = FreeImage_GetFileType(path.c_str(), 0);
+	if (format == FIF_UNKNOWN)
+		format = FreeImage_GetFIFFromFilename(path.c_str());
+	if (format == FIF_UNKNOWN || !FreeImage_FIFSupportsReading(format))
+		return false;
+
+	FIBITMAP* fiBitmap = FreeImage_Load(format, path.c_str(), FIF_LOAD_NOPIXELS);
+	if (fiBitmap == nullptr)
+		return false;
+
+	width = FreeImage_GetWidth(fiBitmap);
+	height = FreeImage_GetHeight(fiBitmap);
+	FreeImage_Unload(fiBitmap);
+	return true;
+}
@@ -3,6 +3,7 @@
 #define ES_CORE_IMAGE_IO
 
 #include <stdlib.h>
+#include <string>
 #include <vector>
 
 class ImageIO
@@ -10,6 +11,8 @@ class ImageIO
 public:
 	static std::vector<unsigned char> loadFromMemoryRGBA32(const unsigned char * data, const size_t size, size_t & width, size_t & height);
 	static void flipPixelsVert(unsigned char* imagePx, const size_t& width, const size_t& height);
+	// reads only the image header (no pixel decode). returns false if the file can't be read
+	static bool loadImageSize(const std::string& path, unsigned int& width, unsigned int& height);
 };
 
 #endif // ES_CORE_IMAGE_IO
@@ -8,6 +8,7 @@
 // RetroPangui: Static member initialization
 std::map<std::string, std::string> InputConfig::sActionMapping;
 std::string InputConfig::sButtonLayout = "";
+unsigned int InputConfig::sActionMappingGeneration = 0;
 
 //some util functions
 std::string inputTypeToString(InputType type)
@@ -49,11 +50,15 @@ InputConfig::InputConfig(int deviceId, const std::string& deviceName, const std:
 {
 	mVendorId   =  0;
 	mProductId  =  0;
+	mActionsDirty = true;
+	mActionsGeneration = 0;
+	mLastActions = 0;
 }
 
 void InputConfig::clear()
 {
 	mNameMap.clear();
+	mActionsDirty = true;
 }
 
 bool InputConfig::isConfigured()
@@ -64,13 +69,17 @@ bool InputConfig::isConfigured()
 void InputConfig::mapInput(const std::string& name, Input input)
 {
 	mNameMap[Utils::String::toLower(name)] = input;
+	mActionsDirty = true;
 }
 
 void InputConfig::unmapInput(const std::string& name)
 {
 	auto it = mNameMap.find(Utils::String::toLower(name));
 	if(it != mNameMap.cend())
+	{
 		mNameMap.erase(it);
+		mActionsDirty = true;
+	}
 }
 
 bool InputConfig::getInputByName(const std::string& name, Input* result)
@@ -125,6 +134,10 @@ bool InputConfig::isMappedToAxisDir(const std::string& name, Input input, bool i
 
 bool InputConfig::isMappedLike(const std::string& name, Input input)
 {
+	const unsigned int action = getActionByName(name);
+	if(action != 0)
+		return isAction(input, action);
+
 	if(name == "left")
 	{
 		return isMappedTo("left", input) || isMappedTo("leftanalogleft", input) || isMappedTo("rightanalogleft", input)
@@ -181,6 +194,7 @@ void InputConfig::initActionMapping()
 	}
 
 	sButtonLayout = layout;
+	sActionMappingGeneration++;
 	LOG(LogInfo) << "Button Layout: " << layout
 	             << " (Accept=" << sActionMapping["accept"]
 	             << ", Back=" << sActionMapping["back"] << ")";
@@ -203,6 +217,11 @@ bool InputConfig::isMappedToAction(const std::string& action, Input input)
 		if (action == "back")   return input.id == SDLK_ESCAPE;
 	}
 
+	if (action == "accept")
+		return isAction(input, ACTION_ACCEPT);
+	if (action == "back")
+		return isAction(input, ACTION_BACK);
+
 	// Convert logical action to physical button
 	auto it = sActionMapping.find(action);
 	if (it != sActionMapping.end())
@@ -243,6 +262,138 @@ std::string InputConfig::getActionButton(const std::string& action)
 	return action; // Fallback
 }
 
+unsigned int InputConfig::getActionByName(const std::string& name)
+{
+	static const struct { const char* name; unsigned int action; } ACTION_NAMES[] =
+	{
+		{ "up", ACTION_UP }, { "down", ACTION_DOWN }, { "left", ACTION_LEFT }, { "right", ACTION_RIGHT },
+		{ "a", ACTION_A }, { "b", ACTION_B }, { "x", ACTION_X }, { "y", ACTION_Y },
+		{ "start", ACTION_START }, { "select", ACTION_SELECT },
+		{ "leftshoulder", ACTION_LEFTSHOULDER }, { "rightshoulder", ACTION_RIGHTSHOULDER },
+		{ "lefttrigger", ACTION_LEFTTRIGGER }, { "righttrigger", ACTION_RIGHTTRIGGER }
+	};
+
+	for(size_t i = 0; i < sizeof(ACTION_NAMES) / sizeof(ACTION_NAMES[0]); i++)
+		if(name == ACTION_NAMES[i].name)
+			return ACTION_NAMES[i].action;
+	return 0;
+}
+
+void InputConfig::addAction(const Input& input, unsigned int actions)
+{
+	if(!input.configured)
+		return;
+
+	const unsigned long long key = ((unsigned long long)input.type << 32) | (unsigned int)input.id;
+	std::vector<ActionBinding>& bindings = mActionTable[key];
+	for(auto it = bindings.begin(); it != bindings.end(); it++)
+	{
+		if(it->value == input.value)
+		{
+			it->actions |= actions;
+			return;
+		}
+	}
+
+	ActionBinding binding = { input.type, input.value, actions };
+	bindings.push_back(binding);
+}
+
+// isMappedLike()/isMappedTo()/isMappedToAction()의 이름 규칙을 그대로 펼쳐서 역방향 표로
+void InputConfig::compileActions()
+{
+	mActionTable.clear();
+	mActionsDirty = false;
+	mActionsGeneration = sActionMappingGeneration;
+	mLastActionInput = Input();
+	mLastActions = 0;
+
+	static const struct { const char* name; unsigned int action; } BINDINGS[] =
+	{
+		{ "up", ACTION_UP }, { "leftanalogup", ACTION_UP }, { "rightanalogup", ACTION_UP },
+		{ "down", ACTION_DOWN }, { "leftanalogdown", ACTION_DOWN }, { "rightanalogdown", ACTION_DOWN },
+		{ "left", ACTION_LEFT }, { "leftanalogleft", ACTION_LEFT }, { "rightanalogleft", ACTION_LEFT },
+		{ "right", ACTION_RIGHT }, { "leftanalogright", ACTION_RIGHT }, { "rightanalogright", ACTION_RIGHT },
+		{ "a", ACTION_A }, { "b", ACTION_B }, { "x", ACTION_X }, { "y", ACTION_Y },
+		{ "start", ACTION_START }, { "select", ACTION_SELECT },
+		{ "leftshoulder", ACTION_LEFTSHOULDER }, { "pageup", ACTION_LEFTSHOULDER },
+		{ "rightshoulder", ACTION_RIGHTSHOULDER }, { "pagedown", ACTION_RIGHTSHOULDER },
+		{ "lefttrigger", ACTION_LEFTTRIGGER }, { "righttrigger", ACTION_RIGHTTRIGGER }
+	};
+
+	Input comp;
+	for(size_t i = 0; i < sizeof(BINDINGS) / sizeof(BINDINGS[0]); i++)
+		if(getInputByName(BINDINGS[i].name, &comp))
+			addAction(comp, BINDINGS[i].action);
+
+	// 왼스틱은 음(-) 방향만 저장돼 있으므로 반대 방향은 부호를 뒤집어서 (isMappedToAxisDir 참고)
+	if(getInputByName("joystick1up", &comp) && comp.type == TYPE_AXIS)
+	{
+		addAction(comp, ACTION_UP);
+		addAction(Input(comp.device, comp.type, comp.id, -comp.value, comp.configured), ACTION_DOWN);
+	}
+	if(getInputByName("joystick1left", &comp) && comp.type == TYPE_AXIS)
+	{
+		addAction(comp, ACTION_LEFT);
+		addAction(Input(comp.device, comp.type, comp.id, -comp.value, comp.configured), ACTION_RIGHT);
+	}
+
+	if(mDeviceId == DEVICE_KEYBOARD)
+	{
+		addAction(Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_PAGEUP, 1, true), ACTION_LEFTSHOULDER);
+		addAction(Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_PAGEDOWN, 1, true), ACTION_RIGHTSHOULDER);
+
+		// 키보드는 레이아웃에 관계없이 Enter=accept, ESC=back (isMappedToAction 참고)
+		addAction(Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_RETURN, 1, true), ACTION_ACCEPT);
+		addAction(Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_ESCAPE, 1, true), ACTION_BACK);
+	}
+	else
+	{
+		if(getInputByName(getActionButton("accept"), &comp))
+			addAction(comp, ACTION_ACCEPT);
+		if(getInputByName(getActionButton("back"), &comp))
+			addAction(comp, ACTION_BACK);
+	}
+}
+
+unsigned int InputConfig::getActions(Input input)
+{
+	if(mActionsDirty || mActionsGeneration != sActionMappingGeneration || sActionMapping.empty())
+	{
+		if(sActionMapping.empty() || sButtonLayout.empty())
+			initActionMapping();
+		compileActions();
+	}
+
+	if(input.type == mLastActionInput.type && input.id == mLastActionInput.id && input.value == mLastActionInput.value)
+		return mLastActions;
+
+	unsigned int actions = 0;
+	auto it = mActionTable.find(((unsigned long long)input.type << 32) | (unsigned int)input.id);
+	if(it != mActionTable.cend())
+	{
+		for(auto binding = it->second.cbegin(); binding != it->second.cend(); binding++)
+		{
+			if(binding->type == TYPE_HAT)
+			{
+				if(input.value == 0 || (input.value & binding->value))
+					actions |= binding->actions;
+			}
+			else if(binding->type == TYPE_AXIS)
+			{
+				if(input.value == 0 || input.value == binding->value)
+					actions |= binding->actions;
+			}
+			else
+				actions |= binding->actions;
+		}
+	}
+
+	mLastActionInput = input;
+	mLastActions = actions;
+	return actions;
+}
+
 std::vector<std::string> InputConfig::getMappedTo(Input input)
 {
 	std::vector<std::string> maps;
@@ -303,6 +454,7 @@ void InputConfig::loadFromXML(pugi::xml_node& node)
 
 		mNameMap[Utils::String::toLower(name)] = Input(mDeviceId, typeEnum, id, value, true);
 	}
+	mActionsDirty = true;
 }
 
 void InputConfig::writeToXML(pugi::xml_node& parent)
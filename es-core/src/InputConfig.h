@@ -7,6 +7,7 @@
 #include <SDL_keyboard.h>
 #include <map>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 namespace pugi { class xml_node; }
@@ -24,6 +25,30 @@ enum InputType
 	TYPE_COUNT
 };
 
+// RetroPangui: GUI input() 핸들러가 자주 확인하는 동작들의 비트. 방향/숄더는 isMappedLike(),
+// ACCEPT/BACK은 isMappedToAction(), 나머지는 isMappedTo()와 같은 판정
+enum InputAction
+{
+	ACTION_UP            = 1 << 0,
+	ACTION_DOWN          = 1 << 1,
+	ACTION_LEFT          = 1 << 2,
+	ACTION_RIGHT         = 1 << 3,
+	ACTION_A             = 1 << 4,
+	ACTION_B             = 1 << 5,
+	ACTION_X             = 1 << 6,
+	ACTION_Y             = 1 << 7,
+	ACTION_START         = 1 << 8,
+	ACTION_SELECT        = 1 << 9,
+	ACTION_LEFTSHOULDER  = 1 << 10,
+	ACTION_RIGHTSHOULDER = 1 << 11,
+	ACTION_LEFTTRIGGER   = 1 << 12,
+	ACTION_RIGHTTRIGGER  = 1 << 13,
+	ACTION_ACCEPT        = 1 << 14,
+	ACTION_BACK          = 1 << 15,
+
+	ACTION_DIRECTIONS    = ACTION_UP | ACTION_DOWN | ACTION_LEFT | ACTION_RIGHT
+};
+
 struct Input
 {
 public:
@@ -121,6 +146,11 @@ public:
 	// RetroPangui: Logical button mapping (separates physical buttons from logical actions)
 	bool isMappedToAction(const std::string& action, Input input);
 
+	// RetroPangui: 이 입력이 해당하는 InputAction 비트들. 매핑이 바뀌면 (type, id) -> (value, 비트) 역방향 표를
+	// 한 번 만들어 두고, 같은 이벤트를 여러 핸들러가 연달아 물어보는 경우를 위해 마지막 결과도 기억한다
+	unsigned int getActions(Input input);
+	inline bool isAction(Input input, unsigned int actions) { return (getActions(input) & actions) != 0; }
+
 	// RetroPangui: Button layout management
 	static void setButtonLayout(const std::string& layout);
 	static std::string getButtonLayout();
@@ -140,6 +170,17 @@ public:
 	bool isConfigured();
 
 private:
+	struct ActionBinding
+	{
+		InputType type;
+		int value;
+		unsigned int actions;
+	};
+
+	void compileActions();
+	void addAction(const Input& input, unsigned int actions);
+	static unsigned int getActionByName(const std::string& name);
+
 	std::map<std::string, Input> mNameMap;
 	const int mDeviceId;
 	const std::string mDeviceName;
@@ -151,6 +192,13 @@ private:
 	// RetroPangui: Logical mapping table (accept, back, etc.)
 	static std::map<std::string, std::string> sActionMapping;
 	static std::string sButtonLayout;
+	static unsigned int sActionMappingGeneration; // initActionMapping()마다 증가 - ACCEPT/BACK 재컴파일용
+
+	std::unordered_map<unsigned long long, std::vector<ActionBinding>> mActionTable; // key: (type << 32) | id
+	bool mActionsDirty;
+	unsigned int mActionsGeneration;
+	Input mLastActionInput;
+	unsigned int mLastActions;
 };
 
 #endif // ES_CORE_INPUT_CONFIG_H
@@ -8,6 +8,7 @@
 #include "Window.h"
 #include <pugixml.hpp>
 #include <SDL.h>
+#include <algorithm>
 #include <iostream>
 #include <assert.h>
 
@@ -31,8 +32,11 @@ int SDL_USER_CECBUTTONUP   = -1;
 
 InputManager* InputManager::mInstance = NULL;
 
-InputManager::InputManager() : mKeyboardInputConfig(NULL), mBootGraceUntil(0)
+InputManager::InputManager() : mKeyboardInputConfig(NULL), mBootGraceUntil(0), mEventTimestamp(0), mPendingInputTimestamp(0)
 {
+	mLatencyStats.samples = 0;
+	mLatencyStats.totalMs = 0;
+	mLatencyStats.maxMs = 0;
 }
 
 InputManager::~InputManager()
@@ -53,6 +57,9 @@ void InputManager::init()
 	if(initialized())
 		deinit();
 
+	mPendingInputTimestamp = 0;
+	mEventTimestamp = 0;
+
 	SDL_SetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS,
 		Settings::getInstance()->getBool("BackgroundJoystickInput") ? "1" : "0");
 	// Don't enable the HIDAPI drivers by default, it will break the existing configurations
@@ -211,6 +218,10 @@ void InputManager::deinit()
 
 	SDL_JoystickEventState(SDL_DISABLE);
 	SDL_QuitSubSystem(SDL_INIT_JOYSTICK);
+
+	// 게임 실행 등으로 입력이 내려간 동안의 시간이 다음 프레임의 지연으로 잡히지 않도록
+	mPendingInputTimestamp = 0;
+	mEventTimestamp = 0;
 }
 
 int InputManager::getNumJoysticks() { return (int)mJoysticks.size(); }
@@ -275,9 +286,39 @@ InputConfig* InputManager::getInputConfigByDevice(int device)
 		return mInputConfigs[device];
 }
 
+void InputManager::dispatchInput(Window* window, InputConfig* config, Input input)
+{
+	// 떼는 이벤트(value 0)는 대개 화면을 바꾸지 않으므로 누름만 측정
+	if(input.value != 0 && mPendingInputTimestamp == 0)
+		mPendingInputTimestamp = mEventTimestamp != 0 ? mEventTimestamp : SDL_GetTicks();
+
+	window->input(config, input);
+}
+
+void InputManager::onFrameSwapped()
+{
+	if(mPendingInputTimestamp == 0)
+		return;
+
+	const Uint32 now = SDL_GetTicks();
+	const unsigned int latencyMs = now > mPendingInputTimestamp ? now - mPendingInputTimestamp : 0;
+	mPendingInputTimestamp = 0;
+
+	mLatencyStats.samples++;
+	mLatencyStats.totalMs += latencyMs;
+	mLatencyStats.maxMs = std::max(mLatencyStats.maxMs, latencyMs);
+	if(mLatencyStats.samples % 100 == 0)
+		LOG(LogDebug) << "Input latency: avg " << (mLatencyStats.totalMs / mLatencyStats.samples) << " ms, max " << mLatencyStats.maxMs
+			<< " ms over " << mLatencyStats.samples << " inputs";
+
+	if(mLatencyCallback)
+		mLatencyCallback(latencyMs);
+}
+
 bool InputManager::parseEvent(const SDL_Event& ev, Window* window)
 {
 	bool causedEvent = false;
+	mEventTimestamp = ev.common.timestamp;
 	switch(ev.type)
 	{
 	case SDL_JOYAXISMOTION:
@@ -301,7 +342,7 @@ bool InputManager::parseEvent(const SDL_Event& ev, Window* window)
 				else
 					normValue = -1;
 
-			window->input(getInputConfigByDevice(ev.jaxis.which), Input(ev.jaxis.which, TYPE_AXIS, ev.jaxis.axis, normValue, false));
+			dispatchInput(window, getInputConfigByDevice(ev.jaxis.which), Input(ev.jaxis.which, TYPE_AXIS, ev.jaxis.axis, normValue, false));
 			causedEvent = true;
 		}
 
@@ -311,11 +352,11 @@ bool InputManager::parseEvent(const SDL_Event& ev, Window* window)
 
 	case SDL_JOYBUTTONDOWN:
 	case SDL_JOYBUTTONUP:
-		window->input(getInputConfigByDevice(ev.jbutton.which), Input(ev.jbutton.which, TYPE_BUTTON, ev.jbutton.button, ev.jbutton.state == SDL_PRESSED, false));
+		dispatchInput(window, getInputConfigByDevice(ev.jbutton.which), Input(ev.jbutton.which, TYPE_BUTTON, ev.jbutton.button, ev.jbutton.state == SDL_PRESSED, false));
 		return true;
 
 	case SDL_JOYHATMOTION:
-		window->input(getInputConfigByDevice(ev.jhat.which), Input(ev.jhat.which, TYPE_HAT, ev.jhat.hat, ev.jhat.value, false));
+		dispatchInput(window, getInputConfigByDevice(ev.jhat.which), Input(ev.jhat.which, TYPE_HAT, ev.jhat.hat, ev.jhat.value, false));
 		return true;
 
 	case SDL_KEYDOWN:
@@ -335,11 +376,11 @@ bool InputManager::parseEvent(const SDL_Event& ev, Window* window)
 			return false;
 		}
 
-		window->input(getInputConfigByDevice(DEVICE_KEYBOARD), Input(DEVICE_KEYBOARD, TYPE_KEY, ev.key.keysym.sym, 1, false));
+		dispatchInput(window, getInputConfigByDevice(DEVICE_KEYBOARD), Input(DEVICE_KEYBOARD, TYPE_KEY, ev.key.keysym.sym, 1, false));
 		return true;
 
 	case SDL_KEYUP:
-		window->input(getInputConfigByDevice(DEVICE_KEYBOARD), Input(DEVICE_KEYBOARD, TYPE_KEY, ev.key.keysym.sym, 0, false));
+		dispatchInput(window, getInputConfigByDevice(DEVICE_KEYBOARD), Input(DEVICE_KEYBOARD, TYPE_KEY, ev.key.keysym.sym, 0, false));
 		return true;
 
 	case SDL_TEXTINPUT:
@@ -357,7 +398,7 @@ bool InputManager::parseEvent(const SDL_Event& ev, Window* window)
 
 	if((ev.type == (unsigned int)SDL_USER_CECBUTTONDOWN) || (ev.type == (unsigned int)SDL_USER_CECBUTTONUP))
 	{
-		window->input(getInputConfigByDevice(DEVICE_CEC), Input(DEVICE_CEC, TYPE_CEC_BUTTON, ev.user.code, ev.type == (unsigned int)SDL_USER_CECBUTTONDOWN, false));
+		dispatchInput(window, getInputConfigByDevice(DEVICE_CEC), Input(DEVICE_CEC, TYPE_CEC_BUTTON, ev.user.code, ev.type == (unsigned int)SDL_USER_CECBUTTONDOWN, false));
 		return true;
 	}
 
@@ -3,10 +3,12 @@
 #define ES_CORE_INPUT_MANAGER_H
 
 #include <SDL_joystick.h>
+#include <functional>
 #include <map>
 #include <string>
 
 class InputConfig;
+struct Input;
 class Window;
 union SDL_Event;
 
@@ -42,6 +44,13 @@ private:
 	// 처리되면서 부팅 직후 스팸성 알림이 뜨는 걸 막기 위함.
 	Uint32 mBootGraceUntil;
 
+	// RetroPangui: 입력 -> 화면 지연 측정. 처리 중인 SDL 이벤트의 타임스탬프와, 아직 화면에
+	// 나가지 않은 첫 누름 이벤트의 타임스탬프(0이면 없음)
+	Uint32 mEventTimestamp;
+	Uint32 mPendingInputTimestamp;
+
+	void dispatchInput(Window* window, InputConfig* config, Input input);
+
 	bool initialized() const;
 
 	void addJoystickByDeviceIndex(int id, Window* window = nullptr);
@@ -92,6 +101,23 @@ public:
 	InputConfig* getInputConfigByDevice(int deviceId);
 
 	bool parseEvent(const SDL_Event& ev, Window* window);
+
+	struct LatencyStats
+	{
+		unsigned int samples;
+		unsigned long long totalMs;
+		unsigned int maxMs;
+	};
+
+	// Renderer::swapBuffers() 직후 호출 - 지난 프레임 사이에 들어온 첫 누름 이벤트부터 지금까지를
+	// 입력 지연 한 건으로 기록하고 콜백에 넘김
+	void onFrameSwapped();
+	inline const LatencyStats& getInputLatencyStats() const { return mLatencyStats; }
+	inline void setInputLatencyCallback(const std::function<void(unsigned int latencyMs)>& callback) { mLatencyCallback = callback; }
+
+private:
+	LatencyStats mLatencyStats;
+	std::function<void(unsigned int latencyMs)> mLatencyCallback;
 };
 
 #endif // ES_CORE_INPUT_MANAGER_H
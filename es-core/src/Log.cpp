@@ -2,12 +2,191 @@
 
 #include "utils/FileSystemUtil.h"
 #include "platform.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
+#include <thread>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
 
 LogLevel Log::reportingLevel = LogInfo;
 FILE* Log::file = NULL; //fopen(getLogPath().c_str(), "w");
 
+namespace
+{
+	// Vyukov식 제한 크기 큐 - 생산자(아무 스레드)는 CAS로 칸을 잡고, 소비자는 쓰기 스레드 하나뿐
+	const size_t QUEUE_SIZE = 4096; // 2의 거듭제곱
+	const size_t QUEUE_MASK = QUEUE_SIZE - 1;
+
+	struct QueueSlot
+	{
+		std::atomic<size_t> sequence;
+		LogLevel level;
+		std::string message;
+	};
+
+	struct LogQueue
+	{
+		QueueSlot slots[QUEUE_SIZE];
+		std::atomic<size_t> enqueuePos;
+		size_t dequeuePos; // 쓰기 스레드 전용
+
+		LogQueue() : enqueuePos(0), dequeuePos(0)
+		{
+			for(size_t i = 0; i < QUEUE_SIZE; i++)
+				slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		// 가득 차 있으면 false - 호출한 쪽이 쓰기 스레드를 깨우고 다시 시도
+		bool push(LogLevel level, std::string& message)
+		{
+			size_t pos = enqueuePos.load(std::memory_order_relaxed);
+			for(;;)
+			{
+				QueueSlot& slot = slots[pos & QUEUE_MASK];
+				const size_t seq = slot.sequence.load(std::memory_order_acquire);
+				const long long diff = (long long)seq - (long long)pos;
+				if(diff == 0)
+				{
+					if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						slot.level = level;
+						slot.message.swap(message);
+						slot.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if(diff < 0)
+					return false;
+				else
+					pos = enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		bool pop(LogLevel& level, std::string& message)
+		{
+			QueueSlot& slot = slots[dequeuePos & QUEUE_MASK];
+			if(slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+				return false;
+
+			level = slot.level;
+			message.swap(slot.message);
+			slot.message.clear();
+			slot.sequence.store(dequeuePos + QUEUE_SIZE, std::memory_order_release);
+			dequeuePos++;
+			return true;
+		}
+
+		bool empty() const
+		{
+			return slots[dequeuePos & QUEUE_MASK].sequence.load(std::memory_order_acquire) != dequeuePos + 1;
+		}
+	};
+
+	LogQueue sQueue;
+	std::thread sWriter;
+	std::mutex sWriterMutex;
+	std::condition_variable sWriterCondition;
+	std::atomic<bool> sWriterRunning(false);
+	std::atomic<bool> sWriterSleeping(false);
+	std::atomic<bool> sFlushRequested(false);
+
+	const long MAX_LOG_SIZE = 8 * 1024 * 1024; // 넘으면 쓰기 스레드가 .bak으로 돌림
+
+	// 크래시 링 버퍼 - 시그널 핸들러에서 읽으므로 정적 배열과 원자 인덱스만 쓴다
+	const unsigned int CRASH_RECORDS = 128;
+	const size_t CRASH_RECORD_SIZE = 256;
+	char sCrashRing[CRASH_RECORDS][CRASH_RECORD_SIZE];
+	std::atomic<unsigned int> sCrashNext(0);
+	char sCrashPath[1024];
+
+	void recordCrashRing(const std::string& message)
+	{
+		char* record = sCrashRing[sCrashNext.fetch_add(1, std::memory_order_relaxed) % CRASH_RECORDS];
+		const size_t length = std::min(message.size(), CRASH_RECORD_SIZE - 1);
+		memcpy(record, message.data(), length);
+		record[length] = '\0';
+		if(length > 0 && length < message.size())
+			record[length - 1] = '\n';
+	}
+
+	void wakeWriter()
+	{
+		if(sWriterSleeping.load())
+		{
+			std::lock_guard<std::mutex> lock(sWriterMutex);
+			sWriterCondition.notify_one();
+		}
+	}
+
+#ifndef WIN32
+	void writeAll(int fd, const char* text)
+	{
+		size_t length = strlen(text);
+		while(length > 0)
+		{
+			const ssize_t written = write(fd, text, length);
+			if(written <= 0)
+				return;
+			text += written;
+			length -= (size_t)written;
+		}
+	}
+
+	// async-signal-safe 함수만 사용(open/write/strlen)
+	void crashSignalHandler(int sig)
+	{
+		const int fd = ::open(sCrashPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		const char* header = "Fatal signal caught, last log messages:\n";
+		writeAll(2, header);
+		if(fd >= 0)
+			writeAll(fd, header);
+
+		const unsigned int next = sCrashNext.load();
+		const unsigned int count = next < CRASH_RECORDS ? next : CRASH_RECORDS;
+		for(unsigned int i = next - count; i != next; i++)
+		{
+			const char* record = sCrashRing[i % CRASH_RECORDS];
+			writeAll(2, record);
+			if(fd >= 0)
+				writeAll(fd, record);
+		}
+
+		if(fd >= 0)
+			::close(fd);
+
+		signal(sig, SIG_DFL);
+		raise(sig);
+	}
+
+	void installCrashHandler()
+	{
+		const std::string path = Log::getLogPath() + ".crash";
+		strncpy(sCrashPath, path.c_str(), sizeof(sCrashPath) - 1);
+		sCrashPath[sizeof(sCrashPath) - 1] = '\0';
+
+		struct sigaction action;
+		memset(&action, 0, sizeof(action));
+		action.sa_handler = crashSignalHandler;
+		sigemptyset(&action.sa_mask);
+		action.sa_flags = SA_RESETHAND;
+
+		const int signals[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT };
+		for(size_t i = 0; i < sizeof(signals) / sizeof(signals[0]); i++)
+			sigaction(signals[i], &action, NULL);
+	}
+#endif
+}
+
 LogLevel Log::getReportingLevel()
 {
 	return reportingLevel;
@@ -35,12 +214,27 @@ void Log::init()
 void Log::open()
 {
 	file = fopen(getLogPath().c_str(), "w");
+	if(file == NULL)
+		return;
+
+#ifndef WIN32
+	installCrashHandler();
+#endif
+
+	sWriterRunning = true;
+	sWriter = std::thread(&Log::writerThread);
 }
 
 std::ostringstream& Log::get(LogLevel level)
 {
 	time_t t = time(nullptr);
-	os << std::put_time(localtime(&t), "%b %d %T ") << "lvl" << level << ": \t";
+	struct tm local;
+#ifdef WIN32
+	localtime_s(&local, &t);
+#else
+	localtime_r(&t, &local);
+#endif
+	os << std::put_time(&local, "%b %d %T ") << "lvl" << level << ": \t";
 	messageLevel = level;
 
 	return os;
@@ -48,12 +242,27 @@ std::ostringstream& Log::get(LogLevel level)
 
 void Log::flush()
 {
-	fflush(getOutput());
+	if(!sWriterRunning)
+		return;
+
+	sFlushRequested = true;
+	wakeWriter();
 }
 
 void Log::close()
 {
 	if(file == NULL) return;
+
+	if(sWriter.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(sWriterMutex);
+			sWriterRunning = false;
+		}
+		sWriterCondition.notify_one();
+		sWriter.join();
+	}
+
 	fclose(file);
 	file = NULL;
 }
@@ -63,11 +272,60 @@ FILE* Log::getOutput()
 	return file;
 }
 
+void Log::rotate()
+{
+	fclose(file);
+	remove((getLogPath() + ".bak").c_str());
+	rename(getLogPath().c_str(), (getLogPath() + ".bak").c_str());
+	file = fopen(getLogPath().c_str(), "w");
+}
+
+void Log::writerThread()
+{
+	LogLevel level;
+	std::string message;
+
+	for(;;)
+	{
+		bool wrote = false;
+		while(sQueue.pop(level, message))
+		{
+			if(file != NULL)
+				fputs(message.c_str(), file);
+
+			//if it's an error, also print to console
+			//print all messages if using --debug
+			if(level == LogError || reportingLevel >= LogDebug)
+				fputs(message.c_str(), stderr);
+
+			wrote = true;
+		}
+
+		if(file != NULL && (wrote || sFlushRequested.exchange(false)))
+		{
+			fflush(file);
+			if(ftell(file) > MAX_LOG_SIZE)
+				rotate();
+		}
+
+		std::unique_lock<std::mutex> lock(sWriterMutex);
+		if(!sWriterRunning && sQueue.empty())
+			break;
+
+		sWriterSleeping = true;
+		sWriterCondition.wait_for(lock, std::chrono::milliseconds(100), []
+		{
+			return !sQueue.empty() || !sWriterRunning || sFlushRequested;
+		});
+		sWriterSleeping = false;
+	}
+}
+
 Log::~Log()
 {
 	os << std::endl;
 
-	if(getOutput() == NULL)
+	if(!sWriterRunning)
 	{
 		// not open yet, print to stdout
 		std::cerr << "ERROR - tried to write to log file before it was open! The following won't be logged:\n";
@@ -75,10 +333,18 @@ Log::~Log()
 		return;
 	}
 
-	fprintf(getOutput(), "%s", os.str().c_str());
+	std::string message = os.str();
+	recordCrashRing(message);
+
+	while(!sQueue.push(messageLevel, message))
+	{
+		// 큐가 가득 참 - 쓰기 스레드가 비울 때까지 양보 (메시지를 버리지 않음)
+		sFlushRequested = true;
+		wakeWriter();
+		std::this_thread::yield();
+	}
 
-	//if it's an error, also print to console
-	//print all messages if using --debug
-	if(messageLevel == LogError || reportingLevel >= LogDebug)
-		fprintf(stderr, "%s", os.str().c_str());
+	// 나머지 레벨은 쓰기 스레드가 주기적으로(100ms) 깨어나서 가져감 - 메시지마다 깨우지 않음
+	if(messageLevel == LogError)
+		wakeWriter();
 }
@@ -4,12 +4,22 @@
 
 #include <sstream>
 
+// RetroPangui: ES_LOG_MAX_LEVEL보다 자세한 레벨의 LOG()는 상수 조건이라 컴파일러가 통째로 지운다
+// (CMake LOG_MAX_LEVEL, 기본 LogDebug)
+#ifndef ES_LOG_MAX_LEVEL
+#define ES_LOG_MAX_LEVEL LogDebug
+#endif
+
 #define LOG(level) \
-if(level <= Log::getReportingLevel()) \
+if(level <= ES_LOG_MAX_LEVEL && level <= Log::getReportingLevel()) \
         Log().get(level)
 
 enum LogLevel { LogError, LogWarning, LogInfo, LogDebug };
 
+// RetroPangui: 메시지는 호출한 스레드에서 포맷만 하고, 잠금 없는 MPSC 큐로 넘겨 open()이 띄운
+// 쓰기 스레드가 파일(과 stderr)에 모아서 쓴다. 최근 메시지는 고정 크기 링 버퍼에도 남겨서
+// SIGSEGV 등으로 죽을 때 시그널 핸들러가 es_log.txt.crash로 덤프하며, 파일이 커지면 쓰기 스레드가
+// .bak으로 돌린다.
 class Log
 {
 public:
@@ -22,16 +32,19 @@ public:
 
 	static std::string getLogPath();
 
+	// 쓰기 스레드를 깨워 큐를 비우고 fflush하게 함 - 기다리지 않음
 	static void flush();
 	static void init();
 	static void open();
-	static void close();
+	static void close(); // 큐를 모두 쓴 뒤 쓰기 스레드를 멈추고 파일을 닫음
 protected:
 	std::ostringstream os;
 	static FILE* file;
 private:
 	static LogLevel reportingLevel;
 	static FILE* getOutput();
+	static void writerThread();
+	static void rotate();
 	LogLevel messageLevel;
 };
 
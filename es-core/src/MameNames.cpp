@@ -4,7 +4,6 @@
 #include "utils/FileSystemUtil.h"
 #include "Log.h"
 #include <pugixml.hpp>
-#include <string.h>
 
 MameNames* MameNames::sInstance = nullptr;
 
@@ -52,11 +51,13 @@ MameNames::MameNames()
 		return;
 	}
 
+	size_t count = 0;
 	for(pugi::xml_node gameNode = doc.child("game"); gameNode; gameNode = gameNode.next_sibling("game"))
-	{
-		NamePair namePair = { gameNode.child("mamename").text().get(), gameNode.child("realname").text().get() };
-		mNamePairs.push_back(namePair);
-	}
+		count++;
+	mRealNames.reserve(count);
+
+	for(pugi::xml_node gameNode = doc.child("game"); gameNode; gameNode = gameNode.next_sibling("game"))
+		mRealNames.emplace(gameNode.child("mamename").text().get(), gameNode.child("realname").text().get());
 
 	// Read bios
 	xmlpath = ResourceManager::getInstance()->getResourcePath(":/mamebioses.xml");
@@ -76,8 +77,7 @@ MameNames::MameNames()
 
 	for(pugi::xml_node biosNode = doc.child("bios"); biosNode; biosNode = biosNode.next_sibling("bios"))
 	{
-		std::string bios = biosNode.text().get();
-		mMameBioses.push_back(bios);
+		mMameBioses.insert(biosNode.text().get());
 	}
 
 	// Read devices
@@ -98,8 +98,7 @@ MameNames::MameNames()
 
 	for(pugi::xml_node deviceNode = doc.child("device"); deviceNode; deviceNode = deviceNode.next_sibling("device"))
 	{
-		std::string device = deviceNode.text().get();
-		mMameDevices.push_back(device);
+		mMameDevices.insert(deviceNode.text().get());
 	}
 
 } // MameNames
@@ -109,52 +108,21 @@ MameNames::~MameNames()
 
 } // ~MameNames
 
-std::string MameNames::getRealName(const std::string& _mameName)
+std::string MameNames::getRealName(const std::string& _mameName) const
 {
-	size_t start = 0;
-	size_t end   = mNamePairs.size();
-
-	while(start < end)
-	{
-		const size_t index   = (start + end) / 2;
-		const int    compare = strcmp(mNamePairs[index].mameName.c_str(), _mameName.c_str());
-
-		if(compare < 0)       start = index + 1;
-		else if( compare > 0) end   = index;
-		else                  return mNamePairs[index].realName;
-	}
-
-	return _mameName;
+	auto it = mRealNames.find(_mameName);
+	return it != mRealNames.cend() ? it->second : _mameName;
 
 } // getRealName
 
-const bool MameNames::isBios(const std::string& _biosName)
+const bool MameNames::isBios(const std::string& _biosName) const
 {
-	return MameNames::find(mMameBioses, _biosName);
+	return mMameBioses.find(_biosName) != mMameBioses.cend();
 
 } // isBios
 
-const bool MameNames::isDevice(const std::string& _deviceName)
+const bool MameNames::isDevice(const std::string& _deviceName) const
 {
-	return MameNames::find(mMameDevices, _deviceName);
+	return mMameDevices.find(_deviceName) != mMameDevices.cend();
 
 } // isDevice
-
-const bool MameNames::find(std::vector<std::string> devices, const std::string& name)
-{
-	size_t start = 0;
-	size_t end   = devices.size();
-
-	while(start < end)
-	{
-		const size_t index   = (start + end) / 2;
-		const int    compare = strcmp(devices[index].c_str(), name.c_str());
-
-		if(compare < 0)       start = index + 1;
-		else if( compare > 0) end   = index;
-		else                  return true;
-	}
-
-	return false;
-
-}
@@ -3,7 +3,8 @@
 #define ES_CORE_MAMENAMES_H
 
 #include <string>
-#include <vector>
+#include <unordered_map>
+#include <unordered_set>
 
 class MameNames
 {
@@ -12,30 +13,22 @@ public:
 	static void       init       ();
 	static void       deinit     ();
 	static MameNames* getInstance();
-	std::string       getRealName(const std::string& _mameName);
-	const bool        isBios(const std::string& _biosName);
-	const bool        isDevice(const std::string& _deviceName);
+	std::string       getRealName(const std::string& _mameName) const;
+	const bool        isBios(const std::string& _biosName) const;
+	const bool        isDevice(const std::string& _deviceName) const;
 
 private:
 
-	struct NamePair
-	{
-		std::string mameName;
-		std::string realName;
-	};
-
-	typedef std::vector<NamePair> namePairVector;
-
 	 MameNames();
 	~MameNames();
 
 	static MameNames* sInstance;
 
-	namePairVector mNamePairs;
-	std::vector<std::string> mMameBioses;
-	std::vector<std::string> mMameDevices;
-
-	const bool find(const std::vector<std::string> devices, const std::string& name);
+	// RetroPangui: 시작 시 한 번 만드는 해시 테이블 - 아케이드 시스템은 파일마다 이름 변환/바이오스 확인을 하므로
+	// 정렬된 벡터 이분 탐색(strcmp) 대신 O(1) 조회
+	std::unordered_map<std::string, std::string> mRealNames;
+	std::unordered_set<std::string> mMameBioses;
+	std::unordered_set<std::string> mMameDevices;
 
 }; // MameNames
 
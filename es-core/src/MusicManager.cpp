@@ -1,18 +1,24 @@
 #include "MusicManager.h"
 
+#include "AudioManager.h"
 #include "Log.h"
 #include "Settings.h"
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
 
 #include <vlc/vlc.h>
+#include <pugixml.hpp>
+#include <SDL_timer.h>
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include <fstream>
 #include <random>
 #include <unistd.h>
 #include <signal.h>
+#include <sys/stat.h>
 #include <sys/wait.h>
 
 std::shared_ptr<MusicManager> MusicManager::sInstance = nullptr;
@@ -166,6 +172,92 @@ static std::string readSmfTitle(const std::string& path)
 	return "";
 }
 
+// 덱 링버퍼: ~5.9초(44.1kHz). 다음 곡 예열(PREROLL_MS + 크로스페이드) 동안 소비 없이
+// 쌓여도 넘치지 않을 만큼. 2의 거듭제곱이어야 함(인덱스 마스킹).
+static const unsigned int DECK_BUFFER_FRAMES = 262144;
+// 현재 곡이 이만큼 남으면 다음 곡 덱을 미리 만들어 디코딩을 시작한다
+static const int PREROLL_MS = 1500;
+// 스트림 스레드가 한 번에 AudioManager로 넘기는 프레임 수
+static const unsigned int STREAM_BLOCK_FRAMES = 1024;
+
+// MusicCrossfade는 예열분과 합쳐 덱 링버퍼에 들어가는 길이까지만 - 더 길면 페이드 도중 다음 덱이 비어 버림
+static int getCrossfadeMs()
+{
+	static const int MAX_CROSSFADE_MS = (int)((long long)DECK_BUFFER_FRAMES * 1000 / AudioManager::OUTPUT_FREQUENCY) - PREROLL_MS;
+	return std::max(0, std::min(Settings::getInstance()->getInt("MusicCrossfade"), MAX_CROSSFADE_MS));
+}
+
+struct MusicManager::Deck
+{
+	libvlc_media_player_t* player;
+	std::string path;
+	std::string title;
+	std::vector<Sint16> ring;
+	std::atomic<unsigned int> head;  // 프레임 단위, VLC 오디오 스레드가 씀
+	std::atomic<unsigned int> tail;  // 프레임 단위, 스트림 스레드가 씀
+	std::atomic<bool> ended;         // 디코딩 끝(drain 콜백 또는 Ended/Error 상태)
+	std::atomic<bool> alive;         // false면 콜백이 대기하지 않고 바로 반환
+	std::atomic<long long> totalFrames;    // 곡 길이(모르면 0) - 예열/크로스페이드 시점 계산용
+	std::atomic<long long> consumedFrames; // 스트림 스레드가 믹스한 프레임
+	std::atomic<long long> decodedFrames;  // 통계용
+	unsigned int switchFromTick;     // 전환 지연 측정 기준 시각(재생 요청 또는 이전 곡 종료)
+	unsigned int firstFrameTick;     // 첫 샘플을 믹스한 시각, 0이면 아직
+	unsigned int startTick;
+	double cpuStartMs;
+
+	Deck() : player(nullptr), ring(DECK_BUFFER_FRAMES * AudioManager::OUTPUT_CHANNELS), head(0), tail(0), ended(false), alive(true),
+		totalFrames(0), consumedFrames(0), decodedFrames(0), switchFromTick(0), firstFrameTick(0), startTick(0), cpuStartMs(0) {}
+
+	unsigned int available() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed); }
+};
+
+static double processCpuMs()
+{
+	timespec ts;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// VLC 오디오 스레드: 디코딩된 PCM을 덱 링버퍼에 쌓는다. 꽉 차면 스트림 스레드가 소비할
+// 때까지 잠깐씩 기다림 - VLC는 이 콜백이 블로킹돼도 다음 블록을 늦게 줄 뿐 문제없음.
+// 덱이 해제되는 중이면(alive=false) 바로 빠져나와 libvlc_media_player_stop()이 막히지 않게 한다.
+static void onDeckPlay(void* opaque, const void* samples, unsigned count, int64_t /*pts*/)
+{
+	MusicManager::Deck* deck = static_cast<MusicManager::Deck*>(opaque);
+	const Sint16* data = static_cast<const Sint16*>(samples);
+	size_t remaining = count;
+
+	while (remaining > 0 && deck->alive.load(std::memory_order_acquire))
+	{
+		const unsigned int head = deck->head.load(std::memory_order_relaxed);
+		const unsigned int space = DECK_BUFFER_FRAMES - (head - deck->tail.load(std::memory_order_acquire));
+		const unsigned int n = (unsigned int)std::min((size_t)space, remaining);
+		if (n == 0)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			continue;
+		}
+
+		for (unsigned int written = 0; written < n; )
+		{
+			const unsigned int index = (head + written) & (DECK_BUFFER_FRAMES - 1);
+			const unsigned int run = std::min(n - written, DECK_BUFFER_FRAMES - index);
+			memcpy(&deck->ring[index * AudioManager::OUTPUT_CHANNELS], data + written * AudioManager::OUTPUT_CHANNELS,
+				run * AudioManager::OUTPUT_CHANNELS * sizeof(Sint16));
+			written += run;
+		}
+		deck->head.store(head + n, std::memory_order_release);
+		deck->decodedFrames.fetch_add(n, std::memory_order_relaxed);
+		data += n * AudioManager::OUTPUT_CHANNELS;
+		remaining -= n;
+	}
+}
+
+static void onDeckDrain(void* opaque)
+{
+	static_cast<MusicManager::Deck*>(opaque)->ended.store(true, std::memory_order_release);
+}
+
 std::shared_ptr<MusicManager>& MusicManager::getInstance()
 {
 	if (sInstance == nullptr)
@@ -237,7 +329,21 @@ MusicManager::MusicManager() :
 	mCurrentIndex(0),
 	mPlaying(false),
 	mSoundfontActive(false),
-	mMidiPid(-1)
+	mMixed(false),
+	mMidiPid(-1),
+	mIndexLoaded(false),
+	mIndexDirty(false),
+	mScannedDirMtime(0),
+	mScannedMidiOk(false),
+	mCurrentDeck(nullptr),
+	mNextDeck(nullptr),
+	mStreamRunning(false),
+	mLastSwitchLatencyMs(-1),
+	mUnderruns(0),
+	mLastTrackCpuPercent(0.0f),
+	mPlayRequestTick(0),
+	mTrackStartTick(0),
+	mTrackCpuStartMs(0)
 {
 }
 
@@ -297,22 +403,16 @@ void MusicManager::start()
 		}
 	}
 
-	// 음악 폴더 스캔 (getDirContent 는 전체 경로를 반환)
-	mPlaylist.clear();
-	mCurrentIndex = 0;
+	loadIndex();
 
 	// 2026-07-11: 하드웨어 MIDI 출력이 설정돼 있으면 소프트 사운드폰트
 	// 없이도(mSoundfontActive=false) MIDI 재생이 가능함(aplaymidi 경로).
-	const bool midiOk = mSoundfontActive || !Settings::getInstance()->getString("MidiHardwareDevice").empty();
-	Utils::FileSystem::stringList files = Utils::FileSystem::getDirContent(musicDir);
-	for (Utils::FileSystem::stringList::const_iterator it = files.cbegin(); it != files.cend(); ++it)
-	{
-		std::string ext = Utils::String::toLower(Utils::FileSystem::getExtension(*it));
-		if (ext == ".mp3" || ext == ".ogg" || ext == ".flac" || ext == ".wav" || ext == ".m4a")
-			mPlaylist.push_back(*it);
-		else if ((ext == ".mid" || ext == ".midi") && midiOk)
-			mPlaylist.push_back(*it);
-	}
+	const bool hardwareMidi = !Settings::getInstance()->getString("MidiHardwareDevice").empty();
+	const bool midiOk = mSoundfontActive || hardwareMidi;
+	scanMusicDirectory(musicDir, midiOk);
+
+	mPlaylist = mScannedFiles;
+	mCurrentIndex = 0;
 
 	if (mPlaylist.empty())
 	{
@@ -320,12 +420,58 @@ void MusicManager::start()
 		return;
 	}
 
+	// 믹서 경유는 VLC 디코딩 트랙만 다룸 - 하드웨어 MIDI(aplaymidi)가 설정돼 있으면 기존 경로.
+	// AudioManager는 EnableSounds가 꺼져 있으면 생성되지 않음 - 그때도 VLC 자체 출력 유지.
+	mMixed = Settings::getInstance()->getBool("MixBackgroundMusic") && !hardwareMidi && AudioManager::getInstance();
+
 	shufflePlaylist();
 	playCurrent();
 }
 
+// 폴더 mtime이 그대로면 직전 스캔 결과를 재사용 (게임에서 돌아올 때마다 start()가 불림)
+void MusicManager::scanMusicDirectory(const std::string& musicDir, bool midiOk)
+{
+	struct stat st;
+	long long dirMtime = (stat(musicDir.c_str(), &st) == 0) ? (long long)st.st_mtime : 0;
+	if (musicDir == mScannedDir && dirMtime == mScannedDirMtime && midiOk == mScannedMidiOk && dirMtime != 0)
+		return;
+
+	mScannedDir = musicDir;
+	mScannedDirMtime = dirMtime;
+	mScannedMidiOk = midiOk;
+	mScannedFiles.clear();
+
+	// 음악 폴더 스캔 (getDirContent 는 전체 경로를 반환)
+	Utils::FileSystem::stringList files = Utils::FileSystem::getDirContent(musicDir);
+	for (Utils::FileSystem::stringList::const_iterator it = files.cbegin(); it != files.cend(); ++it)
+	{
+		std::string ext = Utils::String::toLower(Utils::FileSystem::getExtension(*it));
+		if (ext == ".mp3" || ext == ".ogg" || ext == ".flac" || ext == ".wav" || ext == ".m4a")
+			mScannedFiles.push_back(*it);
+		else if ((ext == ".mid" || ext == ".midi") && midiOk)
+			mScannedFiles.push_back(*it);
+	}
+}
+
 void MusicManager::stop()
 {
+	// 믹스 스트림을 먼저 끊어야 AudioManager 링버퍼가 비워지고(스트림 스레드 대기 해제)
+	// 이어지는 덱 해제에서 VLC 오디오 스레드가 콜백 대기에 묶이지 않음
+	AudioManager::setMusicStreamActive(false);
+	stopStreamThread();
+
+	std::vector<Deck*> decks;
+	{
+		std::lock_guard<std::mutex> lock(mDeckMutex);
+		decks.swap(mRetiredDecks);
+		if (mCurrentDeck != nullptr) decks.push_back(mCurrentDeck);
+		if (mNextDeck != nullptr) decks.push_back(mNextDeck);
+		mCurrentDeck = nullptr;
+		mNextDeck = nullptr;
+	}
+	for (Deck* deck : decks)
+		destroyDeck(deck);
+
 	if (mPlayer != nullptr)
 	{
 		libvlc_media_player_stop(mPlayer);
@@ -340,11 +486,14 @@ void MusicManager::stop()
 		mMidiPid = -1;
 	}
 	mPlaying = false;
+	mPlayRequestTick = 0;
+
+	saveIndex();
 }
 
 void MusicManager::update()
 {
-	if (!mPlaying || (mPlayer == nullptr && mMidiPid <= 0))
+	if (!mPlaying)
 		return;
 
 	// BackgroundMusic 설정이 꺼진 경우 즉시 정지 (어떤 경로로 재생이 시작됐더라도)
@@ -354,6 +503,86 @@ void MusicManager::update()
 		return;
 	}
 
+	if (mMixed)
+	{
+		// 스트림 스레드가 다 쓴 덱 정리 (libvlc 호출은 메인 스레드에서만)
+		std::vector<Deck*> retired;
+		{
+			std::lock_guard<std::mutex> lock(mDeckMutex);
+			retired.swap(mRetiredDecks);
+		}
+		for (Deck* deck : retired)
+		{
+			logDeckStats(deck);
+			destroyDeck(deck);
+		}
+
+		// 덱은 메인 스레드만 해제하므로 락 밖에서 포인터를 써도 안전
+		Deck* current;
+		Deck* next;
+		{
+			std::lock_guard<std::mutex> lock(mDeckMutex);
+			current = mCurrentDeck;
+			next = mNextDeck;
+		}
+
+		for (Deck* deck : { current, next })
+		{
+			if (deck == nullptr)
+				continue;
+			libvlc_state_t state = libvlc_media_player_get_state(deck->player);
+			if (state == libvlc_Ended || state == libvlc_Error)
+				deck->ended.store(true, std::memory_order_release);
+			// 태그 파싱을 건너뛴 곡은 재생이 시작된 뒤 길이를 알게 됨 - 인덱스에도 남김
+			if (deck->totalFrames.load() == 0)
+			{
+				libvlc_time_t length = libvlc_media_player_get_length(deck->player);
+				if (length > 0)
+				{
+					deck->totalFrames.store(length * AudioManager::OUTPUT_FREQUENCY / 1000);
+					auto it = mIndex.find(deck->path);
+					if (it != mIndex.end() && it->second.durationMs != (int)length)
+					{
+						it->second.durationMs = (int)length;
+						mIndexDirty = true;
+					}
+				}
+			}
+		}
+
+		if (current == nullptr)
+		{
+			// 다음 곡 예열이 늦었거나 실패 - 바로 다음 곡을 현재 덱으로
+			advanceIndex();
+			Deck* deck = createDeck(mCurrentIndex);
+			std::lock_guard<std::mutex> lock(mDeckMutex);
+			mCurrentDeck = deck;
+		}
+		else if (next == nullptr)
+		{
+			// 남은 시간이 예열+크로스페이드 이하이거나, 길이를 모르는데 디코딩이 끝났으면
+			// (덱 버퍼에 아직 몇 초 남아 있음) 다음 곡 디코딩 시작
+			const long long total = current->totalFrames.load();
+			const long long remainingMs = (total - current->consumedFrames.load()) * 1000 / AudioManager::OUTPUT_FREQUENCY;
+			const int crossfadeMs = getCrossfadeMs();
+			if ((total > 0 && remainingMs <= PREROLL_MS + crossfadeMs) || current->ended.load())
+			{
+				advanceIndex();
+				Deck* deck = createDeck(mCurrentIndex);
+				std::lock_guard<std::mutex> lock(mDeckMutex);
+				mNextDeck = deck;
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(mDeckMutex);
+		if (mCurrentDeck != nullptr)
+			mCurrentTitle = mCurrentDeck->title;
+		return;
+	}
+
+	if (mPlayer == nullptr && mMidiPid <= 0)
+		return;
+
 	bool trackEnded = false;
 
 	if (mMidiPid > 0)
@@ -373,24 +602,44 @@ void MusicManager::update()
 		libvlc_state_t state = libvlc_media_player_get_state(mPlayer);
 		if (state == libvlc_Ended || state == libvlc_Error)
 			trackEnded = true;
+		else if (state == libvlc_Playing && mPlayRequestTick != 0)
+		{
+			// VLC 자체 출력: 재생 요청 → Playing 상태까지를 전환 지연으로 본다
+			mLastSwitchLatencyMs = (int)(SDL_GetTicks() - mPlayRequestTick);
+			mPlayRequestTick = 0;
+			LOG(LogDebug) << "MusicManager: 트랙 전환 지연 " << mLastSwitchLatencyMs.load() << "ms";
+		}
 	}
 
 	if (trackEnded)
 	{
-		++mCurrentIndex;
-		if (mCurrentIndex >= mPlaylist.size())
+		const unsigned int wallMs = SDL_GetTicks() - mTrackStartTick;
+		if (wallMs > 0)
 		{
-			// 끝까지 재생했으면 재셔플, 직전 곡과 연속 중복 방지
-			const std::string last = mPlaylist.back();
-			shufflePlaylist();
-			mCurrentIndex = 0;
-			if (mPlaylist.size() >= 2 && mPlaylist[0] == last)
-				std::swap(mPlaylist[0], mPlaylist[1]);
+			mLastTrackCpuPercent = (float)((processCpuMs() - mTrackCpuStartMs) * 100.0 / wallMs);
+			LOG(LogInfo) << "MusicManager: 트랙 통계 - " << mCurrentTitle << " 재생 " << wallMs / 1000 << "s, 프로세스 CPU "
+				<< mLastTrackCpuPercent.load() << "%";
 		}
+
+		advanceIndex();
 		playCurrent();
 	}
 }
 
+// 다음 곡으로. 끝까지 재생했으면 재셔플, 직전 곡과 연속 중복 방지
+void MusicManager::advanceIndex()
+{
+	++mCurrentIndex;
+	if (mCurrentIndex >= mPlaylist.size())
+	{
+		const std::string last = mPlaylist.back();
+		shufflePlaylist();
+		mCurrentIndex = 0;
+		if (mPlaylist.size() >= 2 && mPlaylist[0] == last)
+			std::swap(mPlaylist[0], mPlaylist[1]);
+	}
+}
+
 bool MusicManager::isPlaying() const
 {
 	return mPlaying;
@@ -404,6 +653,24 @@ std::string MusicManager::getCurrentTrackTitle() const
 	return mCurrentTitle;
 }
 
+MusicManager::Stats MusicManager::getStats() const
+{
+	Stats stats;
+	stats.lastSwitchLatencyMs = mLastSwitchLatencyMs.load();
+	stats.underruns = mUnderruns.load();
+	stats.lastTrackCpuPercent = mLastTrackCpuPercent.load();
+	return stats;
+}
+
+void MusicManager::updateVolume()
+{
+	// 믹스 경로는 AudioManager 쪽 MusicVolume 게인으로 조절됨
+	if (mMixed)
+		AudioManager::updateGains();
+	else if (mPlayer != nullptr)
+		libvlc_audio_set_volume(mPlayer, Settings::getInstance()->getInt("MusicVolume"));
+}
+
 void MusicManager::shufflePlaylist()
 {
 	std::random_device rd;
@@ -411,6 +678,131 @@ void MusicManager::shufflePlaylist()
 	std::shuffle(mPlaylist.begin(), mPlaylist.end(), gen);
 }
 
+// 제목 인덱스 조회. 파일 크기/mtime이 그대로면 저장된 제목을 그대로 쓰고, 바뀌었거나
+// 처음 보는 파일만 SMF 메타 이벤트 파싱 또는 libvlc 태그 파싱(동기, 느림)을 한다.
+// media가 nullptr이면 태그 파싱은 건너뜀(aplaymidi 경로). durationMs는 모르면 0.
+std::string MusicManager::resolveTrackTitle(const std::string& path, libvlc_media_t* media, int* durationMs)
+{
+	struct stat st;
+	const bool statOk = (stat(path.c_str(), &st) == 0);
+	const long long size = statOk ? (long long)st.st_size : -1;
+	const long long mtime = statOk ? (long long)st.st_mtime : -1;
+
+	std::map<std::string, TrackInfo>::const_iterator cached = mIndex.find(path);
+	if (statOk && cached != mIndex.cend() && cached->second.size == size && cached->second.mtime == mtime && !cached->second.title.empty())
+	{
+		if (durationMs != nullptr)
+			*durationMs = cached->second.durationMs;
+		return cached->second.title;
+	}
+
+	std::string ext = Utils::String::toLower(Utils::FileSystem::getExtension(path));
+	const bool isMidi = (ext == ".mid" || ext == ".midi");
+	std::string title;
+	int duration = 0;
+
+	if (!isMidi && media != nullptr)
+	{
+		// ID3/Vorbis 태그 등에서 실제 곡 제목 파싱 시도 (동기 호출 - deprecated API지만
+		// 로컬 파일은 즉시 반환됨). MIDI는 표준 메타데이터가 없어 libvlc가 파일명을
+		// 그대로 Title로 돌려주므로 아예 태그 파싱을 건너뛰고 아래 SMF 경로로 간다.
+		libvlc_media_parse(media);
+		const char* tagTitle = libvlc_media_get_meta(media, libvlc_meta_Title);
+		// libvlc의 내부 ID3v2 파서가 일부 인코딩(특히 한자 포함 일본어 태그)에서
+		// 깨진 바이트열을 돌려주는 사례가 있음(실기기 확인, ffmpeg로는 정상 읽힘) -
+		// SMF 경로(readSmfTitle)와 동일하게 isValidUtf8()로 걸러서, 깨진 값이면
+		// "태그 없음"과 동일하게 취급해 stem으로 대체한다.
+		if (tagTitle != nullptr && tagTitle[0] != '\0' && Utils::FileSystem::getFileName(path) != tagTitle
+			&& isValidUtf8(tagTitle))
+		{
+			title = tagTitle;
+		}
+		libvlc_time_t length = libvlc_media_get_duration(media);
+		duration = length > 0 ? (int)length : 0;
+	}
+	else if (isMidi)
+	{
+		title = readSmfTitle(path);
+	}
+
+	if (title.empty())
+		title = Utils::FileSystem::getStem(path);
+
+	if (statOk)
+	{
+		TrackInfo& info = mIndex[path];
+		info.size = size;
+		info.mtime = mtime;
+		info.title = title;
+		info.durationMs = duration;
+		mIndexDirty = true;
+	}
+
+	if (durationMs != nullptr)
+		*durationMs = duration;
+	return title;
+}
+
+static std::string getIndexPath()
+{
+	return Utils::FileSystem::getHomePath() + "/.emulationstation/music_index.xml";
+}
+
+void MusicManager::loadIndex()
+{
+	if (mIndexLoaded)
+		return;
+	mIndexLoaded = true;
+
+	const std::string path = getIndexPath();
+	if (!Utils::FileSystem::exists(path))
+		return;
+
+	pugi::xml_document doc;
+	pugi::xml_parse_result result = doc.load_file(path.c_str());
+	if (!result)
+	{
+		LOG(LogWarning) << "MusicManager: 제목 인덱스 파싱 실패 - " << result.description();
+		return;
+	}
+
+	for (pugi::xml_node node = doc.child("musicIndex").child("track"); node; node = node.next_sibling("track"))
+	{
+		TrackInfo& info = mIndex[node.attribute("path").as_string()];
+		info.size = node.attribute("size").as_llong();
+		info.mtime = node.attribute("mtime").as_llong();
+		info.title = node.attribute("title").as_string();
+		info.durationMs = node.attribute("duration").as_int();
+	}
+	LOG(LogDebug) << "MusicManager: 제목 인덱스 " << mIndex.size() << "곡 로드";
+}
+
+void MusicManager::saveIndex()
+{
+	if (!mIndexDirty)
+		return;
+	mIndexDirty = false;
+
+	pugi::xml_document doc;
+	pugi::xml_node root = doc.append_child("musicIndex");
+	for (std::map<std::string, TrackInfo>::const_iterator it = mIndex.cbegin(); it != mIndex.cend(); ++it)
+	{
+		// 지워진 파일은 인덱스에서도 뺀다
+		if (!Utils::FileSystem::exists(it->first))
+			continue;
+
+		pugi::xml_node node = root.append_child("track");
+		node.append_attribute("path").set_value(it->first.c_str());
+		node.append_attribute("size").set_value(it->second.size);
+		node.append_attribute("mtime").set_value(it->second.mtime);
+		node.append_attribute("title").set_value(it->second.title.c_str());
+		node.append_attribute("duration").set_value(it->second.durationMs);
+	}
+
+	if (!doc.save_file(getIndexPath().c_str()))
+		LOG(LogWarning) << "MusicManager: 제목 인덱스 저장 실패 - " << getIndexPath();
+}
+
 // 2026-07-11: MIDI 하드웨어 출력(MT-32 신디사이저 등)이 설정돼 있으면
 // libvlc/fluidsynth로 소프트 합성하지 않고, aplaymidi로 원본 MIDI 이벤트를
 // 그대로 하드웨어 포트에 흘려보냄. system.midi_hardware_device가 비어있으면
@@ -438,15 +830,38 @@ bool MusicManager::playCurrentViaHardwareMidi(const std::string& path)
 	}
 
 	mMidiPid = pid;
-	std::string smfTitle = readSmfTitle(path);
-	mCurrentTitle = !smfTitle.empty() ? smfTitle : Utils::FileSystem::getStem(path);
+	mCurrentTitle = resolveTrackTitle(path, nullptr, nullptr);
 	mPlaying = true;
+	mPlayRequestTick = 0;
 	LOG(LogInfo) << "MusicManager: 하드웨어 MIDI 재생 시작(포트 " << port << ") - " << path;
 	return true;
 }
 
 void MusicManager::playCurrent()
 {
+	mTrackStartTick = SDL_GetTicks();
+	mTrackCpuStartMs = processCpuMs();
+
+	if (mMixed)
+	{
+		if (mCurrentIndex >= mPlaylist.size())
+		{
+			mPlaying = false;
+			return;
+		}
+
+		Deck* deck = createDeck(mCurrentIndex);
+		{
+			std::lock_guard<std::mutex> lock(mDeckMutex);
+			mCurrentDeck = deck;
+			mCurrentTitle = deck->title;
+		}
+		AudioManager::setMusicStreamActive(true);
+		startStreamThread();
+		mPlaying = true;
+		return;
+	}
+
 	// 기존 player 해제
 	if (mPlayer != nullptr)
 	{
@@ -479,6 +894,8 @@ void MusicManager::playCurrent()
 		return;
 	}
 
+	mPlayRequestTick = SDL_GetTicks();
+
 	libvlc_media_t* media = libvlc_media_new_path(mVLC, path.c_str());
 	if (media == nullptr)
 	{
@@ -487,27 +904,8 @@ void MusicManager::playCurrent()
 		return;
 	}
 
-	// ID3/Vorbis 태그 등에서 실제 곡 제목 파싱 시도 (동기 호출 - deprecated API지만
-	// 로컬 파일은 즉시 반환됨). MIDI는 표준 메타데이터가 없어 libvlc가 파일명을
-	// 그대로 Title로 돌려주므로, 그 경우엔 태그가 "없는" 것으로 보고 아래에서
-	// SMF 내부 메타 텍스트(트랙명/마커)를 직접 읽어보고, 그것도 없으면 stem으로 대체.
-	libvlc_media_parse(media);
-	const char* tagTitle = libvlc_media_get_meta(media, libvlc_meta_Title);
-	// libvlc의 내부 ID3v2 파서가 일부 인코딩(특히 한자 포함 일본어 태그)에서
-	// 깨진 바이트열을 돌려주는 사례가 있음(실기기 확인, ffmpeg로는 정상 읽힘) -
-	// SMF 경로(readSmfTitle)와 동일하게 isValidUtf8()로 걸러서, 깨진 값이면
-	// "태그 없음"과 동일하게 취급해 stem으로 대체한다.
-	if (tagTitle != nullptr && tagTitle[0] != '\0' && Utils::FileSystem::getFileName(path) != tagTitle
-		&& isValidUtf8(tagTitle))
-	{
-		mCurrentTitle = tagTitle;
-	}
-	else
-	{
-		std::string ext = Utils::String::toLower(Utils::FileSystem::getExtension(path));
-		std::string smfTitle = (ext == ".mid" || ext == ".midi") ? readSmfTitle(path) : "";
-		mCurrentTitle = !smfTitle.empty() ? smfTitle : Utils::FileSystem::getStem(path);
-	}
+	// 인덱스에 있는 곡은 동기 태그 파싱 없이 바로 재생 - 곡 전환 지연의 대부분이 여기였음
+	mCurrentTitle = resolveTrackTitle(path, media, nullptr);
 
 	// media 는 player 에 연결된 뒤 release 가능
 	mPlayer = libvlc_media_player_new_from_media(media);
@@ -521,6 +919,225 @@ void MusicManager::playCurrent()
 	}
 
 	libvlc_media_player_play(mPlayer);
+	updateVolume();
 	mPlaying = true;
 	LOG(LogInfo) << "MusicManager: 재생 시작 - " << path;
 }
+
+// 트랙 하나를 덱으로 열고 바로 디코딩 시작. 출력은 VLC 오디오 콜백 → 덱 링버퍼.
+MusicManager::Deck* MusicManager::createDeck(size_t index)
+{
+	Deck* deck = new Deck();
+	deck->path = mPlaylist[index];
+	deck->startTick = SDL_GetTicks();
+	deck->switchFromTick = deck->startTick;
+	deck->cpuStartMs = processCpuMs();
+
+	libvlc_media_t* media = (mVLC != nullptr) ? libvlc_media_new_path(mVLC, deck->path.c_str()) : nullptr;
+	if (media == nullptr)
+	{
+		LOG(LogError) << "MusicManager: media 생성 실패 - " << deck->path;
+		deck->title = Utils::FileSystem::getStem(deck->path);
+		deck->ended = true;
+		return deck;
+	}
+
+	int durationMs = 0;
+	deck->title = resolveTrackTitle(deck->path, media, &durationMs);
+	deck->totalFrames = (long long)durationMs * AudioManager::OUTPUT_FREQUENCY / 1000;
+
+	deck->player = libvlc_media_player_new_from_media(media);
+	libvlc_media_release(media);
+
+	if (deck->player == nullptr)
+	{
+		LOG(LogError) << "MusicManager: media player 생성 실패 - " << deck->path;
+		deck->ended = true;
+		return deck;
+	}
+
+	libvlc_audio_set_callbacks(deck->player, onDeckPlay, nullptr, nullptr, nullptr, onDeckDrain, deck);
+	libvlc_audio_set_format(deck->player, "S16N", AudioManager::OUTPUT_FREQUENCY, AudioManager::OUTPUT_CHANNELS);
+	libvlc_media_player_play(deck->player);
+	LOG(LogInfo) << "MusicManager: 디코딩 시작(믹서 경유) - " << deck->path;
+	return deck;
+}
+
+void MusicManager::destroyDeck(Deck* deck)
+{
+	// 콜백 대기 루프를 먼저 풀어줘야 stop()이 VLC 오디오 스레드 join에서 막히지 않음
+	deck->alive.store(false, std::memory_order_release);
+	if (deck->player != nullptr)
+	{
+		libvlc_media_player_stop(deck->player);
+		libvlc_media_player_release(deck->player);
+	}
+	delete deck;
+}
+
+void MusicManager::logDeckStats(Deck* deck)
+{
+	const unsigned int wallMs = SDL_GetTicks() - deck->startTick;
+	if (wallMs == 0)
+		return;
+
+	mLastTrackCpuPercent = (float)((processCpuMs() - deck->cpuStartMs) * 100.0 / wallMs);
+	LOG(LogInfo) << "MusicManager: 트랙 통계 - " << deck->title << " 디코드 " << deck->decodedFrames.load() / AudioManager::OUTPUT_FREQUENCY
+		<< "s / 재생 " << wallMs / 1000 << "s, 프로세스 CPU " << mLastTrackCpuPercent.load() << "%, 누적 언더런 " << mUnderruns.load();
+}
+
+void MusicManager::startStreamThread()
+{
+	if (mStreamRunning)
+		return;
+
+	mStreamRunning = true;
+	mStreamThread = std::thread(&MusicManager::streamLoop, this);
+}
+
+void MusicManager::stopStreamThread()
+{
+	mStreamRunning = false;
+	if (mStreamThread.joinable())
+		mStreamThread.join();
+}
+
+// 스트림 스레드: AudioManager 음악 링버퍼에 자리가 나는 대로 덱들을 섞어서 채운다.
+// 디코딩은 VLC 스레드가 덱 버퍼에 미리 해두므로 여기서는 복사/크로스페이드만 한다.
+void MusicManager::streamLoop()
+{
+	std::vector<Sint16> block(STREAM_BLOCK_FRAMES * AudioManager::OUTPUT_CHANNELS);
+
+	while (mStreamRunning)
+	{
+		if (AudioManager::getMusicFreeFrames() < STREAM_BLOCK_FRAMES)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			continue;
+		}
+
+		size_t frames;
+		int switchLatencyMs = -1;
+		{
+			std::lock_guard<std::mutex> lock(mDeckMutex);
+			frames = mixDecks(block.data(), STREAM_BLOCK_FRAMES, switchLatencyMs);
+		}
+
+		// 로그는 락 밖에서 - 메인 스레드의 덱 교체를 붙잡지 않게
+		if (switchLatencyMs >= 0)
+			LOG(LogDebug) << "MusicManager: 트랙 전환 지연 " << switchLatencyMs << "ms";
+
+		if (frames == 0)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			continue;
+		}
+
+		AudioManager::writeMusic(block.data(), frames);
+	}
+}
+
+static void readDeck(MusicManager::Deck* deck, Sint16* out, unsigned int frames)
+{
+	unsigned int tail = deck->tail.load(std::memory_order_relaxed);
+	for (unsigned int done = 0; done < frames; )
+	{
+		const unsigned int index = (tail + done) & (DECK_BUFFER_FRAMES - 1);
+		const unsigned int run = std::min(frames - done, DECK_BUFFER_FRAMES - index);
+		memcpy(out + done * AudioManager::OUTPUT_CHANNELS, &deck->ring[index * AudioManager::OUTPUT_CHANNELS],
+			run * AudioManager::OUTPUT_CHANNELS * sizeof(Sint16));
+		done += run;
+	}
+	deck->tail.store(tail + frames, std::memory_order_release);
+	deck->consumedFrames.fetch_add(frames, std::memory_order_relaxed);
+}
+
+// mDeckMutex를 잡은 상태로 스트림 스레드에서 호출. 현재 덱이 끝나면 같은 블록 안에서
+// 바로 다음 덱으로 이어 붙이고(gapless), MusicCrossfade 구간에서는 두 덱을 선형으로 섞는다.
+size_t MusicManager::mixDecks(Sint16* out, size_t frames, int& switchLatencyMs)
+{
+	static Sint16 fadeIn[STREAM_BLOCK_FRAMES * AudioManager::OUTPUT_CHANNELS];
+	const long long fadeFrames = (long long)getCrossfadeMs() * AudioManager::OUTPUT_FREQUENCY / 1000;
+	size_t produced = 0;
+
+	while (produced < frames && mCurrentDeck != nullptr)
+	{
+		Deck* current = mCurrentDeck;
+		const unsigned int available = current->available();
+
+		if (available == 0)
+		{
+			if (current->ended.load(std::memory_order_acquire))
+			{
+				// 현재 곡 끝 - 메인 스레드가 해제하도록 넘기고 다음 덱으로 이어감
+				mRetiredDecks.push_back(current);
+				mCurrentDeck = mNextDeck;
+				mNextDeck = nullptr;
+				if (mCurrentDeck != nullptr && mCurrentDeck->firstFrameTick == 0)
+					mCurrentDeck->switchFromTick = SDL_GetTicks();
+				continue;
+			}
+
+			// 이미 재생 중인 덱이 비었으면 디코딩이 못 따라온 것
+			if (current->firstFrameTick != 0)
+				++mUnderruns;
+			break;
+		}
+
+		unsigned int n = (unsigned int)std::min(frames - produced, (size_t)available);
+		const long long remaining = current->totalFrames.load() - current->consumedFrames.load();
+		Deck* next = mNextDeck;
+		bool fading = (next != nullptr && fadeFrames > 0 && remaining > 0 && remaining <= fadeFrames);
+		if (fading)
+		{
+			// 두 덱 모두 준비된 만큼만 섞고 나머지는 다음 차례로 넘김 - 다음 덱이 늦어도 페이드 위치가
+			// 어긋나지 않게. 다음 덱이 아무것도 없이 끝났으면 페이드 없이 현재 곡을 끝까지
+			const unsigned int ready = next->available();
+			if (ready == 0 && !next->ended.load(std::memory_order_acquire))
+			{
+				++mUnderruns;
+				break;
+			}
+
+			if (ready == 0)
+				fading = false;
+			else
+				n = (unsigned int)std::min((long long)std::min(n, ready), remaining);
+		}
+
+		Sint16* dst = out + produced * AudioManager::OUTPUT_CHANNELS;
+		readDeck(current, dst, n);
+
+		if (current->firstFrameTick == 0)
+		{
+			current->firstFrameTick = SDL_GetTicks();
+			mLastSwitchLatencyMs = (int)(current->firstFrameTick - current->switchFromTick);
+			switchLatencyMs = mLastSwitchLatencyMs;
+		}
+
+		if (fading)
+		{
+			readDeck(next, fadeIn, n);
+			if (next->firstFrameTick == 0)
+			{
+				next->firstFrameTick = SDL_GetTicks();
+				mLastSwitchLatencyMs = 0; // 겹쳐서 재생되므로 공백 없음
+			}
+
+			for (unsigned int i = 0; i < n; i++)
+			{
+				const float fade = (float)(remaining - i) / (float)fadeFrames;
+				for (int c = 0; c < AudioManager::OUTPUT_CHANNELS; c++)
+				{
+					const int idx = i * AudioManager::OUTPUT_CHANNELS + c;
+					const float v = dst[idx] * fade + fadeIn[idx] * (1.0f - fade);
+					dst[idx] = (Sint16)std::max(-32768.0f, std::min(32767.0f, v));
+				}
+			}
+		}
+
+		produced += n;
+	}
+
+	return produced;
+}
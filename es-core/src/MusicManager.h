@@ -2,16 +2,28 @@
 #ifndef ES_CORE_MUSIC_MANAGER_H
 #define ES_CORE_MUSIC_MANAGER_H
 
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 // libvlc 전방 선언 — vlc.h 는 MusicManager.cpp 에서만 include
 struct libvlc_instance_t;
 struct libvlc_media_player_t;
+struct libvlc_media_t;
 
 // 배경 음악(BGM) 재생 싱글턴. <share>/music 폴더를 스캔해 셔플 재생한다.
-// 모든 호출은 메인 스레드에서만 일어난다 (mutex 불필요).
+// 공개 함수는 모두 메인 스레드에서만 호출된다.
+//
+// 재생 경로는 두 가지:
+//  - VLC 자체 출력(기본): 트랙마다 media player 하나, update()에서 종료 폴링 후 다음 곡.
+//  - 믹서 경유(MixBackgroundMusic): 트랙 하나 = 덱(Deck) 하나. VLC가 디코딩한 PCM을
+//    덱 링버퍼에 미리 쌓아두고, 스트림 스레드가 현재/다음 덱을 섞어(MusicCrossfade)
+//    AudioManager 음악 링버퍼로 넘긴다. 다음 곡은 끝나기 전에 미리 디코딩을 시작하므로
+//    곡 사이 공백이 없다(gapless). 덱 포인터는 mDeckMutex로 보호.
 class MusicManager
 {
 	static std::shared_ptr<MusicManager> sInstance;
@@ -19,19 +31,57 @@ class MusicManager
 	MusicManager();
 
 public:
+	// 전환 지연/디코드 부하 측정값 - 로그에도 트랙마다 남는다
+	struct Stats
+	{
+		int lastSwitchLatencyMs;   // 이전 곡 끝(또는 재생 요청) → 새 곡 첫 샘플까지
+		unsigned int underruns;    // 믹서 경유 시 덱이 비어서 못 채운 블록 수(누적)
+		float lastTrackCpuPercent; // 직전 곡 재생 동안 프로세스 CPU 사용률(디코드 부하 근사)
+	};
+
 	static std::shared_ptr<MusicManager>& getInstance();
 
 	void start();   // 음악 폴더 스캔→셔플→첫 곡 재생. BackgroundMusic=false거나 파일 없으면 no-op
 	void stop();    // 재생 중지 + media player 해제 (libvlc 인스턴스는 유지)
-	void update();  // 매 프레임 호출: 트랙 종료(libvlc_Ended) 감지 시 다음 곡 재생
+	void update();  // 매 프레임 호출: 트랙 종료 감지/다음 곡 예열/다 쓴 덱 해제
 	bool isPlaying() const;
 	std::string getCurrentTrackTitle() const; // 재생 중 아니거나 playlist 비었으면 빈 문자열
+	void updateVolume(); // MusicVolume 설정 변경 즉시 반영 (믹서 경유면 AudioManager 게인)
+	Stats getStats() const;
+
+	// 트랙 하나의 디코드 버퍼 - VLC 오디오 콜백(MusicManager.cpp)에서 직접 접근하므로 공개 선언만 둔다
+	struct Deck;
 
 	virtual ~MusicManager(); // stop + libvlc 인스턴스 해제
 
 private:
+	// 제목 인덱스 항목 - 크기/mtime이 그대로면 파일(SMF 파싱, 태그 파싱)을 다시 읽지 않는다
+	struct TrackInfo
+	{
+		long long size;
+		long long mtime;
+		std::string title;
+		int durationMs; // 모르면 0
+	};
+
 	void shufflePlaylist();
+	void advanceIndex();
 	void playCurrent();
+	void scanMusicDirectory(const std::string& musicDir, bool midiOk);
+
+	std::string resolveTrackTitle(const std::string& path, libvlc_media_t* media, int* durationMs);
+	void loadIndex();
+	void saveIndex();
+
+	// 믹서 경유 경로
+	Deck* createDeck(size_t index);
+	void destroyDeck(Deck* deck);
+	void startStreamThread();
+	void stopStreamThread();
+	void streamLoop();
+	// switchLatencyMs: 이번 블록에서 첫 프레임을 낸 덱의 전환 지연(없으면 -1) - 로그는 호출한 쪽이 락 밖에서
+	size_t mixDecks(short* out, size_t frames, int& switchLatencyMs);
+	void logDeckStats(Deck* deck);
 
 	libvlc_instance_t* mVLC;
 	libvlc_media_player_t* mPlayer;
@@ -39,6 +89,7 @@ private:
 	size_t mCurrentIndex;
 	bool mPlaying;
 	bool mSoundfontActive; // --soundfont 적용 성공 여부 (MIDI 재생 가능)
+	bool mMixed; // 현재 트랙을 AudioManager 믹서로 출력 중 (MixBackgroundMusic)
 	std::string mCurrentTitle; // 태그(ID3 등)에서 읽은 제목, 없으면 파일명(stem)
 
 	// 2026-07-11: MIDI 하드웨어 출력(예: MT-32 신디사이저) - 설정돼 있으면
@@ -46,6 +97,31 @@ private:
 	// 하드웨어 포트에 그대로 원본 MIDI를 흘려보냄. mp3/ogg 등은 그대로 VLC.
 	int mMidiPid; // aplaymidi 자식 프로세스 PID, 없으면 -1
 	bool playCurrentViaHardwareMidi(const std::string& path);
+
+	// 제목 인덱스(~/.emulationstation/music_index.xml)와 폴더 스캔 캐시
+	std::map<std::string, TrackInfo> mIndex;
+	bool mIndexLoaded;
+	bool mIndexDirty;
+	std::string mScannedDir;
+	long long mScannedDirMtime;
+	bool mScannedMidiOk;
+	std::vector<std::string> mScannedFiles;
+
+	// 덱/스트림 스레드 상태
+	mutable std::mutex mDeckMutex;
+	Deck* mCurrentDeck;
+	Deck* mNextDeck;
+	std::vector<Deck*> mRetiredDecks; // 스트림 스레드가 다 쓴 덱 - libvlc 해제는 update()에서
+	std::thread mStreamThread;
+	std::atomic<bool> mStreamRunning;
+
+	// 측정값 (VLC 자체 출력 경로의 전환 지연은 update()에서 Playing 상태로 판정)
+	std::atomic<int> mLastSwitchLatencyMs;
+	std::atomic<unsigned int> mUnderruns;
+	std::atomic<float> mLastTrackCpuPercent;
+	unsigned int mPlayRequestTick; // 0이면 측정 완료
+	unsigned int mTrackStartTick;
+	double mTrackCpuStartMs;
 };
 
 #endif // ES_CORE_MUSIC_MANAGER_H
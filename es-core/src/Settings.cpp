@@ -38,7 +38,8 @@ std::vector<const char*> settings_dont_save {
 	"ScreenOffsetX",
 	"ScreenOffsetY",
 	"ScreenRotate",
-	"MonitorID"
+	"MonitorID",
+	"ScraperBaseUrl"
 };
 
 Settings::Settings()
@@ -82,6 +83,13 @@ void Settings::setDefaults()
 	mBoolMap["EnableSounds"] = true;
 	// 배경 음악(BGM): <share>/music 폴더의 음악 파일을 셔플 재생 (MusicManager)
 	mBoolMap["BackgroundMusic"] = true;
+	// 효과음/배경음악 볼륨(%) - AudioManager 믹서의 보이스별 게인에 곱해짐
+	mIntMap["SoundVolume"] = 100;
+	mIntMap["MusicVolume"] = 100;
+	// 배경음악을 VLC 자체 출력 대신 AudioManager 믹서(SDL 장치 하나)로 섞어서 출력
+	mBoolMap["MixBackgroundMusic"] = false;
+	// 믹서 경유 시 곡 사이 크로스페이드 길이(ms), 0이면 공백 없이 바로 이어붙임(gapless)
+	mIntMap["MusicCrossfade"] = 0;
 	// 메뉴 조작 시 패드 진동 피드백 (InputManager::rumble)
 	mBoolMap["MenuRumble"] = true;
 	// 메뉴 진동 세기(%) - 컨트롤러 설정 슬라이더로 조절
@@ -109,17 +117,26 @@ void Settings::setDefaults()
 	mBoolMap["SystemSleepTimeHintDisplayed"] = false;
 	mIntMap["ScraperResizeWidth"] = 400;
 	mIntMap["ScraperResizeHeight"] = 0;
+	// RetroPangui: 스크랩한 이미지로 함께 만들 썸네일 너비, 0이면 안 만듦
+	mIntMap["ScraperThumbnailWidth"] = 0;
 	#ifdef _RPI_
 		mIntMap["MaxVRAM"] = 80;
 	#else
 		mIntMap["MaxVRAM"] = 100;
 	#endif
+	// RetroPangui: 게임 실행 중 RAM에 남겨 둘 디코딩된 텍스처/폰트 아틀라스 한도(MB), 0이면 전부 해제
+	mIntMap["ResumeCacheMB"] = 64;
 
 	// RetroPangui: instant 기본 — fade는 시스템 전환 시 블랙 플래시 유발
 	mStringMap["TransitionStyle"] = "instant";
 	mStringMap["ThemeSet"] = "";
 	mStringMap["ScreenSaverBehavior"] = "dim";
 	mStringMap["Scraper"] = "TheGamesDB";
+	// RetroPangui: 배치 스크래퍼 동시 작업 수, 목 서버 주소(--scraper-url, 저장 안 함)
+	mIntMap["ScraperConcurrency"] = 4;
+	// RetroPangui: 스크래퍼 검색 결과 캐시 유효 기간(일), 0이면 캐시 안 씀
+	mIntMap["ScraperCacheDays"] = 30;
+	mStringMap["ScraperBaseUrl"] = "";
 	mStringMap["GamelistViewStyle"] = "automatic";
 	// RetroPangui: always 기본 — never면 playcount/lastplayed가 gamelist.xml에 기록되지 않고,
 	// on exit은 전원을 바로 끄는 기기에서 저장 시점이 보장되지 않음
@@ -277,6 +294,12 @@ void saveMap(pugi::xml_document& doc, std::map<K, V>& map, const char* type)
 
 void Settings::saveFile()
 {
+	if(!mDirty)
+	{
+		LOG(LogDebug) << "Settings::saveFile() : no changes, skipping.";
+		return;
+	}
+
 	LOG(LogDebug) << "Settings::saveFile() : Saving Settings to file.";
 	const std::string path = Utils::FileSystem::getHomePath() + "/.emulationstation/es_settings.cfg";
 
@@ -308,7 +331,13 @@ void Settings::saveFile()
 		}
 	}
 
-	doc.save_file(path.c_str());
+	if(!doc.save_file(path.c_str()))
+	{
+		// mDirty는 그대로 - 다음 saveFile()에서 다시 시도
+		LOG(LogError) << "Settings::saveFile() : could not write \"" << path << "\"";
+		return;
+	}
+	mDirty = false;
 
 	// retropangui.conf 에 있던 emulationstation.* 키도 현재 값으로 동기화
 	saveRetropanguiConf();
@@ -362,6 +391,9 @@ void Settings::loadFile()
 		}
 	}
 
+	// 방금 읽은 파일과 메모리가 같으므로 다음 변경 전까지는 다시 쓸 필요 없음 -
+	// 단 옛 이름을 새 이름으로 바꿨으면 processBackwardCompatibility()가 다시 표시해서 바뀐 이름이 저장되게 함
+	mDirty = false;
 	processBackwardCompatibility();
 }
 
@@ -541,7 +573,48 @@ void Settings::saveRetropanguiConf()
 
 void Settings::setMap(const std::string& key, const std::map<std::string, int>& map)
 {
+	auto it = mMapIntMap.find(key);
+	if(it != mMapIntMap.cend() && it->second == map)
+		return;
+
 	mMapIntMap[key] = map;
+	onChanged(key);
+}
+
+int Settings::addChangeCallback(const std::string& name, const ChangeCallback& callback)
+{
+	ChangeListener listener;
+	listener.id = mNextListenerId++;
+	listener.name = name;
+	listener.callback = callback;
+	mChangeListeners.push_back(listener);
+	return listener.id;
+}
+
+void Settings::removeChangeCallback(int id)
+{
+	for(auto it = mChangeListeners.begin(); it != mChangeListeners.end(); it++)
+	{
+		if(it->id == id)
+		{
+			mChangeListeners.erase(it);
+			return;
+		}
+	}
+}
+
+void Settings::onChanged(const std::string& name)
+{
+	mDirty = true;
+
+	// 콜백 안에서 등록/해제할 수 있으므로 복사본으로
+	std::vector<ChangeCallback> callbacks;
+	for(auto it = mChangeListeners.cbegin(); it != mChangeListeners.cend(); it++)
+		if(it->name == name)
+			callbacks.push_back(it->callback);
+
+	for(auto it = callbacks.cbegin(); it != callbacks.cend(); it++)
+		(*it)();
 }
 
 const std::map<std::string, int> Settings::getMap(const std::string& key)
@@ -564,6 +637,7 @@ void Settings::renameSetting(Map& map, std::string&& oldName, std::string&& newN
 	if (it != map.end()) {
 		map[newName] = it->second;
 		map.erase(it);
+		mDirty = true;
 	}
 }
 
@@ -574,6 +648,7 @@ void Settings::processBackwardCompatibility()
 		if (it != mBoolMap.end()) {
 			mStringMap["SaveGamelistsMode"] = it->second ? "on exit" : "never";
 			mBoolMap.erase(it);
+			mDirty = true;
 		}
 	}
 
@@ -596,10 +671,28 @@ void Settings::processBackwardCompatibility()
 } \
 void Settings::setMethodName(const std::string& name, type value) \
 { \
+	auto it = mapName.find(name); \
+	if(it != mapName.cend() && it->second == value) \
+		return; \
 	mapName[name] = value; \
+	onChanged(name); \
 }
 
 SETTINGS_GETSET(bool, mBoolMap, getBool, setBool);
 SETTINGS_GETSET(int, mIntMap, getInt, setInt);
 SETTINGS_GETSET(float, mFloatMap, getFloat, setFloat);
 SETTINGS_GETSET(const std::string&, mStringMap, getString, setString);
+
+#define SETTINGS_GETREF(type, mapName) template<> const type& Settings::getRef<type>(const std::string& name) \
+{ \
+	if(mapName.find(name) == mapName.cend()) \
+	{ \
+		LOG(LogError) << "Tried to use unset setting " << name << "!"; \
+	} \
+	return mapName[name]; \
+}
+
+SETTINGS_GETREF(bool, mBoolMap);
+SETTINGS_GETREF(int, mIntMap);
+SETTINGS_GETREF(float, mFloatMap);
+SETTINGS_GETREF(std::string, mStringMap);
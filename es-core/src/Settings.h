@@ -2,9 +2,11 @@
 #ifndef ES_CORE_SETTINGS_H
 #define ES_CORE_SETTINGS_H
 
+#include <functional>
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 //This is a singleton for storing settings.
 class Settings
@@ -30,6 +32,15 @@ public:
 	void setString(const std::string& name, const std::string& value);
 	void setMap(const std::string& name, const std::map<std::string, int>& map);
 
+	// RetroPangui: 값의 주소 - std::map 노드는 다른 키가 추가돼도 옮겨지지 않으므로 계속 유효하다.
+	// 직접 쓰지 말고 SettingHandle로
+	template<typename T> const T& getRef(const std::string& name);
+
+	// 값이 실제로 바뀐 set*() 뒤에만 불림. 반환값은 removeChangeCallback()용 id
+	typedef std::function<void()> ChangeCallback;
+	int addChangeCallback(const std::string& name, const ChangeCallback& callback);
+	void removeChangeCallback(int id);
+
 private:
 	static Settings* sInstance;
 
@@ -40,6 +51,7 @@ private:
 	void processBackwardCompatibility();
 	template<typename Map>
 	void renameSetting(Map& map, std::string&& oldName, std::string&& newName);
+	void onChanged(const std::string& name);
 
 	std::map<std::string, bool> mBoolMap;
 	std::map<std::string, int> mIntMap;
@@ -51,6 +63,51 @@ private:
 	std::set<std::string> mRetropanguiKeys;
 	// loadRetropanguiConf() 완료 전에는 saveRetropanguiConf()가 덮어쓰지 않도록
 	bool mRetropanguiConfLoaded = false;
+
+	// 마지막 saveFile() 이후 바뀐 값이 있는지 - 메뉴마다 닫힐 때 부르는 saveFile()을 변경 없으면 건너뜀
+	bool mDirty = false;
+
+	struct ChangeListener
+	{
+		int id;
+		std::string name;
+		ChangeCallback callback;
+	};
+	std::vector<ChangeListener> mChangeListeners;
+	int mNextListenerId = 1;
 };
 
+template<> const bool& Settings::getRef<bool>(const std::string& name);
+template<> const int& Settings::getRef<int>(const std::string& name);
+template<> const float& Settings::getRef<float>(const std::string& name);
+template<> const std::string& Settings::getRef<std::string>(const std::string& name);
+
+// RetroPangui: 설정 하나에 대한 타입 있는 핸들. 처음 읽을 때 한 번만 이름으로 찾고 그다음부터는
+// 값을 바로 읽는다 - 매 프레임/항목마다 읽는 설정은 함수 안 static 핸들로 읽을 것.
+//   static BoolSetting drawFramerate("DrawFramerate");
+//   if(drawFramerate.get()) ...
+// UI 스레드 전용(값은 set*()가 그 자리에서 바꿈).
+template<typename T>
+class SettingHandle
+{
+public:
+	explicit SettingHandle(const char* name) : mName(name), mValue(nullptr) {}
+
+	const T& get()
+	{
+		if(mValue == nullptr)
+			mValue = &Settings::getInstance()->getRef<T>(mName);
+		return *mValue;
+	}
+
+private:
+	const char* mName;
+	const T* mValue;
+};
+
+typedef SettingHandle<bool> BoolSetting;
+typedef SettingHandle<int> IntSetting;
+typedef SettingHandle<float> FloatSetting;
+typedef SettingHandle<std::string> StringSetting;
+
 #endif // ES_CORE_SETTINGS_H
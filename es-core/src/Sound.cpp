@@ -4,6 +4,7 @@
 #include "Log.h"
 #include "Settings.h"
 #include "ThemeData.h"
+#include <algorithm>
 
 std::map< std::string, std::shared_ptr<Sound> > Sound::sMap;
 
@@ -24,16 +25,16 @@ std::shared_ptr<Sound> Sound::getFromTheme(const std::shared_ptr<ThemeData>& the
 	LOG(LogInfo) << " req sound [" << view << "." << element << "]";
 
 	const ThemeData::ThemeElement* elem = theme->getElement(view, element, "sound");
-	if(!elem || !elem->has("path"))
+	if(!elem || !elem->has(ThemeProperty::PATH))
 	{
 		LOG(LogInfo) << "   (missing)";
 		return get("");
 	}
 
-	return get(elem->get<std::string>("path"));
+	return get(elem->get<std::string>(ThemeProperty::PATH));
 }
 
-Sound::Sound(const std::string & path) : mSampleData(NULL), mSamplePos(0), mSampleLength(0), playing(false)
+Sound::Sound(const std::string & path) : mSampleData(NULL), mSampleCount(0), mGain(16384), mPending(false), mActiveVoices(0)
 {
 	loadFile(path);
 }
@@ -60,51 +61,43 @@ void Sound::init()
 	//load wav file via SDL
 	SDL_AudioSpec wave;
 	Uint8 * data = NULL;
-    Uint32 dlen = 0;
+	Uint32 dlen = 0;
 	if (SDL_LoadWAV(mPath.c_str(), &wave, &data, &dlen) == NULL) {
 		LOG(LogError) << "Error loading sound \"" << mPath << "\"!\n" << "	" << SDL_GetError();
 		return;
 	}
-	//build conversion buffer
+	//build conversion buffer. resample to the device format once here so the mixer only has to add
 	SDL_AudioCVT cvt;
-    SDL_BuildAudioCVT(&cvt, wave.format, wave.channels, wave.freq, AUDIO_S16, 2, 44100);
+	SDL_BuildAudioCVT(&cvt, wave.format, wave.channels, wave.freq, AUDIO_S16, AudioManager::OUTPUT_CHANNELS, AudioManager::OUTPUT_FREQUENCY);
 	//copy data to conversion buffer
 	cvt.len = dlen;
-    cvt.buf = new Uint8[cvt.len * cvt.len_mult];
-    memcpy(cvt.buf, data, dlen);
+	cvt.buf = new Uint8[cvt.len * cvt.len_mult];
+	memcpy(cvt.buf, data, dlen);
 	//convert buffer to stereo, 16bit, 44.1kHz
-    if (SDL_ConvertAudio(&cvt) < 0) {
+	if (SDL_ConvertAudio(&cvt) < 0) {
 		LOG(LogError) << "Error converting sound \"" << mPath << "\" to 44.1kHz, 16bit, stereo format!\n" << "	" << SDL_GetError();
 		delete[] cvt.buf;
 	}
 	else {
-		//worked. set up member data
-		SDL_LockAudio();
-		mSampleData = cvt.buf;
-		mSampleLength = cvt.len_cvt;
-		mSamplePos = 0;
-		mSampleFormat.channels = 2;
-		mSampleFormat.freq = 44100;
-		mSampleFormat.format = AUDIO_S16;
-		SDL_UnlockAudio();
+		//worked. set up member data. the mixer can't see this sound before play() so no locking needed
+		mSampleData = (Sint16*)cvt.buf;
+		mSampleCount = cvt.len_cvt / sizeof(Sint16);
 	}
 	//free wav data now
-    SDL_FreeWAV(data);
+	SDL_FreeWAV(data);
 }
 
 void Sound::deinit()
 {
-	playing = false;
-
 	if(mSampleData != NULL)
 	{
-		SDL_LockAudio();
-		delete[] mSampleData;
+		//make sure no voice still reads from the buffer before freeing it
+		AudioManager::forgetSound(this);
+		delete[] (Uint8*)mSampleData;
 		mSampleData = NULL;
-		mSampleLength = 0;
-		mSamplePos = 0;
-		SDL_UnlockAudio();
+		mSampleCount = 0;
 	}
+	mPending = false;
 }
 
 void Sound::play()
@@ -115,67 +108,50 @@ void Sound::play()
 	if(!Settings::getInstance()->getBool("EnableSounds"))
 		return;
 
-	AudioManager::getInstance();
-
-	SDL_LockAudio();
-	if (playing)
-	{
-		//replay from start. rewind the sample to the beginning
-		mSamplePos = 0;
-
-	}
-	else
-	{
-		//flag our sample as playing
-		playing = true;
-	}
-	SDL_UnlockAudio();
-	//tell the AudioManager to start playing samples
-	AudioManager::getInstance()->play();
+	//queue the sound, the mixer restarts it from the beginning if it's already playing
+	std::shared_ptr<AudioManager>& audio = AudioManager::getInstance();
+	if(audio)
+		audio->playSound(this);
 }
 
 bool Sound::isPlaying() const
 {
-	return playing;
+	return mPending.load(std::memory_order_acquire) || mActiveVoices.load(std::memory_order_acquire) > 0;
 }
 
 void Sound::stop()
 {
-	//flag our sample as playing and rewind its position
-	SDL_LockAudio();
-	playing = false;
-	mSamplePos = 0;
-	SDL_UnlockAudio();
+	AudioManager::stopSound(this);
+	mPending = false;
 }
 
-const Uint8 * Sound::getData() const
+void Sound::setVolume(float volume)
+{
+	mGain.store((Sint32)(std::max(0.0f, std::min(1.0f, volume)) * 16384), std::memory_order_relaxed);
+}
+
+const Sint16 * Sound::getSamples() const
 {
 	return mSampleData;
 }
 
-Uint32 Sound::getPosition() const
+Uint32 Sound::getSampleCount() const
 {
-	return mSamplePos;
+	return mSampleCount;
 }
 
-void Sound::setPosition(Uint32 newPosition)
+Sint32 Sound::getGain() const
 {
-	mSamplePos = newPosition;
-	if (mSamplePos >= mSampleLength) {
-		//got to or beyond the end of the sample. stop playing
-		playing = false;
-		mSamplePos = 0;
-	}
+	return mGain.load(std::memory_order_relaxed);
 }
 
 Uint32 Sound::getLength() const
 {
-	return mSampleLength;
+	//in bytes, as before
+	return mSampleCount * sizeof(Sint16);
 }
 
 Uint32 Sound::getLengthMS() const
 {
-	//44100 samples per second, 2 channels (stereo)
-	//I have no idea why the *0.75 is necessary, but otherwise it's inaccurate
-	return (Uint32)((mSampleLength / 44100.0f / 2.0f * 0.75f) * 1000);
+	return (Uint32)((Uint64)mSampleCount * 1000 / (AudioManager::OUTPUT_FREQUENCY * AudioManager::OUTPUT_CHANNELS));
 }
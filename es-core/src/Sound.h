@@ -3,6 +3,7 @@
 #define ES_CORE_SOUND_H
 
 #include "SDL_audio.h"
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -11,12 +12,14 @@ class ThemeData;
 
 class Sound
 {
+	friend class AudioManager;
+
 	std::string mPath;
-    SDL_AudioSpec mSampleFormat;
-	Uint8 * mSampleData;
-    Uint32 mSamplePos;
-    Uint32 mSampleLength;
-	bool playing;
+	Sint16 * mSampleData;   // interleaved, already in the AudioManager output format
+	Uint32 mSampleCount;    // in samples (frames * channels)
+	std::atomic<Sint32> mGain; // Q14, 16384 = unity. set on the UI thread, read by the mixer
+	std::atomic<bool> mPending;     // play() queued, mixer hasn't started the voice yet
+	std::atomic<int> mActiveVoices; // maintained by the mixer
 
 public:
 	static std::shared_ptr<Sound> get(const std::string& path);
@@ -33,9 +36,12 @@ public:
 	bool isPlaying() const;
 	void stop();
 
-	const Uint8 * getData() const;
-	Uint32 getPosition() const;
-	void setPosition(Uint32 newPosition);
+	// 0.0 - 1.0, applied on top of the global SoundVolume setting the next time the sound starts
+	void setVolume(float volume);
+
+	const Sint16 * getSamples() const;
+	Uint32 getSampleCount() const;
+	Sint32 getGain() const;
 	Uint32 getLength() const;
 	Uint32 getLengthMS() const;
 
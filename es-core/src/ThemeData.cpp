@@ -6,13 +6,20 @@
 #include "math/Misc.h"
 #include "renderers/Renderer.h"
 #include "utils/FileSystemUtil.h"
+#include "utils/HashUtil.h"
 #include "utils/StringUtil.h"
 #include "Log.h"
 #include "platform.h"
 #include "Settings.h"
 #include <pugixml.hpp>
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sys/stat.h>
+#include <unordered_map>
 
 std::vector<std::string> ThemeData::sSupportedViews { { "system" }, { "basic" }, { "detailed" }, { "grid" }, { "video" } };
 std::vector<std::string> ThemeData::sSupportedFeatures { { "video" }, { "carousel" }, { "z-index" }, { "visible" } };
@@ -74,6 +81,7 @@ std::map<std::string, std::map<std::string, ThemeData::ElementPropertyType>> The
 		{ "lineSpacing", FLOAT },
 		{ "value", STRING },
 		{ "scrollable", BOOLEAN },
+		{ "updateInterval", FLOAT },
 		{ "visible", BOOLEAN },
 		{ "zIndex", FLOAT } } },
 	{ "textlist", {
@@ -225,10 +233,449 @@ std::string ThemeData::resolvePlaceholders(const char* in)
 	return prefix + mVariables[replace] + suffix;
 }
 
+// RetroPangui: interned property ids
+namespace
+{
+	const char* const PROPERTY_NAMES[ThemeProperty::COUNT] = {
+#define THEME_PROPERTY_NAME(id, name) name,
+		THEME_PROPERTY_LIST(THEME_PROPERTY_NAME)
+#undef THEME_PROPERTY_NAME
+	};
+
+	struct PropertyNameTable
+	{
+		std::unordered_map<std::string, ThemeProperty::Id> ids;
+
+		PropertyNameTable()
+		{
+			for(unsigned int i = 0; i < ThemeProperty::COUNT; i++)
+				ids[PROPERTY_NAMES[i]] = (ThemeProperty::Id)i;
+		}
+	};
+}
+
+ThemeProperty::Id ThemeProperty::fromName(const std::string& name)
+{
+	static const PropertyNameTable table;
+	auto it = table.ids.find(name);
+	return it != table.ids.cend() ? it->second : INVALID;
+}
+
+const char* ThemeProperty::getName(Id id)
+{
+	return id < COUNT ? PROPERTY_NAMES[id] : "";
+}
+
+bool ThemeData::checkPropertyIds()
+{
+	bool ok = true;
+	for(auto& type : sElementMap)
+	{
+		for(auto& property : type.second)
+		{
+			if(ThemeProperty::fromName(property.first) == ThemeProperty::INVALID)
+			{
+				LOG(LogError) << "Theme property \"" << property.first << "\" (" << type.first << ") is missing from THEME_PROPERTY_LIST";
+				ok = false;
+			}
+		}
+	}
+	return ok;
+}
+
+ThemeData::ThemeElement::ThemeElement() : extra(false)
+{
+	memset(mSlots, NO_SLOT, sizeof(mSlots));
+}
+
+ThemeData::ThemeElement::Property& ThemeData::ThemeElement::add(ThemeProperty::Id prop, Property::Kind kind)
+{
+	Property* property;
+	if(mSlots[prop] != NO_SLOT)
+	{
+		property = &mValues[mSlots[prop]];
+	}
+	else
+	{
+		mSlots[prop] = (unsigned char)mValues.size();
+		mValues.push_back(Property());
+		property = &mValues.back();
+	}
+
+	// a string property keeps its mStrings slot when it is overwritten
+	if(property->kind != Property::STRING || kind != Property::STRING)
+		memset(property->r, 0, sizeof(property->r));
+	property->kind = kind;
+	return *property;
+}
+
+void ThemeData::ThemeElement::set(ThemeProperty::Id prop, const Vector4f& value)
+{
+	Property& property = add(prop, Property::RECT);
+	property.r[0] = value.x();
+	property.r[1] = value.y();
+	property.r[2] = value.z();
+	property.r[3] = value.w();
+}
+
+void ThemeData::ThemeElement::set(ThemeProperty::Id prop, const Vector2f& value)
+{
+	Property& property = add(prop, Property::PAIR);
+	property.v[0] = value.x();
+	property.v[1] = value.y();
+}
+
+void ThemeData::ThemeElement::set(ThemeProperty::Id prop, const std::string& value)
+{
+	const bool reuse = has(prop) && getProperty(prop)->kind == Property::STRING;
+	Property& property = add(prop, Property::STRING);
+	if(reuse)
+	{
+		mStrings[property.s] = value;
+		return;
+	}
+
+	property.s = (unsigned int)mStrings.size();
+	mStrings.push_back(value);
+}
+
+void ThemeData::ThemeElement::set(ThemeProperty::Id prop, unsigned int value) { add(prop, Property::UINT).i = value; }
+void ThemeData::ThemeElement::set(ThemeProperty::Id prop, float value)        { add(prop, Property::FLOAT).f = value; }
+void ThemeData::ThemeElement::set(ThemeProperty::Id prop, bool value)         { add(prop, Property::BOOL).b = value; }
+
 ThemeData::ThemeData()
 {
+	static const bool propertyIdsChecked = checkPropertyIds();
+	(void)propertyIdsChecked;
+
 	mVersion = 0;
 	mResolution = { 1, 1 };
+	mCacheable = true;
+	mLoadedFromCache = false;
+}
+
+// RetroPangui: compiled theme cache.
+// Most system themes of a set include the same few files, so parsed documents are shared between
+// loadFile() calls (keyed by path + mtime/size) instead of being re-read for every system.
+// The compiled views are written to ~/.emulationstation/theme_cache/ as a small binary file
+// that lists every file it was built from; it is used as long as none of them changed.
+namespace
+{
+	const char         COMPILED_MAGIC[4] = { 'E', 'S', 'T', 'C' };
+	const unsigned int COMPILED_VERSION  = 2;
+
+	struct SharedDocument
+	{
+		std::shared_ptr<pugi::xml_document> doc;
+		long long mtime;
+		long long size;
+	};
+
+	std::mutex sDocumentCacheMutex;
+	std::map<std::string, SharedDocument> sDocumentCache;
+
+	bool getFileStamp(const std::string& path, long long& mtime, long long& size)
+	{
+		struct stat info;
+		if(stat(path.c_str(), &info) != 0)
+			return false;
+
+		mtime = (long long)info.st_mtime;
+		size = (long long)info.st_size;
+		return true;
+	}
+
+	template<typename T>
+	void writeValue(std::ostream& out, const T& value) { out.write((const char*)&value, sizeof(T)); }
+
+	template<typename T>
+	bool readValue(std::istream& in, T& value) { return (bool)in.read((char*)&value, sizeof(T)); }
+
+	void writeString(std::ostream& out, const std::string& value)
+	{
+		writeValue(out, (unsigned int)value.size());
+		out.write(value.data(), value.size());
+	}
+
+	bool readString(std::istream& in, std::string& value)
+	{
+		unsigned int size;
+		if(!readValue(in, size) || size > 1024 * 1024)
+			return false;
+
+		value.resize(size);
+		return size == 0 || (bool)in.read(&value[0], size);
+	}
+}
+
+std::shared_ptr<const pugi::xml_document> ThemeData::getDocument(const std::string& path, ThemeException& error)
+{
+	long long mtime = 0;
+	long long size = 0;
+	getFileStamp(path, mtime, size);
+	mDependencies.push_back(path);
+
+	{
+		std::unique_lock<std::mutex> lock(sDocumentCacheMutex);
+		auto it = sDocumentCache.find(path);
+		if(it != sDocumentCache.cend() && it->second.mtime == mtime && it->second.size == size)
+			return it->second.doc;
+	}
+
+	// parsed outside the lock so different files load in parallel - at worst two threads parse the same file once
+	std::shared_ptr<pugi::xml_document> doc = std::make_shared<pugi::xml_document>();
+	pugi::xml_parse_result res = doc->load_file(path.c_str());
+	if(!res)
+		throw error << "XML parsing error: \n    " << res.description();
+
+	std::unique_lock<std::mutex> lock(sDocumentCacheMutex);
+	SharedDocument& shared = sDocumentCache[path];
+	shared.doc = doc;
+	shared.mtime = mtime;
+	shared.size = size;
+	return doc;
+}
+
+void ThemeData::clearDocumentCache()
+{
+	std::unique_lock<std::mutex> lock(sDocumentCacheMutex);
+	sDocumentCache.clear();
+}
+
+std::string ThemeData::getCompiledPath(const std::string& path, const std::string& key)
+{
+	// key is part of the name - systems sharing one theme.xml (e.g. [set]/theme.xml) differ only by their variables
+	const std::string id = path + '\n' + key;
+	return Utils::FileSystem::getHomePath() + "/.emulationstation/theme_cache/" + Utils::Hash::crc32ToHex(Utils::Hash::crc32(id.data(), id.size())) + ".bin";
+}
+
+bool ThemeData::loadCompiled(const std::string& path, const std::string& key)
+{
+	std::ifstream in(getCompiledPath(path, key), std::ios::binary);
+	if(!in.good())
+		return false;
+
+	char magic[4];
+	unsigned int version;
+	std::string storedPath;
+	std::string storedKey;
+	if(!readValue(in, magic) || memcmp(magic, COMPILED_MAGIC, sizeof(magic)) != 0 || !readValue(in, version) || version != COMPILED_VERSION ||
+		!readString(in, storedPath) || storedPath != path || !readString(in, storedKey) || storedKey != key)
+		return false;
+
+	// every file the theme was built from must be unchanged
+	unsigned int count;
+	if(!readValue(in, count))
+		return false;
+
+	for(unsigned int i = 0; i < count; i++)
+	{
+		std::string depPath;
+		long long storedMtime, storedSize;
+		long long mtime = 0;
+		long long size = 0;
+		if(!readString(in, depPath) || !readValue(in, storedMtime) || !readValue(in, storedSize))
+			return false;
+		getFileStamp(depPath, mtime, size);
+		if(mtime != storedMtime || size != storedSize)
+			return false;
+	}
+
+	std::map<std::string, ThemeView> views;
+	float themeVersion;
+	Vector2f resolution;
+	if(!readValue(in, themeVersion) || !readValue(in, resolution.x()) || !readValue(in, resolution.y()) || !readValue(in, count))
+		return false;
+
+	for(unsigned int v = 0; v < count; v++)
+	{
+		std::string viewName;
+		unsigned int keyCount, elementCount;
+		if(!readString(in, viewName) || !readValue(in, keyCount))
+			return false;
+
+		ThemeView& view = views[viewName];
+		view.orderedKeys.resize(keyCount);
+		for(auto& orderedKey : view.orderedKeys)
+			if(!readString(in, orderedKey))
+				return false;
+
+		if(!readValue(in, elementCount))
+			return false;
+
+		for(unsigned int e = 0; e < elementCount; e++)
+		{
+			std::string elementName;
+			unsigned char extra;
+			unsigned int propertyCount;
+			if(!readString(in, elementName))
+				return false;
+
+			ThemeElement& element = view.elements[elementName];
+			if(!readString(in, element.type) || !readValue(in, extra) || !readValue(in, propertyCount))
+				return false;
+			element.extra = (extra != 0);
+
+			for(unsigned int p = 0; p < propertyCount; p++)
+			{
+				// stored by name, ids are only stable within one build
+				std::string name;
+				unsigned char kind;
+				if(!readString(in, name) || !readValue(in, kind))
+					return false;
+
+				const ThemeProperty::Id prop = ThemeProperty::fromName(name);
+				if(prop == ThemeProperty::INVALID)
+					return false;
+
+				switch(kind)
+				{
+				case ThemeElement::Property::RECT:
+				{
+					Vector4f value;
+					if(!readValue(in, value))
+						return false;
+					element.set(prop, value);
+					break;
+				}
+				case ThemeElement::Property::PAIR:
+				{
+					Vector2f value;
+					if(!readValue(in, value))
+						return false;
+					element.set(prop, value);
+					break;
+				}
+				case ThemeElement::Property::FLOAT:
+				{
+					float value;
+					if(!readValue(in, value))
+						return false;
+					element.set(prop, value);
+					break;
+				}
+				case ThemeElement::Property::STRING:
+				{
+					std::string value;
+					if(!readString(in, value))
+						return false;
+					element.set(prop, value);
+					break;
+				}
+				case ThemeElement::Property::UINT:
+				{
+					unsigned int value;
+					if(!readValue(in, value))
+						return false;
+					element.set(prop, value);
+					break;
+				}
+				case ThemeElement::Property::BOOL:
+				{
+					unsigned char value;
+					if(!readValue(in, value))
+						return false;
+					element.set(prop, value != 0);
+					break;
+				}
+				default:
+					return false;
+				}
+			}
+		}
+	}
+
+	mViews.swap(views);
+	mVersion = themeVersion;
+	mResolution = resolution;
+	return true;
+}
+
+void ThemeData::saveCompiled(const std::string& path, const std::string& key) const
+{
+	const std::string compiledPath = getCompiledPath(path, key);
+	const std::string dir = Utils::FileSystem::getParent(compiledPath);
+	if(!Utils::FileSystem::exists(dir))
+		Utils::FileSystem::createDirectory(dir);
+
+	// written to a temporary file first so a parallel load never sees half a file;
+	// the temporary name is unique per writer since themes are loaded on several threads
+	static std::atomic<unsigned int> sTempCounter(0);
+	const std::string tempPath = compiledPath + "." + std::to_string(sTempCounter++) + ".tmp";
+	std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+	if(!out.good())
+		return;
+
+	out.write(COMPILED_MAGIC, sizeof(COMPILED_MAGIC));
+	writeValue(out, COMPILED_VERSION);
+	writeString(out, path);
+	writeString(out, key);
+
+	writeValue(out, (unsigned int)mDependencies.size());
+	for(auto& dep : mDependencies)
+	{
+		long long mtime = 0;
+		long long size = 0;
+		getFileStamp(dep, mtime, size);
+		writeString(out, dep);
+		writeValue(out, mtime);
+		writeValue(out, size);
+	}
+
+	writeValue(out, mVersion);
+	writeValue(out, mResolution.x());
+	writeValue(out, mResolution.y());
+
+	writeValue(out, (unsigned int)mViews.size());
+	for(auto& view : mViews)
+	{
+		writeString(out, view.first);
+		writeValue(out, (unsigned int)view.second.orderedKeys.size());
+		for(auto& orderedKey : view.second.orderedKeys)
+			writeString(out, orderedKey);
+
+		writeValue(out, (unsigned int)view.second.elements.size());
+		for(auto& element : view.second.elements)
+		{
+			const ThemeElement& elem = element.second;
+			unsigned int propertyCount = 0;
+			for(unsigned int i = 0; i < ThemeProperty::COUNT; i++)
+				if(elem.has((ThemeProperty::Id)i))
+					propertyCount++;
+
+			writeString(out, element.first);
+			writeString(out, elem.type);
+			writeValue(out, (unsigned char)(elem.extra ? 1 : 0));
+			writeValue(out, propertyCount);
+
+			for(unsigned int i = 0; i < ThemeProperty::COUNT; i++)
+			{
+				const ThemeElement::Property* property = elem.getProperty((ThemeProperty::Id)i);
+				if(!property)
+					continue;
+
+				writeString(out, ThemeProperty::getName((ThemeProperty::Id)i));
+				writeValue(out, (unsigned char)property->kind);
+
+				switch(property->kind)
+				{
+				case ThemeElement::Property::RECT:   writeValue(out, property->r); break;
+				case ThemeElement::Property::PAIR:   writeValue(out, property->v); break;
+				case ThemeElement::Property::FLOAT:  writeValue(out, property->f); break;
+				case ThemeElement::Property::STRING: writeString(out, elem.getString(*property)); break;
+				case ThemeElement::Property::UINT:   writeValue(out, property->i); break;
+				case ThemeElement::Property::BOOL:   writeValue(out, (unsigned char)(property->b ? 1 : 0)); break;
+				}
+			}
+		}
+	}
+
+	out.close();
+	if(out.fail() || std::rename(tempPath.c_str(), compiledPath.c_str()) != 0)
+	{
+		LOG(LogWarning) << "Could not write compiled theme \"" << compiledPath << "\"";
+		Utils::FileSystem::removeFile(tempPath);
+	}
 }
 
 void ThemeData::loadFile(std::map<std::string, std::string> sysDataMap, const std::string& path)
@@ -245,15 +692,26 @@ void ThemeData::loadFile(std::map<std::string, std::string> sysDataMap, const st
 	mResolution = { 1, 1 };
 	mViews.clear();
 	mVariables.clear();
+	mDependencies.clear();
+	mCacheable = true;
+	mLoadedFromCache = false;
 
 	mVariables.insert(sysDataMap.cbegin(), sysDataMap.cend());
 
-	pugi::xml_document doc;
-	pugi::xml_parse_result res = doc.load_file(path.c_str());
-	if(!res)
-		throw error << "XML parsing error: \n    " << res.description();
+	// RetroPangui: everything outside the theme files that changes the compiled result
+	std::string cacheKey = "Language=" + Settings::getInstance()->getString("Language") + "\n";
+	for(auto it = sysDataMap.cbegin(); it != sysDataMap.cend(); ++it)
+		cacheKey += it->first + "=" + it->second + "\n";
+
+	if(loadCompiled(path, cacheKey))
+	{
+		mLoadedFromCache = true;
+		return;
+	}
+
+	std::shared_ptr<const pugi::xml_document> doc = getDocument(path, error);
 
-	pugi::xml_node root = doc.child("theme");
+	pugi::xml_node root = doc->child("theme");
 	if(!root)
 		throw error << "Missing <theme> tag!";
 
@@ -286,6 +744,9 @@ void ThemeData::loadFile(std::map<std::string, std::string> sysDataMap, const st
 	parseIncludes(root);
 	parseViews(root);
 	parseFeatures(root);
+
+	if(mCacheable)
+		saveCompiled(path, cacheKey);
 }
 
 void ThemeData::parseIncludes(const pugi::xml_node& root)
@@ -304,12 +765,9 @@ void ThemeData::parseIncludes(const pugi::xml_node& root)
 
 		mPaths.push_back(path);
 
-		pugi::xml_document includeDoc;
-		pugi::xml_parse_result result = includeDoc.load_file(path.c_str());
-		if(!result)
-			throw error << "Error parsing file: \n    " << result.description();
+		std::shared_ptr<const pugi::xml_document> includeDoc = getDocument(path, error);
 
-		pugi::xml_node theme = includeDoc.child("theme");
+		pugi::xml_node theme = includeDoc->child("theme");
 		if(!theme)
 			throw error << "Missing <theme> tag!";
 
@@ -389,6 +847,7 @@ void ThemeData::parseVariables(const pugi::xml_node& root)
 		pugi::xml_attribute execAttr = it->attribute("exec");
 		if(execAttr)
 		{
+			mCacheable = false;
 			std::string cmd = resolvePlaceholders(execAttr.value());
 			val = runShellCommandFirstLine(cmd);
 		}
@@ -481,6 +940,10 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 		if(typeIt == typeMap.cend())
 			throw error << "Unknown property type \"" << node.name() << "\" (for element of type " << root.name() << ").";
 
+		const ThemeProperty::Id prop = ThemeProperty::fromName(node.name());
+		if(prop == ThemeProperty::INVALID)
+			throw error << "Property \"" << node.name() << "\" has no property id (for element of type " << root.name() << ").";
+
 		// RetroPangui: lang 속성이 있는 노드는 현재 ES 언어(Settings의 Language)와
 		// 접두 매칭될 때만 적용한다. 언어 지정 없는 기본 노드는 항상 적용되므로,
 		// 테마 XML에서 기본(예: 한국어) 노드를 먼저 쓰고 lang="en" 노드를 뒤에
@@ -515,7 +978,7 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 					(float)atof(splits.at(2).c_str()), (float)atof(splits.at(3).c_str()));
 			}
 
-			element.properties[node.name()] = val / Vector4f(mResolution.x(), mResolution.y(), mResolution.x(), mResolution.y());
+			element.set(prop, val / Vector4f(mResolution.x(), mResolution.y(), mResolution.x(), mResolution.y()));
 			break;
 		}
 		case RESOLUTION_PAIR:
@@ -529,13 +992,13 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 
 			Vector2f val((float)atof(first.c_str()), (float)atof(second.c_str()));
 
-			element.properties[node.name()] = val / mResolution;
+			element.set(prop, val / mResolution);
 			break;
 		}
 		case RESOLUTION_FLOAT:
 		{
 			float val = static_cast<float>(strtod(str.c_str(), 0));
-			element.properties[node.name()] = val / mResolution.y();
+			element.set(prop, val / mResolution.y());
 			break;
 		}
 		case NORMALIZED_RECT:
@@ -554,7 +1017,7 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 					(float)atof(splits.at(2).c_str()), (float)atof(splits.at(3).c_str()));
 			}
 
-			element.properties[node.name()] = val;
+			element.set(prop, val);
 			break;
 		}
 		case NORMALIZED_PAIR:
@@ -568,11 +1031,11 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 
 			Vector2f val((float)atof(first.c_str()), (float)atof(second.c_str()));
 
-			element.properties[node.name()] = val;
+			element.set(prop, val);
 			break;
 		}
 		case STRING:
-			element.properties[node.name()] = str;
+			element.set(prop, str);
 			break;
 		case PATH:
 		{
@@ -586,16 +1049,16 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 					ss << "(which resolved to \"" << path << "\") ";
 				LOG(LogWarning) << ss.str();
 			}
-			element.properties[node.name()] = path;
+			element.set(prop, path);
 			break;
 		}
 		case COLOR:
-			element.properties[node.name()] = getHexColor(str.c_str());
+			element.set(prop, getHexColor(str.c_str()));
 			break;
 		case FLOAT:
 		{
 			float floatVal = static_cast<float>(strtod(str.c_str(), 0));
-			element.properties[node.name()] = floatVal;
+			element.set(prop, floatVal);
 			break;
 		}
 
@@ -606,7 +1069,7 @@ void ThemeData::parseElement(const pugi::xml_node& root, const std::map<std::str
 			// 1*, t* (true), T* (True), y* (yes), Y* (YES)
 			bool boolVal = (first == '1' || first == 't' || first == 'T' || first == 'y' || first == 'Y');
 
-			element.properties[node.name()] = boolVal;
+			element.set(prop, boolVal);
 			break;
 		}
 		default:
@@ -695,7 +1158,7 @@ namespace
 
 		// 내부 TextComponent로 위임 — 호출부가 TextComponent인지 ScrollableTextExtra인지
 		// 몰라도 setValue()만으로 텍스트를 갱신할 수 있게 함 (bgmTitle 등 동적 텍스트 extra용).
-		// SystemView가 매 프레임 같은 값으로 호출하므로 변경 시에만 반영(마퀴 리셋 방지).
+		// SystemView가 주기적으로 같은 값으로 호출하므로 변경 시에만 반영(마퀴 리셋 방지).
 		void setValue(const std::string& value) override
 		{
 			if (value == mText.getValue())
@@ -800,7 +1263,7 @@ std::vector<std::pair<std::string, GuiComponent*>> ThemeData::makeExtras(const s
 				comp = new ImageComponent(window);
 			else if(t == "text")
 			{
-				if(elem.has("scrollable") && elem.get<bool>("scrollable"))
+				if(elem.has(ThemeProperty::SCROLLABLE) && elem.get<bool>(ThemeProperty::SCROLLABLE))
 					comp = new ScrollableTextExtra(window);
 				else
 					comp = new TextComponent(window);
@@ -846,13 +1309,13 @@ std::map<std::string, ThemeSet> ThemeData::getThemeSets()
 	return sets;
 }
 
-std::string ThemeData::getThemeFromCurrentSet(const std::string& system)
+ThemeSet ThemeData::getCurrentThemeSet()
 {
 	std::map<std::string, ThemeSet> themeSets = ThemeData::getThemeSets();
 	if(themeSets.empty())
 	{
 		// no theme sets available
-		return "";
+		return ThemeSet();
 	}
 
 	std::map<std::string, ThemeSet>::const_iterator set = themeSets.find(Settings::getInstance()->getString("ThemeSet"));
@@ -863,5 +1326,11 @@ std::string ThemeData::getThemeFromCurrentSet(const std::string& system)
 		Settings::getInstance()->setString("ThemeSet", set->first);
 	}
 
-	return set->second.getThemePath(system);
+	return set->second;
+}
+
+std::string ThemeData::getThemeFromCurrentSet(const std::string& system)
+{
+	const ThemeSet set = getCurrentThemeSet();
+	return set.path.empty() ? "" : set.getThemePath(system);
 }
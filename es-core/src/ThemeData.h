@@ -12,7 +12,7 @@
 #include <utility>
 #include <vector>
 
-namespace pugi { class xml_node; }
+namespace pugi { class xml_document; class xml_node; }
 
 template<typename T>
 class TextListComponent;
@@ -48,6 +48,99 @@ namespace ThemeFlags
 	};
 }
 
+// RetroPangui: every property name that appears in ThemeData::sElementMap (plus "minSize", which
+// ImageComponent reads). The list order defines ThemeProperty::Id, so theme lookups are array indexed
+// instead of string map lookups - ThemeData checks at startup that sElementMap and this list agree.
+#define THEME_PROPERTY_LIST(X) \
+	X(POS,                        "pos") \
+	X(SIZE,                       "size") \
+	X(MAX_SIZE,                   "maxSize") \
+	X(MIN_SIZE,                   "minSize") \
+	X(ORIGIN,                     "origin") \
+	X(ROTATION,                   "rotation") \
+	X(ROTATION_ORIGIN,            "rotationOrigin") \
+	X(PATH,                       "path") \
+	X(DEFAULT,                    "default") \
+	X(TILE,                       "tile") \
+	X(COLOR,                      "color") \
+	X(COLOR_END,                  "colorEnd") \
+	X(GRADIENT_TYPE,              "gradientType") \
+	X(VISIBLE,                    "visible") \
+	X(Z_INDEX,                    "zIndex") \
+	X(MARGIN,                     "margin") \
+	X(PADDING,                    "padding") \
+	X(AUTO_LAYOUT,                "autoLayout") \
+	X(AUTO_LAYOUT_SELECTED_ZOOM,  "autoLayoutSelectedZoom") \
+	X(GAME_IMAGE,                 "gameImage") \
+	X(FOLDER_IMAGE,               "folderImage") \
+	X(IMAGE_SOURCE,               "imageSource") \
+	X(SCROLL_DIRECTION,           "scrollDirection") \
+	X(CENTER_SELECTION,           "centerSelection") \
+	X(SCROLL_LOOP,                "scrollLoop") \
+	X(ANIMATE,                    "animate") \
+	X(IMAGE_COLOR,                "imageColor") \
+	X(BACKGROUND_IMAGE,           "backgroundImage") \
+	X(BACKGROUND_CORNER_SIZE,     "backgroundCornerSize") \
+	X(BACKGROUND_COLOR,           "backgroundColor") \
+	X(BACKGROUND_CENTER_COLOR,    "backgroundCenterColor") \
+	X(BACKGROUND_EDGE_COLOR,      "backgroundEdgeColor") \
+	X(TEXT,                       "text") \
+	X(FONT_PATH,                  "fontPath") \
+	X(FONT_SIZE,                  "fontSize") \
+	X(ALIGNMENT,                  "alignment") \
+	X(VERTICAL_ALIGNMENT,         "verticalAlignment") \
+	X(FORCE_UPPERCASE,            "forceUppercase") \
+	X(LINE_SPACING,               "lineSpacing") \
+	X(VALUE,                      "value") \
+	X(SCROLLABLE,                 "scrollable") \
+	X(SELECTOR_HEIGHT,            "selectorHeight") \
+	X(SELECTOR_OFFSET_Y,          "selectorOffsetY") \
+	X(SELECTOR_COLOR,             "selectorColor") \
+	X(SELECTOR_COLOR_END,         "selectorColorEnd") \
+	X(SELECTOR_GRADIENT_TYPE,     "selectorGradientType") \
+	X(SELECTOR_IMAGE_PATH,        "selectorImagePath") \
+	X(SELECTOR_IMAGE_TILE,        "selectorImageTile") \
+	X(SELECTED_COLOR,             "selectedColor") \
+	X(PRIMARY_COLOR,              "primaryColor") \
+	X(SECONDARY_COLOR,            "secondaryColor") \
+	X(MARKER_COLOR,               "markerColor") \
+	X(SCROLL_SOUND,               "scrollSound") \
+	X(HORIZONTAL_MARGIN,          "horizontalMargin") \
+	X(FORMAT,                     "format") \
+	X(DISPLAY_RELATIVE,           "displayRelative") \
+	X(FILLED_PATH,                "filledPath") \
+	X(UNFILLED_PATH,              "unfilledPath") \
+	X(TEXT_COLOR,                 "textColor") \
+	X(ICON_COLOR,                 "iconColor") \
+	X(DELAY,                      "delay") \
+	X(SHOW_SNAPSHOT_NO_VIDEO,     "showSnapshotNoVideo") \
+	X(SHOW_SNAPSHOT_DELAY,        "showSnapshotDelay") \
+	X(FADE_TIME,                  "fadeTime") \
+	X(TYPE,                       "type") \
+	X(LOGO_SCALE,                 "logoScale") \
+	X(LOGO_ROTATION,              "logoRotation") \
+	X(LOGO_ROTATION_ORIGIN,       "logoRotationOrigin") \
+	X(LOGO_SIZE,                  "logoSize") \
+	X(LOGO_ALIGNMENT,             "logoAlignment") \
+	X(MAX_LOGO_COUNT,             "maxLogoCount") \
+	X(UPDATE_INTERVAL,            "updateInterval")
+
+namespace ThemeProperty
+{
+	enum Id : unsigned char
+	{
+#define THEME_PROPERTY_ENUM(id, name) id,
+		THEME_PROPERTY_LIST(THEME_PROPERTY_ENUM)
+#undef THEME_PROPERTY_ENUM
+		COUNT,
+		INVALID = 0xFF
+	};
+
+	// INVALID for unknown names
+	Id fromName(const std::string& name);
+	const char* getName(Id id);
+}
+
 class ThemeException : public std::exception
 {
 public:
@@ -94,38 +187,80 @@ public:
 		bool extra;
 		std::string type;
 
+		// RetroPangui: values live in a small tagged-union array, mSlots maps a property id to its index
+		// (NO_SLOT when unset). Strings are kept next to it so Property stays trivially copyable.
 		struct Property
 		{
-			void operator= (const Vector4f& value)     { r = value; v = Vector2f(value.x(), value.y()); }
-			void operator= (const Vector2f& value)     { v = value; }
-			void operator= (const std::string& value)  { s = value; }
-			void operator= (const unsigned int& value) { i = value; }
-			void operator= (const float& value)        { f = value; }
-			void operator= (const bool& value)         { b = value; }
-
-			Vector4f     r;
-			Vector2f     v;
-			std::string  s;
-			unsigned int i;
-			float        f;
-			bool         b;
+			enum Kind : unsigned char
+			{
+				RECT,
+				PAIR,
+				STRING,
+				UINT,
+				FLOAT,
+				BOOL
+			};
+
+			Kind kind;
+			union
+			{
+				float        r[4]; // RECT - the first two also read back as a PAIR, as before
+				float        v[2];
+				unsigned int s;    // STRING - index into mStrings
+				unsigned int i;
+				float        f;
+				bool         b;
+			};
 		};
 
-		std::map< std::string, Property > properties;
+		ThemeElement();
+
+		void set(ThemeProperty::Id prop, const Vector4f& value);
+		void set(ThemeProperty::Id prop, const Vector2f& value);
+		void set(ThemeProperty::Id prop, const std::string& value);
+		void set(ThemeProperty::Id prop, unsigned int value);
+		void set(ThemeProperty::Id prop, float value);
+		void set(ThemeProperty::Id prop, bool value);
+
+		inline const Property* getProperty(ThemeProperty::Id prop) const
+		{
+			return (prop < ThemeProperty::COUNT && mSlots[prop] != NO_SLOT) ? &mValues[mSlots[prop]] : nullptr;
+		}
+
+		inline const std::string& getString(const Property& property) const { return mStrings[property.s]; }
 
+		inline bool has(ThemeProperty::Id prop) const { return getProperty(prop) != nullptr; }
+
+		// unset properties read as a zero value
 		template<typename T>
-		const T get(const std::string& prop) const
+		const T get(ThemeProperty::Id prop) const
 		{
-			if(     std::is_same<T, Vector2f>::value)     return *(const T*)&properties.at(prop).v;
-			else if(std::is_same<T, std::string>::value)  return *(const T*)&properties.at(prop).s;
-			else if(std::is_same<T, unsigned int>::value) return *(const T*)&properties.at(prop).i;
-			else if(std::is_same<T, float>::value)        return *(const T*)&properties.at(prop).f;
-			else if(std::is_same<T, bool>::value)         return *(const T*)&properties.at(prop).b;
-			else if(std::is_same<T, Vector4f>::value)     return *(const T*)&properties.at(prop).r;
-			return T();
+			T value;
+			read(getProperty(prop), value);
+			return value;
 		}
 
-		inline bool has(const std::string& prop) const { return (properties.find(prop) != properties.cend()); }
+		// by name - interns the name first, prefer the ThemeProperty::Id overloads
+		inline bool has(const std::string& prop) const { return has(ThemeProperty::fromName(prop)); }
+
+		template<typename T>
+		const T get(const std::string& prop) const { return get<T>(ThemeProperty::fromName(prop)); }
+
+	private:
+		static const unsigned char NO_SLOT = 0xFF;
+
+		Property& add(ThemeProperty::Id prop, Property::Kind kind);
+
+		inline void read(const Property* p, Vector4f& value) const     { value = p ? Vector4f(p->r[0], p->r[1], p->r[2], p->r[3]) : Vector4f(0.0f); }
+		inline void read(const Property* p, Vector2f& value) const     { value = p ? Vector2f(p->v[0], p->v[1]) : Vector2f::Zero(); }
+		inline void read(const Property* p, std::string& value) const  { if(p && p->kind == Property::STRING) value = mStrings[p->s]; }
+		inline void read(const Property* p, unsigned int& value) const { value = p ? p->i : 0; }
+		inline void read(const Property* p, float& value) const        { value = p ? p->f : 0.0f; }
+		inline void read(const Property* p, bool& value) const         { value = p ? p->b : false; }
+
+		unsigned char            mSlots[ThemeProperty::COUNT];
+		std::vector<Property>    mValues;
+		std::vector<std::string> mStrings;
 	};
 
 private:
@@ -141,7 +276,14 @@ public:
 	ThemeData();
 
 	// throws ThemeException
+	// RetroPangui: the compiled result is cached on disk (keyed by the mtimes of the theme file and its
+	// includes plus the system variables), so an unchanged theme skips XML parsing on the next start.
+	// Safe to call from several threads at once for different ThemeData objects.
 	void loadFile(std::map<std::string, std::string> sysDataMap, const std::string& path);
+	inline bool wasLoadedFromCache() const { return mLoadedFromCache; }
+
+	// drops the parsed theme/include documents shared between loadFile() calls - call after a batch of loads
+	static void clearDocumentCache();
 
 	enum ElementPropertyType
 	{
@@ -167,6 +309,9 @@ public:
 	static const std::shared_ptr<ThemeData>& getDefault();
 
 	static std::map<std::string, ThemeSet> getThemeSets();
+	// The selected theme set; selects the first available one if it's missing (writes Settings - main thread only).
+	// Empty path if there are no theme sets.
+	static ThemeSet getCurrentThemeSet();
 	static std::string getThemeFromCurrentSet(const std::string& system);
 
 private:
@@ -189,6 +334,17 @@ private:
 
 	std::string resolvePlaceholders(const char* in);
 	std::map<std::string, std::string> mVariables;
+
+	// RetroPangui: compiled theme cache
+	std::shared_ptr<const pugi::xml_document> getDocument(const std::string& path, ThemeException& error);
+	static bool checkPropertyIds();
+	static std::string getCompiledPath(const std::string& path, const std::string& key);
+	bool loadCompiled(const std::string& path, const std::string& key);
+	void saveCompiled(const std::string& path, const std::string& key) const;
+
+	std::vector<std::string> mDependencies; // theme file and every include, in load order
+	bool mCacheable; // false if a variable came from exec="" (can change without any file changing)
+	bool mLoadedFromCache;
 };
 
 #endif // ES_CORE_THEME_DATA_H
@@ -11,6 +11,7 @@
 #include <iomanip>
 #include <sstream>
 #include <sys/stat.h>
+#include <SDL_timer.h>
 
 #ifdef WIN32
 #include <SDL_events.h>
@@ -18,7 +19,7 @@
 
 Window::Window() : mNormalizeNextUpdate(false), mFrameTimeElapsed(0), mFrameCountElapsed(0), mAverageDeltaTime(10),
 	mAllowSleep(true), mSleeping(false), mTimeSinceLastInput(0), mScreenSaver(NULL), mRenderScreenSaver(false), mInfoPopup(NULL),
-	mStorageCheckTimer(0), mAudioDeviceCheckTimer(0), mAudioDeviceFirstCheck(true),
+	mStorageCheckTimer(0), mAudioDeviceCheckTimer(0), mAudioDeviceFirstCheck(true), mInteractiveStartTicks(0),
 	mEasterEggSequence({ "up", "up", "down", "down", "left", "right", "left", "right", "b", "a" }), mEasterEggProgress(0)
 {
 	mHelp = new HelpComponent(this);
@@ -102,14 +103,22 @@ bool Window::init()
 	return true;
 }
 
-void Window::deinit()
+void Window::deinit(bool keepDecodedResources)
 {
 	// Hide all GUI elements on uninitialisation - this disable
 	for(auto i = mGuiStack.cbegin(); i != mGuiStack.cend(); i++)
 	{
 		(*i)->onHide();
 	}
-	ResourceManager::getInstance()->unloadAll();
+
+	size_t keepBytes = 0;
+	if(keepDecodedResources)
+		keepBytes = (size_t)std::max(0, Settings::getInstance()->getInt("ResumeCacheMB")) * 1024 * 1024;
+
+	size_t kept = ResourceManager::getInstance()->unloadAll(keepBytes);
+	if(keepBytes > 0)
+		LOG(LogInfo) << "Window::deinit - kept " << (kept / 1024) << " KiB of decoded textures for resume";
+
 	Renderer::deinit();
 }
 
@@ -200,6 +209,14 @@ void Window::checkEasterEggInput(InputConfig* config, Input input)
 
 void Window::update(int deltaTime)
 {
+	if(!mAfterFrameReady.empty())
+	{
+		std::vector< std::function<void()> > funcs;
+		funcs.swap(mAfterFrameReady);
+		for(auto it = funcs.cbegin(); it != funcs.cend(); it++)
+			(*it)();
+	}
+
 	if(mNormalizeNextUpdate)
 	{
 		mNormalizeNextUpdate = false;
@@ -213,7 +230,8 @@ void Window::update(int deltaTime)
 	{
 		mAverageDeltaTime = mFrameTimeElapsed / mFrameCountElapsed;
 
-		if(Settings::getInstance()->getBool("DrawFramerate"))
+		static BoolSetting drawFramerate("DrawFramerate");
+		if(drawFramerate.get())
 		{
 			std::stringstream ss;
 
@@ -286,13 +304,15 @@ void Window::render()
 	if(!mRenderedHelpPrompts)
 		mHelp->render(transform);
 
-	if(Settings::getInstance()->getBool("DrawFramerate") && mFrameDataText)
+	static BoolSetting drawFramerate("DrawFramerate");
+	if(drawFramerate.get() && mFrameDataText)
 	{
 		Renderer::setMatrix(Transform4x4f::Identity());
 		mDefaultFonts.at(1)->renderTextCache(mFrameDataText.get());
 	}
 
-	unsigned int screensaverTime = (unsigned int)Settings::getInstance()->getInt("ScreenSaverTime");
+	static IntSetting screenSaverTimeSetting("ScreenSaverTime");
+	unsigned int screensaverTime = (unsigned int)screenSaverTimeSetting.get();
 	if(mTimeSinceLastInput >= screensaverTime && screensaverTime != 0)
 		startScreenSaver();
 
@@ -305,9 +325,22 @@ void Window::render()
 		mInfoPopup->render(transform);
 	}
 
+	if(!mAfterFrame.empty())
+	{
+		mAfterFrameReady.insert(mAfterFrameReady.end(), mAfterFrame.cbegin(), mAfterFrame.cend());
+		mAfterFrame.clear();
+	}
+
+	if(mInteractiveStartTicks != 0)
+	{
+		LOG(LogInfo) << "Time to interactive after game exit: " << (SDL_GetTicks() - mInteractiveStartTicks) << " ms";
+		mInteractiveStartTicks = 0;
+	}
+
 	if(mTimeSinceLastInput >= screensaverTime && screensaverTime != 0)
 	{
-		unsigned int systemSleepTime = (unsigned int)Settings::getInstance()->getInt("SystemSleepTime");
+		static IntSetting systemSleepTimeSetting("SystemSleepTime");
+		unsigned int systemSleepTime = (unsigned int)systemSleepTimeSetting.get();
 		if(!isProcessing() && mAllowSleep && systemSleepTime != 0 && mTimeSinceLastInput >= systemSleepTime) {
 			mSleeping = true;
 			onSleep();
@@ -57,11 +57,21 @@ public:
 	void render();
 
 	bool init();
-	void deinit();
+	// RetroPangui: keepDecodedResources면 VRAM만 비우고 디코딩된 텍스처/폰트 아틀라스는
+	// ResumeCacheMB 한도 안에서 RAM에 남겨서, 게임에서 돌아올 때 디코딩 없이 바로 다시 올린다
+	void deinit(bool keepDecodedResources = false);
+
+	// 게임 종료 시점(SDL_GetTicks)을 받아 두고, 그 뒤 첫 프레임이 그려지면 걸린 시간을 로그로 남김
+	inline void measureTimeToInteractive(unsigned int startTicks) { mInteractiveStartTicks = startTicks; }
 
 	void normalizeNextUpdate();
 
+	// RetroPangui: 다음 프레임이 화면에 나간 뒤(그다음 update() 시작 시) UI 스레드에서 실행 -
+	// 화면 복귀를 늦출 필요가 없는 뒷정리(게임 종료 후 플레이 기록 갱신 등)용
+	inline void runAfterNextFrame(const std::function<void()>& func) { mAfterFrame.push_back(func); }
+
 	inline bool isSleeping() const { return mSleeping; }
+	inline unsigned int getTimeSinceLastInput() const { return mTimeSinceLastInput; }
 	bool getAllowSleep();
 	void setAllowSleep(bool sleep);
 
@@ -128,6 +138,11 @@ private:
 
 	bool mRenderedHelpPrompts;
 
+	unsigned int mInteractiveStartTicks; // 0이면 측정 안 함
+
+	std::vector< std::function<void()> > mAfterFrame;      // 다음 render() 대기
+	std::vector< std::function<void()> > mAfterFrameReady; // 그려졌음, 다음 update()에서 실행
+
 	int  mStorageCheckTimer;
 	std::function<void(const std::string& label, const std::string& id)> mStorageDetectedCallback;
 	void checkNewStorage();
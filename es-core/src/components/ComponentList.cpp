@@ -65,15 +65,15 @@ bool ComponentList::input(InputConfig* config, Input input)
 	// 메뉴 진동: 누름 에지(value != 0)에서만 울려서, 키를 누르고 있는 동안의
 	// 내부 반복 스크롤(IList가 update()에서 처리)에는 반응하지 않음 -
 	// "논리적으로 한 번 누름 = 한 번 진동" 디바운스가 자연스럽게 성립.
+	const unsigned int actions = config->getActions(input);
 	if(input.value != 0)
 	{
 		// RetroPangui: isMappedTo("a")는 물리 East 고정이라 ButtonLayout이
 		// nintendo(accept=South)일 때 실제 확인 버튼과 다른 곳에서 진동이
 		// 울리던 문제 - isMappedToAction("accept")로 통일.
-		if(config->isMappedToAction("accept", input))
+		if(actions & ACTION_ACCEPT)
 			InputManager::getInstance()->rumbleSelect(config->getDeviceId());
-		else if(config->isMappedLike("up", input) || config->isMappedLike("down", input)
-			|| config->isMappedLike("leftshoulder", input) || config->isMappedLike("rightshoulder", input))
+		else if(actions & (ACTION_UP | ACTION_DOWN | ACTION_LEFTSHOULDER | ACTION_RIGHTSHOULDER))
 			InputManager::getInstance()->rumbleNav(config->getDeviceId());
 	}
 
@@ -93,20 +93,20 @@ bool ComponentList::input(InputConfig* config, Input input)
 	}
 
 	// input handler didn't consume the input - try to scroll
-	if(config->isMappedLike("up", input))
+	if(actions & ACTION_UP)
 	{
 		return listInput(input.value != 0 ? -1 : 0);
-	}else if(config->isMappedLike("down", input))
+	}else if(actions & ACTION_DOWN)
 	{
 		// 마지막 항목에서 Down은 false 반환 → ComponentGrid가 버튼 그리드로 포커스 이동
 		if(input.value != 0 && mCursor >= (int)mEntries.size() - 1)
 			return false;
 		return listInput(input.value != 0 ? 1 : 0);
 
-	}else if(config->isMappedLike("leftshoulder", input))
+	}else if(actions & ACTION_LEFTSHOULDER)
 	{
 		return listInput(input.value != 0 ? -6 : 0);
-	}else if(config->isMappedLike("rightshoulder", input)){
+	}else if(actions & ACTION_RIGHTSHOULDER){
 		return listInput(input.value != 0 ? 6 : 0);
 	}
 
@@ -64,44 +64,44 @@ void applyThemeToProperties(const ThemeData::ThemeElement* elem, GridTilePropert
 {
 	Vector2f screen = Vector2f((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
 
-	if (elem->has("size"))
-		properties->mSize = elem->get<Vector2f>("size") * screen;
+	if (elem->has(ThemeProperty::SIZE))
+		properties->mSize = elem->get<Vector2f>(ThemeProperty::SIZE) * screen;
 
-	if (elem->has("padding"))
+	if (elem->has(ThemeProperty::PADDING))
 	{
-		properties->mPadding = elem->get<Vector2f>("padding") * screen;
+		properties->mPadding = elem->get<Vector2f>(ThemeProperty::PADDING) * screen;
 
 		// hack to fix broken themes now that this uses percentage rather than pixels
 		if(properties->mPadding.x() > screen.x())
 			properties->mPadding /= screen;
 	}
 
-	if (elem->has("imageColor"))
-		properties->mImageColor = elem->get<unsigned int>("imageColor");
+	if (elem->has(ThemeProperty::IMAGE_COLOR))
+		properties->mImageColor = elem->get<unsigned int>(ThemeProperty::IMAGE_COLOR);
 
-	if (elem->has("backgroundImage"))
-		properties->mBackgroundImage = elem->get<std::string>("backgroundImage");
+	if (elem->has(ThemeProperty::BACKGROUND_IMAGE))
+		properties->mBackgroundImage = elem->get<std::string>(ThemeProperty::BACKGROUND_IMAGE);
 
-	if (elem->has("backgroundCornerSize"))
+	if (elem->has(ThemeProperty::BACKGROUND_CORNER_SIZE))
 	{
-		properties->mBackgroundCornerSize = elem->get<Vector2f>("backgroundCornerSize") * screen;
+		properties->mBackgroundCornerSize = elem->get<Vector2f>(ThemeProperty::BACKGROUND_CORNER_SIZE) * screen;
 
 		// hack to fix broken themes now that this uses percentage rather than pixels
 		if(properties->mBackgroundCornerSize.x() > screen.x())
 			properties->mBackgroundCornerSize /= screen;
 	}
 
-	if (elem->has("backgroundColor"))
+	if (elem->has(ThemeProperty::BACKGROUND_COLOR))
 	{
-		properties->mBackgroundCenterColor = elem->get<unsigned int>("backgroundColor");
-		properties->mBackgroundEdgeColor = elem->get<unsigned int>("backgroundColor");
+		properties->mBackgroundCenterColor = elem->get<unsigned int>(ThemeProperty::BACKGROUND_COLOR);
+		properties->mBackgroundEdgeColor = elem->get<unsigned int>(ThemeProperty::BACKGROUND_COLOR);
 	}
 
-	if (elem->has("backgroundCenterColor"))
-		properties->mBackgroundCenterColor = elem->get<unsigned int>("backgroundCenterColor");
+	if (elem->has(ThemeProperty::BACKGROUND_CENTER_COLOR))
+		properties->mBackgroundCenterColor = elem->get<unsigned int>(ThemeProperty::BACKGROUND_CENTER_COLOR);
 
-	if (elem->has("backgroundEdgeColor"))
-		properties->mBackgroundEdgeColor = elem->get<unsigned int>("backgroundEdgeColor");
+	if (elem->has(ThemeProperty::BACKGROUND_EDGE_COLOR))
+		properties->mBackgroundEdgeColor = elem->get<unsigned int>(ThemeProperty::BACKGROUND_EDGE_COLOR);
 }
 
 void GridTileComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& /*element*/, unsigned int /*properties*/)
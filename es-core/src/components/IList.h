@@ -5,6 +5,11 @@
 #include "components/ImageComponent.h"
 #include "resources/Font.h"
 #include "PowerSaver.h"
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 enum CursorState
 {
@@ -57,6 +62,70 @@ public:
 		EntryData data;
 	};
 
+	// RetroPangui: virtualized entries. Instead of add()ing every entry, a list can be given a data source
+	// that answers (count, entry at index); entries are then built only when they are looked at (the viewport
+	// plus a prefetch window) and kept in a small cache around the cursor, so memory use and population time
+	// don't grow with the list size.
+	class DataSource
+	{
+	public:
+		typedef typename IList<EntryData, UserData>::Entry Entry;
+
+		virtual ~DataSource() {}
+		virtual int size() const = 0;
+		virtual void getEntry(int index, Entry& entry) const = 0;
+		// -1 if not in the list. hint is where the object probably is (the cursor)
+		virtual int indexOf(const UserData& object, int hint) const = 0;
+		virtual void remove(int index) = 0;
+	};
+
+	// data source over the caller's vector (e.g. FileData::getChildrenListToDisplay()), which must outlive it.
+	// Nothing is copied or indexed up front. The first remove() takes a private copy, because the caller's vector
+	// changes on its own (the game list views delete the removed object right after).
+	class VectorDataSource : public DataSource
+	{
+	public:
+		VectorDataSource(const std::vector<UserData>& objects) : mObjects(&objects), mDetached(false) {}
+		VectorDataSource(const VectorDataSource&) = delete;
+		VectorDataSource& operator=(const VectorDataSource&) = delete;
+
+		int size() const override { return (int)mObjects->size(); }
+
+		// searches outwards from hint, so an object near the cursor costs a few comparisons
+		int indexOf(const UserData& object, int hint) const override
+		{
+			const int count = size();
+			hint = std::max(0, std::min(hint, count - 1));
+			for(int offset = 0; hint - offset >= 0 || hint + offset < count; offset++)
+			{
+				if(hint + offset < count && (*mObjects)[hint + offset] == object)
+					return hint + offset;
+				if(offset > 0 && hint - offset >= 0 && (*mObjects)[hint - offset] == object)
+					return hint - offset;
+			}
+			return -1;
+		}
+
+		void remove(int index) override
+		{
+			if(!mDetached)
+			{
+				mOwned = *mObjects;
+				mObjects = &mOwned;
+				mDetached = true;
+			}
+			mOwned.erase(mOwned.begin() + index);
+		}
+
+	protected:
+		inline const UserData& getObject(int index) const { return mObjects->at(index); }
+
+	private:
+		const std::vector<UserData>* mObjects;
+		std::vector<UserData> mOwned;
+		bool mDetached;
+	};
+
 protected:
 	struct Entry mEntry;
 
@@ -79,12 +148,19 @@ protected:
 
 	std::vector<Entry> mEntries;
 
+	// only used with a data source - entries built so far, by index
+	static const int LOADED_ENTRIES_MAX = 256;
+	std::shared_ptr<DataSource> mDataSource;
+	mutable std::unordered_map<int, Entry> mLoadedEntries;
+	int mSearchHint; // cursor index before the data source was replaced, -1 once used
+
 public:
 	IList(Window* window, const ScrollTierList& tierList = LIST_SCROLL_STYLE_QUICK, const ListLoopType& loopType = LIST_PAUSE_AT_END) : GuiComponent(window),
 		mGradient(window), mTierList(tierList), mLoopType(loopType)
 	{
 		mCursor = 0;
 		mViewportTop = 0;
+		mSearchHint = -1;
 		mScrollTier = 0;
 		mScrollVelocity = 0;
 		mScrollTierAccumulator = 0;
@@ -122,21 +198,34 @@ public:
 	void clear()
 	{
 		mEntries.clear();
+		mDataSource.reset();
+		mLoadedEntries.clear();
+		mSearchHint = -1;
 		mCursor = 0;
 		listInput(0);
 		onCursorChanged(CURSOR_STOPPED);
 	}
 
+	// replaces all entries
+	void setDataSource(const std::shared_ptr<DataSource>& source)
+	{
+		// a rebuilt list usually gets its cursor back at about the same index
+		const int hint = mCursor;
+		clear();
+		mDataSource = source;
+		mSearchHint = hint;
+	}
+
 	inline const std::string& getSelectedName()
 	{
 		assert(size() > 0);
-		return mEntries.at(mCursor).name;
+		return getEntry(mCursor).name;
 	}
 
 	inline const UserData& getSelected() const
 	{
 		assert(size() > 0);
-		return mEntries.at(mCursor).object;
+		return getEntry(mCursor).object;
 	}
 
 	void setCursor(typename std::vector<Entry>::const_iterator& it)
@@ -149,6 +238,18 @@ public:
 	// returns true if successful (select is in our list), false if not
 	bool setCursor(const UserData& obj)
 	{
+		if(mDataSource)
+		{
+			const int index = mDataSource->indexOf(obj, mSearchHint >= 0 ? mSearchHint : mCursor);
+			mSearchHint = -1;
+			if(index < 0)
+				return false;
+
+			mCursor = index;
+			onCursorChanged(CURSOR_STOPPED);
+			return true;
+		}
+
 		for(auto it = mEntries.cbegin(); it != mEntries.cend(); it++)
 		{
 			if((*it).object == obj)
@@ -175,11 +276,28 @@ public:
 	// entry management
 	void add(const Entry& e)
 	{
+		assert(!mDataSource);
 		mEntries.push_back(e);
 	}
 
 	bool remove(const UserData& obj)
 	{
+		if(mDataSource)
+		{
+			const int index = mDataSource->indexOf(obj, mCursor);
+			if(index < 0)
+				return false;
+
+			mDataSource->remove(index);
+			mLoadedEntries.clear();
+			if(mCursor > 0 && index <= mCursor)
+			{
+				mCursor--;
+				onCursorChanged(CURSOR_STOPPED);
+			}
+			return true;
+		}
+
 		for(auto it = mEntries.cbegin(); it != mEntries.cend(); it++)
 		{
 			if((*it).object == obj)
@@ -192,9 +310,56 @@ public:
 		return false;
 	}
 
-	inline int size() const { return (int)mEntries.size(); }
+	inline int size() const { return mDataSource ? mDataSource->size() : (int)mEntries.size(); }
 
 protected:
+	inline Entry& getEntry(int index) { return mDataSource ? loadEntry(index) : mEntries.at(index); }
+	inline const Entry& getEntry(int index) const { return mDataSource ? loadEntry(index) : mEntries.at(index); }
+
+	// builds entries [first, last) ahead of time so scrolling into them doesn't hit the data source mid-render
+	void prefetchEntries(int first, int last) const
+	{
+		if(!mDataSource)
+			return;
+
+		first = std::max(0, first);
+		last = std::min(std::min(size(), last), first + LOADED_ENTRIES_MAX / 2);
+		for(int i = first; i < last; i++)
+			loadEntry(i);
+	}
+
+	// drops built entries (and whatever they cache) so they are rebuilt from the data source
+	void invalidateEntries()
+	{
+		mLoadedEntries.clear();
+	}
+
+	Entry& loadEntry(int index) const
+	{
+		auto it = mLoadedEntries.find(index);
+		if(it != mLoadedEntries.cend())
+			return it->second;
+
+		// forget entries far from the cursor - references to entries near it stay valid
+		if((int)mLoadedEntries.size() >= LOADED_ENTRIES_MAX)
+		{
+			for(auto loaded = mLoadedEntries.begin(); loaded != mLoadedEntries.end(); )
+			{
+				if(std::abs(loaded->first - mCursor) > LOADED_ENTRIES_MAX / 2)
+					loaded = mLoadedEntries.erase(loaded);
+				else
+					++loaded;
+			}
+		}
+
+		// only the neighbourhood of the cursor is ever built, however long the list is
+		assert((int)mLoadedEntries.size() <= LOADED_ENTRIES_MAX + 1);
+
+		Entry& entry = mLoadedEntries[index];
+		mDataSource->getEntry(index, entry);
+		return entry;
+	}
+
 	void remove(typename std::vector<Entry>::const_iterator& it)
 	{
 		if(mCursor > 0 && it - mEntries.cbegin() <= mCursor)
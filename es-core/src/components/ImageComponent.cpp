@@ -328,7 +328,8 @@ void ImageComponent::render(const Transform4x4f& parentTrans)
 
 	if(mTexture && mOpacity > 0)
 	{
-		if(Settings::getInstance()->getBool("DebugImage")) {
+		static BoolSetting debugImage("DebugImage");
+		if(debugImage.get()) {
 			Vector2f targetSizePos = (mTargetSize - mSize) * mOrigin * -1;
 			Renderer::drawRect(targetSizePos.x(), targetSizePos.y(), mTargetSize.x(), mTargetSize.y(), 0xFF000033, 0xFF000033);
 			Renderer::drawRect(0.0f, 0.0f, mSize.x(), mSize.y(), 0x00000033, 0x00000033);
@@ -406,33 +407,33 @@ void ImageComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const s
 
 	if(properties & ThemeFlags::SIZE)
 	{
-		if(elem->has("size"))
-			setResize(elem->get<Vector2f>("size") * scale);
-		else if(elem->has("maxSize"))
-			setMaxSize(elem->get<Vector2f>("maxSize") * scale);
-		else if(elem->has("minSize"))
-			setMinSize(elem->get<Vector2f>("minSize") * scale);
+		if(elem->has(ThemeProperty::SIZE))
+			setResize(elem->get<Vector2f>(ThemeProperty::SIZE) * scale);
+		else if(elem->has(ThemeProperty::MAX_SIZE))
+			setMaxSize(elem->get<Vector2f>(ThemeProperty::MAX_SIZE) * scale);
+		else if(elem->has(ThemeProperty::MIN_SIZE))
+			setMinSize(elem->get<Vector2f>(ThemeProperty::MIN_SIZE) * scale);
 	}
 
-	if(elem->has("default"))
-		setDefaultImage(elem->get<std::string>("default"));
+	if(elem->has(ThemeProperty::DEFAULT))
+		setDefaultImage(elem->get<std::string>(ThemeProperty::DEFAULT));
 
-	if(properties & PATH && elem->has("path"))
+	if(properties & PATH && elem->has(ThemeProperty::PATH))
 	{
-		bool tile = (elem->has("tile") && elem->get<bool>("tile"));
-		setImage(elem->get<std::string>("path"), tile);
+		bool tile = (elem->has(ThemeProperty::TILE) && elem->get<bool>(ThemeProperty::TILE));
+		setImage(elem->get<std::string>(ThemeProperty::PATH), tile);
 	}
 
 	if(properties & COLOR)
 	{
-		if(elem->has("color"))
-			setColorShift(elem->get<unsigned int>("color"));
+		if(elem->has(ThemeProperty::COLOR))
+			setColorShift(elem->get<unsigned int>(ThemeProperty::COLOR));
 
-		if (elem->has("colorEnd"))
-			setColorShiftEnd(elem->get<unsigned int>("colorEnd"));
+		if (elem->has(ThemeProperty::COLOR_END))
+			setColorShiftEnd(elem->get<unsigned int>(ThemeProperty::COLOR_END));
 
-		if (elem->has("gradientType"))
-			setColorGradientHorizontal(!(elem->get<std::string>("gradientType").compare("horizontal")));
+		if (elem->has(ThemeProperty::GRADIENT_TYPE))
+			setColorGradientHorizontal(!(elem->get<std::string>(ThemeProperty::GRADIENT_TYPE).compare("horizontal")));
 	}
 }
 
@@ -42,6 +42,8 @@ protected:
 	using IList<ImageGridData, T>::mCursor;
 	using IList<ImageGridData, T>::mEntry;
 	using IList<ImageGridData, T>::mWindow;
+	using IList<ImageGridData, T>::getEntry;
+	using IList<ImageGridData, T>::invalidateEntries;
 
 public:
 	using IList<ImageGridData, T>::size;
@@ -51,6 +53,7 @@ public:
 	ImageGridComponent(Window* window);
 
 	void add(const std::string& name, const std::string& imagePath, const T& obj);
+	void setDataSource(const std::shared_ptr<typename IList<ImageGridData, T>::DataSource>& source);
 
 	bool input(InputConfig* config, Input input) override;
 	void update(int deltaTime) override;
@@ -150,6 +153,13 @@ void ImageGridComponent<T>::add(const std::string& name, const std::string& imag
 	mEntriesDirty = true;
 }
 
+template<typename T>
+void ImageGridComponent<T>::setDataSource(const std::shared_ptr<typename IList<ImageGridData, T>::DataSource>& source)
+{
+	IList<ImageGridData, T>::setDataSource(source);
+	mEntriesDirty = true;
+}
+
 template<typename T>
 bool ImageGridComponent<T>::input(InputConfig* config, Input input)
 {
@@ -157,14 +167,15 @@ bool ImageGridComponent<T>::input(InputConfig* config, Input input)
 	{
 		int idx = isVertical() ? 0 : 1;
 
+		const unsigned int actions = config->getActions(input);
 		Vector2i dir = Vector2i::Zero();
-		if(config->isMappedLike("up", input))
+		if(actions & ACTION_UP)
 			dir[1 ^ idx] = -1;
-		else if(config->isMappedLike("down", input))
+		else if(actions & ACTION_DOWN)
 			dir[1 ^ idx] = 1;
-		else if(config->isMappedLike("left", input))
+		else if(actions & ACTION_LEFT)
 			dir[0 ^ idx] = -1;
-		else if(config->isMappedLike("right", input))
+		else if(actions & ACTION_RIGHT)
 			dir[0 ^ idx] = 1;
 
 		if(dir != Vector2i::Zero())
@@ -176,7 +187,7 @@ bool ImageGridComponent<T>::input(InputConfig* config, Input input)
 			return true;
 		}
 	}else{
-		if(config->isMappedLike("up", input) || config->isMappedLike("down", input) || config->isMappedLike("left", input) || config->isMappedLike("right", input))
+		if(config->isAction(input, ACTION_DIRECTIONS))
 		{
 			stopScrolling();
 		}
@@ -259,21 +270,21 @@ void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 	const ThemeData::ThemeElement* elem = theme->getElement(view, element, "imagegrid");
 	if (elem)
 	{
-		if (elem->has("margin"))
-			mMargin = elem->get<Vector2f>("margin") * screen;
+		if (elem->has(ThemeProperty::MARGIN))
+			mMargin = elem->get<Vector2f>(ThemeProperty::MARGIN) * screen;
 
-		if (elem->has("padding"))
-			mPadding = elem->get<Vector4f>("padding") * Vector4f(screen.x(), screen.y(), screen.x(), screen.y());
+		if (elem->has(ThemeProperty::PADDING))
+			mPadding = elem->get<Vector4f>(ThemeProperty::PADDING) * Vector4f(screen.x(), screen.y(), screen.x(), screen.y());
 
-		if (elem->has("autoLayout"))
-			mAutoLayout = elem->get<Vector2f>("autoLayout");
+		if (elem->has(ThemeProperty::AUTO_LAYOUT))
+			mAutoLayout = elem->get<Vector2f>(ThemeProperty::AUTO_LAYOUT);
 
-		if (elem->has("autoLayoutSelectedZoom"))
-			mAutoLayoutZoom = elem->get<float>("autoLayoutSelectedZoom");
+		if (elem->has(ThemeProperty::AUTO_LAYOUT_SELECTED_ZOOM))
+			mAutoLayoutZoom = elem->get<float>(ThemeProperty::AUTO_LAYOUT_SELECTED_ZOOM);
 
-		if (elem->has("imageSource"))
+		if (elem->has(ThemeProperty::IMAGE_SOURCE))
 		{
-			auto direction = elem->get<std::string>("imageSource");
+			auto direction = elem->get<std::string>(ThemeProperty::IMAGE_SOURCE);
 			if (direction == "image")
 				mImageSource = IMAGE;
 			else if (direction == "marquee")
@@ -284,25 +295,25 @@ void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 		else
 			mImageSource = THUMBNAIL;
 
-		if (elem->has("scrollDirection"))
-			mScrollDirection = (ScrollDirection)(elem->get<std::string>("scrollDirection") == "horizontal");
+		if (elem->has(ThemeProperty::SCROLL_DIRECTION))
+			mScrollDirection = (ScrollDirection)(elem->get<std::string>(ThemeProperty::SCROLL_DIRECTION) == "horizontal");
 
-		if (elem->has("centerSelection"))
+		if (elem->has(ThemeProperty::CENTER_SELECTION))
 		{
-			mCenterSelection = (elem->get<bool>("centerSelection"));
+			mCenterSelection = (elem->get<bool>(ThemeProperty::CENTER_SELECTION));
 
-			if (elem->has("scrollLoop"))
-				mScrollLoop = (elem->get<bool>("scrollLoop"));
+			if (elem->has(ThemeProperty::SCROLL_LOOP))
+				mScrollLoop = (elem->get<bool>(ThemeProperty::SCROLL_LOOP));
 		}
 
-		if (elem->has("animate"))
-			mAnimate = (elem->get<bool>("animate"));
+		if (elem->has(ThemeProperty::ANIMATE))
+			mAnimate = (elem->get<bool>(ThemeProperty::ANIMATE));
 		else
 			mAnimate = true;
 
-		if (elem->has("gameImage"))
+		if (elem->has(ThemeProperty::GAME_IMAGE))
 		{
-			std::string path = elem->get<std::string>("gameImage");
+			std::string path = elem->get<std::string>(ThemeProperty::GAME_IMAGE);
 
 			if (!ResourceManager::getInstance()->fileExists(path))
 			{
@@ -320,12 +331,13 @@ void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 					if ((*it).data.texturePath == oldDefaultGameTexture)
 						(*it).data.texturePath = mDefaultGameTexture;
 				}
+				invalidateEntries();
 			}
 		}
 
-		if (elem->has("folderImage"))
+		if (elem->has(ThemeProperty::FOLDER_IMAGE))
 		{
-			std::string path = elem->get<std::string>("folderImage");
+			std::string path = elem->get<std::string>(ThemeProperty::FOLDER_IMAGE);
 
 			if (!ResourceManager::getInstance()->fileExists(path))
 			{
@@ -343,6 +355,7 @@ void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 					if ((*it).data.texturePath == oldDefaultFolderTexture)
 						(*it).data.texturePath = mDefaultFolderTexture;
 				}
+				invalidateEntries();
 			}
 		}
 	}
@@ -351,8 +364,8 @@ void ImageGridComponent<T>::applyTheme(const std::shared_ptr<ThemeData>& theme,
 	// so we can recalculate the new grid dimension, and THEN (re)build the tiles
 	elem = theme->getElement(view, "default", "gridtile");
 
-	mTileSize = elem && elem->has("size") ?
-				elem->get<Vector2f>("size") * screen :
+	mTileSize = elem && elem->has(ThemeProperty::SIZE) ?
+				elem->get<Vector2f>(ThemeProperty::SIZE) * screen :
 				GridTileComponent::getDefaultTileSize();
 
 	// Apply size property, will trigger a call to onSizeChanged() which will build the tiles
@@ -383,7 +396,7 @@ void ImageGridComponent<T>::onCursorChanged(const CursorState& state)
 
 	bool direction = mCursor >= mLastCursor;
 	int diff = direction ? mCursor - mLastCursor : mLastCursor - mCursor;
-	if (isScrollLoop() && diff == mEntries.size() - 1)
+	if (isScrollLoop() && diff == size() - 1)
 	{
 		direction = !direction;
 	}
@@ -399,7 +412,7 @@ void ImageGridComponent<T>::onCursorChanged(const CursorState& state)
 	int oldCol = (mLastCursor / dimOpposite);
 	int col = (mCursor / dimOpposite);
 
-	int lastCol = (((int)mEntries.size() - 1) / dimOpposite);
+	int lastCol = ((size() - 1) / dimOpposite);
 
 	int lastScroll = std::max(0, (lastCol + 1 - dimScrollable));
 
@@ -425,9 +438,9 @@ void ImageGridComponent<T>::onCursorChanged(const CursorState& state)
 		int newIdx = mCursor - mStartPosition + (dimOpposite * EXTRAITEMS);
 		if (isScrollLoop()) {
 			if (newIdx < 0)
-				newIdx += (int)mEntries.size();
+				newIdx += size();
 			else if (newIdx >= mTiles.size())
-				newIdx -= (int)mEntries.size();
+				newIdx -= size();
 		}
 
 		if (newIdx >= 0 && newIdx < mTiles.size())
@@ -621,9 +634,9 @@ void ImageGridComponent<T>::updateTileAtPos(int tilePos, int imgPos, bool allowA
 	if(isScrollLoop())
 	{
 		if (imgPos < 0)
-			imgPos += (int)mEntries.size();
+			imgPos += size();
 		else if (imgPos >= size())
-			imgPos -= (int)mEntries.size();
+			imgPos -= size();
 	}
 
 	// If we have more tiles than we have to display images on screen, hide them
@@ -639,11 +652,12 @@ void ImageGridComponent<T>::updateTileAtPos(int tilePos, int imgPos, bool allowA
 	{
 		tile->setVisible(true);
 
-		std::string imagePath = mEntries.at(imgPos).data.texturePath;
+		const typename IList<ImageGridData, T>::Entry& entry = getEntry(imgPos);
+		const std::string& imagePath = entry.data.texturePath;
 
 		if (ResourceManager::getInstance()->fileExists(imagePath))
 			tile->setImage(imagePath);
-		else if (mEntries.at(imgPos).object->getType() == 2)
+		else if (entry.object->getType() == 2)
 			tile->setImage(mDefaultFolderTexture);
 		else
 			tile->setImage(mDefaultGameTexture);
@@ -702,8 +716,8 @@ bool ImageGridComponent<T>::isScrollLoop() {
 	if (!mScrollLoop)
 		return false;
 	if (isVertical())
-		return (mGridDimension.x() * (mGridDimension.y() - 2 * EXTRAITEMS)) <= mEntries.size();
-	return (mGridDimension.y() * (mGridDimension.x() - 2 * EXTRAITEMS)) <= mEntries.size();
+		return (mGridDimension.x() * (mGridDimension.y() - 2 * EXTRAITEMS)) <= size();
+	return (mGridDimension.y() * (mGridDimension.x() - 2 * EXTRAITEMS)) <= size();
 };
 
 #endif // ES_CORE_COMPONENTS_IMAGE_GRID_COMPONENT_H
@@ -126,7 +126,8 @@ void TextComponent::render(const Transform4x4f& parentTrans)
 		}
 		Vector3f off(0, yOff, 0);
 
-		if(Settings::getInstance()->getBool("DebugText"))
+		static BoolSetting debugText("DebugText");
+		if(debugText.get())
 		{
 			// draw the "textbox" area, what we are aligned within
 			Renderer::setMatrix(trans);
@@ -137,7 +138,7 @@ void TextComponent::render(const Transform4x4f& parentTrans)
 		Renderer::setMatrix(trans);
 
 		// draw the text area, where the text actually is going
-		if(Settings::getInstance()->getBool("DebugText"))
+		if(debugText.get())
 		{
 			switch(mHorizontalAlignment)
 			{
@@ -264,18 +265,18 @@ void TextComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const st
 	if(!elem)
 		return;
 
-	if (properties & COLOR && elem->has("color"))
-		setColor(elem->get<unsigned int>("color"));
+	if (properties & COLOR && elem->has(ThemeProperty::COLOR))
+		setColor(elem->get<unsigned int>(ThemeProperty::COLOR));
 
 	setRenderBackground(false);
-	if (properties & COLOR && elem->has("backgroundColor")) {
-		setBackgroundColor(elem->get<unsigned int>("backgroundColor"));
+	if (properties & COLOR && elem->has(ThemeProperty::BACKGROUND_COLOR)) {
+		setBackgroundColor(elem->get<unsigned int>(ThemeProperty::BACKGROUND_COLOR));
 		setRenderBackground(true);
 	}
 
-	if(properties & ALIGNMENT && elem->has("alignment"))
+	if(properties & ALIGNMENT && elem->has(ThemeProperty::ALIGNMENT))
 	{
-		std::string str = elem->get<std::string>("alignment");
+		std::string str = elem->get<std::string>(ThemeProperty::ALIGNMENT);
 		if(str == "left")
 			setHorizontalAlignment(ALIGN_LEFT);
 		else if(str == "center")
@@ -286,9 +287,9 @@ void TextComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const st
 			LOG(LogError) << "Unknown text alignment string: " << str;
 	}
 
-	if(properties & ALIGNMENT && elem->has("verticalAlignment"))
+	if(properties & ALIGNMENT && elem->has(ThemeProperty::VERTICAL_ALIGNMENT))
 	{
-		std::string str = elem->get<std::string>("verticalAlignment");
+		std::string str = elem->get<std::string>(ThemeProperty::VERTICAL_ALIGNMENT);
 		if(str == "top")
 			setVerticalAlignment(ALIGN_TOP);
 		else if(str == "center")
@@ -299,14 +300,14 @@ void TextComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const st
 			LOG(LogError) << "Unknown vertical text alignment string: " << str;
 	}
 
-	if(properties & TEXT && elem->has("text"))
-		setText(elem->get<std::string>("text"));
+	if(properties & TEXT && elem->has(ThemeProperty::TEXT))
+		setText(elem->get<std::string>(ThemeProperty::TEXT));
 
-	if(properties & FORCE_UPPERCASE && elem->has("forceUppercase"))
-		setUppercase(elem->get<bool>("forceUppercase"));
+	if(properties & FORCE_UPPERCASE && elem->has(ThemeProperty::FORCE_UPPERCASE))
+		setUppercase(elem->get<bool>(ThemeProperty::FORCE_UPPERCASE));
 
-	if(properties & LINE_SPACING && elem->has("lineSpacing"))
-		setLineSpacing(elem->get<float>("lineSpacing"));
+	if(properties & LINE_SPACING && elem->has(ThemeProperty::LINE_SPACING))
+		setLineSpacing(elem->get<float>(ThemeProperty::LINE_SPACING));
 
 	setFont(Font::getFromTheme(elem, properties, mFont));
 }
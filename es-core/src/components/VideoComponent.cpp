@@ -199,27 +199,27 @@ void VideoComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const s
 
 	if(properties & ThemeFlags::SIZE)
 	{
-		if(elem->has("size"))
-			setResize(elem->get<Vector2f>("size") * scale);
-		else if(elem->has("maxSize"))
-			setMaxSize(elem->get<Vector2f>("maxSize") * scale);
+		if(elem->has(ThemeProperty::SIZE))
+			setResize(elem->get<Vector2f>(ThemeProperty::SIZE) * scale);
+		else if(elem->has(ThemeProperty::MAX_SIZE))
+			setMaxSize(elem->get<Vector2f>(ThemeProperty::MAX_SIZE) * scale);
 	}
 
-	if(elem->has("default"))
-		mConfig.defaultVideoPath = elem->get<std::string>("default");
+	if(elem->has(ThemeProperty::DEFAULT))
+		mConfig.defaultVideoPath = elem->get<std::string>(ThemeProperty::DEFAULT);
 
-	if((properties & ThemeFlags::DELAY) && elem->has("delay"))
-		mConfig.startDelay = (unsigned)(elem->get<float>("delay") * 1000.0f);
+	if((properties & ThemeFlags::DELAY) && elem->has(ThemeProperty::DELAY))
+		mConfig.startDelay = (unsigned)(elem->get<float>(ThemeProperty::DELAY) * 1000.0f);
 
-	if (elem->has("showSnapshotNoVideo"))
-		mConfig.showSnapshotNoVideo = elem->get<bool>("showSnapshotNoVideo");
+	if (elem->has(ThemeProperty::SHOW_SNAPSHOT_NO_VIDEO))
+		mConfig.showSnapshotNoVideo = elem->get<bool>(ThemeProperty::SHOW_SNAPSHOT_NO_VIDEO);
 
-	if (elem->has("showSnapshotDelay"))
-		mConfig.showSnapshotDelay = elem->get<bool>("showSnapshotDelay");
+	if (elem->has(ThemeProperty::SHOW_SNAPSHOT_DELAY))
+		mConfig.showSnapshotDelay = elem->get<bool>(ThemeProperty::SHOW_SNAPSHOT_DELAY);
 
 	// 스냅샷↔비디오 페이드 시간(초). 0이면 컷 전환
-	if (elem->has("fadeTime"))
-		mConfig.fadeTime = (unsigned)(elem->get<float>("fadeTime") * 1000.0f);
+	if (elem->has(ThemeProperty::FADE_TIME))
+		mConfig.fadeTime = (unsigned)(elem->get<float>(ThemeProperty::FADE_TIME) * 1000.0f);
 }
 
 std::vector<HelpPrompt> VideoComponent::getHelpPrompts()
@@ -198,7 +198,7 @@ bool Font::FontTexture::findEmpty(const Vector2i& size, Vector2i& cursor_out)
 void Font::FontTexture::initTexture()
 {
 	assert(textureId == 0);
-	textureId = Renderer::createTexture(Renderer::Texture::ALPHA, false, false, textureSize.x(), textureSize.y(), nullptr);
+	textureId = Renderer::createTexture(Renderer::Texture::ALPHA, false, false, textureSize.x(), textureSize.y(), pixels.empty() ? nullptr : pixels.data());
 }
 
 void Font::FontTexture::deinitTexture()
@@ -210,6 +210,15 @@ void Font::FontTexture::deinitTexture()
 	}
 }
 
+void Font::FontTexture::storeGlyph(const Vector2i& cursor, const Vector2i& glyphSize, const unsigned char* buffer, int pitch)
+{
+	if(pixels.empty() || buffer == nullptr)
+		return;
+
+	for(int y = 0; y < glyphSize.y(); y++)
+		memcpy(&pixels[(cursor.y() + y) * textureSize.x() + cursor.x()], buffer + y * pitch, glyphSize.x());
+}
+
 void Font::getTextureForNewGlyph(const Vector2i& glyphSize, FontTexture*& tex_out, Vector2i& cursor_out)
 {
 	if(mTextures.size())
@@ -226,6 +235,8 @@ void Font::getTextureForNewGlyph(const Vector2i& glyphSize, FontTexture*& tex_ou
 	// make a new one
 	mTextures.push_back(FontTexture());
 	tex_out = &mTextures.back();
+	if(Settings::getInstance()->getInt("ResumeCacheMB") > 0)
+		tex_out->pixels.assign(tex_out->textureSize.x() * tex_out->textureSize.y(), 0);
 	tex_out->initTexture();
 
 	bool ok = tex_out->findEmpty(glyphSize, cursor_out);
@@ -390,6 +401,7 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 
 	// upload glyph bitmap to texture
 	Renderer::updateTexture(tex->textureId, Renderer::Texture::ALPHA, cursor.x(), cursor.y(), glyphSize.x(), glyphSize.y(), g->bitmap.buffer);
+	tex->storeGlyph(cursor, glyphSize, g->bitmap.buffer, g->bitmap.pitch);
 
 	// update max glyph height
 	if(glyphSize.y() > mMaxGlyphHeight)
@@ -403,11 +415,17 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 void Font::rebuildTextures()
 {
 	// recreate OpenGL textures
+	bool restored = true;
 	for(auto it = mTextures.begin(); it != mTextures.end(); it++)
 	{
 		it->initTexture();
+		restored = restored && !it->pixels.empty();
 	}
 
+	// RetroPangui: 아틀라스 사본에서 바로 올렸으면 글리프를 다시 그리지 않는다
+	if(restored)
+		return;
+
 	// reupload the texture data
 	for(auto it = mGlyphMap.cbegin(); it != mGlyphMap.cend(); it++)
 	{
@@ -751,10 +769,10 @@ std::shared_ptr<Font> Font::getFromTheme(const ThemeData::ThemeElement* elem, un
 	std::string path = (orig ? orig->mPath : getDefaultPath());
 
 	float sh = (float)Renderer::getScreenHeight();
-	if(properties & FONT_SIZE && elem->has("fontSize"))
-		size = (int)(sh * elem->get<float>("fontSize"));
-	if(properties & FONT_PATH && elem->has("fontPath"))
-		path = elem->get<std::string>("fontPath");
+	if(properties & FONT_SIZE && elem->has(ThemeProperty::FONT_SIZE))
+		size = (int)(sh * elem->get<float>(ThemeProperty::FONT_SIZE));
+	if(properties & FONT_PATH && elem->has(ThemeProperty::FONT_PATH))
+		path = elem->get<std::string>(ThemeProperty::FONT_PATH);
 
 	return get(size, path);
 }
@@ -86,9 +86,14 @@ private:
 		~FontTexture();
 		bool findEmpty(const Vector2i& size, Vector2i& cursor_out);
 
+		// RetroPangui: 게임 복귀용 아틀라스 사본(ResumeCacheMB > 0일 때만) - 있으면 initTexture()가 이걸로
+		// 텍스처를 만들어서 글리프를 FreeType으로 다시 그릴 필요가 없음
+		std::vector<unsigned char> pixels;
+
 		// you must call initTexture() after creating a FontTexture to get a textureId
 		void initTexture(); // initializes the OpenGL texture according to this FontTexture's settings, updating textureId
 		void deinitTexture(); // deinitializes the OpenGL texture if any exists, is automatically called in the destructor
+		void storeGlyph(const Vector2i& cursor, const Vector2i& glyphSize, const unsigned char* buffer, int pitch);
 	};
 
 	struct FontFace
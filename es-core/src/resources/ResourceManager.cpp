@@ -95,8 +95,9 @@ bool ResourceManager::fileExists(const std::string& path) const
 	return Utils::FileSystem::exists(path);
 }
 
-void ResourceManager::unloadAll()
+size_t ResourceManager::unloadAll(size_t keepRAMBytes)
 {
+	size_t ramBudget = keepRAMBytes;
 	auto iter = mReloadables.cbegin();
 	while(iter != mReloadables.cend())
 	{
@@ -104,12 +105,14 @@ void ResourceManager::unloadAll()
 
 		if (!info->data.expired())
 		{
-			info->reload = info->data.lock()->unload();
+			info->reload = keepRAMBytes > 0 ? info->data.lock()->unloadVRAM(ramBudget) : info->data.lock()->unload();
 			iter++;
 		}
 		else
 			iter = mReloadables.erase(iter);
 	}
+
+	return keepRAMBytes - ramBudget;
 }
 
 void ResourceManager::reloadAll()
@@ -2,6 +2,7 @@
 #ifndef ES_CORE_RESOURCES_RESOURCE_MANAGER_H
 #define ES_CORE_RESOURCES_RESOURCE_MANAGER_H
 
+#include <cstddef>
 #include <list>
 #include <memory>
 #include <string>
@@ -23,6 +24,10 @@ class IReloadable
 public:
 	virtual bool unload() = 0;
 	virtual void reload() = 0;
+
+	// RetroPangui: like unload(), but a resource may keep its decoded data in RAM if it fits in ramBudget
+	// (subtracting what it keeps) so reload() only has to upload it again
+	virtual bool unloadVRAM(size_t& /*ramBudget*/) { return unload(); }
 };
 
 class ResourceManager
@@ -32,7 +37,8 @@ public:
 
 	void addReloadable(std::weak_ptr<IReloadable> reloadable);
 
-	void unloadAll();
+	// keepRAMBytes > 0: decoded data up to that size stays in RAM (see IReloadable::unloadVRAM), returns the kept size
+	size_t unloadAll(size_t keepRAMBytes = 0);
 	void reloadAll();
 
 	std::string getResourcePath(const std::string& path) const;
@@ -231,6 +231,12 @@ void TextureData::setSourceSize(float width, float height)
 	}
 }
 
+size_t TextureData::getRAMUsage()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	return mDataRGBA ? mWidth * mHeight * 4 : 0;
+}
+
 size_t TextureData::getVRAMUsage()
 {
 	if ((mTextureID != 0) || (mDataRGBA != nullptr))
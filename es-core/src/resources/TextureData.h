@@ -39,6 +39,9 @@ public:
 	// Get the amount of VRAM currenty used by this texture
 	size_t getVRAMUsage();
 
+	// Size of the decoded pixels held in RAM, 0 if there are none
+	size_t getRAMUsage();
+
 	size_t width();
 	size_t height();
 	float sourceWidth();
@@ -219,13 +219,43 @@ bool TextureResource::unload()
 	return false;
 }
 
+bool TextureResource::unloadVRAM(size_t& ramBudget)
+{
+	std::shared_ptr<TextureData> data;
+	if (mTextureData == nullptr)
+		data = sTextureDataManager.get(this, false);
+	else
+		data = mTextureData;
+
+	if (data == nullptr || !data->isLoaded())
+		return false;
+
+	data->releaseVRAM();
+
+	const size_t ramUsage = data->getRAMUsage();
+	if (ramUsage > 0 && ramUsage <= ramBudget)
+		ramBudget -= ramUsage;
+	else
+		data->releaseRAM();
+
+	return true;
+}
+
 void TextureResource::reload()
 {
+	// RetroPangui: unloadVRAM()이 RAM에 남겨 둔 픽셀은 디코딩 없이 바로 VRAM으로 - reloadAll()이
+	// 모든 텍스처에 대해 한 번에 부르므로 복귀 후 첫 프레임이 텍스처를 하나씩 올리며 멈추지 않음
+	std::shared_ptr<TextureData> data = mTextureData ? mTextureData : sTextureDataManager.get(this, false);
+	const bool keptInRAM = data != nullptr && data->getRAMUsage() > 0;
+
 	// For dynamically loaded textures the texture manager will load them on demand.
 	// For manually loaded textures we have to reload them here
 	if (mTextureData && !mTextureData->isLoaded())
 		mTextureData->load();
 
+	if (keptInRAM)
+		data->uploadAndBind();
+
 	// Uncomment this 2 lines in future release in order to reload texture VRAM exactly as it was before
 	// This is commented because it needs true images async loading, or it will be very long
 
@@ -38,6 +38,7 @@ public:
 protected:
 	TextureResource(const std::string& path, bool tile, bool dynamic);
 	virtual bool unload();
+	virtual bool unloadVRAM(size_t& ramBudget) override;
 	virtual void reload();
 
 private:
@@ -620,6 +620,7 @@ namespace Utils
 
 		bool createDirectory(const std::string& _path)
 		{
+			const std::unique_lock<std::recursive_mutex> lock(mutex);
 			const std::string path = getGenericPath(_path);
 
 			// don't create if it already exists
@@ -0,0 +1,217 @@
+#include "utils/HashUtil.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace Utils
+{
+	namespace Hash
+	{
+		static const unsigned int md5Shifts[64] =
+		{
+			7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+			5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20, 5,  9, 14, 20,
+			4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+			6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+		};
+
+		static const unsigned int md5Constants[64] =
+		{
+			0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+			0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+			0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+			0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+			0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+			0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+			0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+			0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+		};
+
+//////////////////////////////////////////////////////////////////////////
+
+		MD5::MD5() : mLength(0), mFinished(false)
+		{
+			mState[0] = 0x67452301;
+			mState[1] = 0xefcdab89;
+			mState[2] = 0x98badcfe;
+			mState[3] = 0x10325476;
+
+		} // MD5
+
+//////////////////////////////////////////////////////////////////////////
+
+		void MD5::update(const void* _data, size_t _size)
+		{
+			const unsigned char* data   = (const unsigned char*)_data;
+			size_t               offset = (size_t)(mLength % 64);
+
+			mLength += _size;
+
+			// fill up a partial block first
+			if(offset)
+			{
+				const size_t fill = (_size < 64 - offset) ? _size : 64 - offset;
+				memcpy(mBuffer + offset, data, fill);
+				data  += fill;
+				_size -= fill;
+
+				if(offset + fill < 64)
+					return;
+
+				transform(mBuffer);
+			}
+
+			for(; _size >= 64; data += 64, _size -= 64)
+				transform(data);
+
+			if(_size)
+				memcpy(mBuffer, data, _size);
+
+		} // update
+
+//////////////////////////////////////////////////////////////////////////
+
+		std::string MD5::getHex()
+		{
+			if(!mFinished)
+			{
+				const unsigned long long bits = mLength * 8;
+				unsigned char            padding[72] = { 0x80 };
+				const size_t             offset      = (size_t)(mLength % 64);
+				const size_t             padSize     = (offset < 56) ? (56 - offset) : (120 - offset);
+
+				for(int i = 0; i < 8; ++i)
+					padding[padSize + i] = (unsigned char)(bits >> (i * 8));
+
+				update(padding, padSize + 8);
+				mFinished = true;
+			}
+
+			char hex[33];
+			for(int i = 0; i < 16; ++i)
+				snprintf(hex + i * 2, 3, "%02x", (mState[i / 4] >> ((i % 4) * 8)) & 0xff);
+
+			return std::string(hex, 32);
+
+		} // getHex
+
+//////////////////////////////////////////////////////////////////////////
+
+		void MD5::transform(const unsigned char* _block)
+		{
+			unsigned int words[16];
+			for(int i = 0; i < 16; ++i)
+				words[i] = _block[i * 4] | (_block[i * 4 + 1] << 8) | (_block[i * 4 + 2] << 16) | ((unsigned int)_block[i * 4 + 3] << 24);
+
+			unsigned int a = mState[0];
+			unsigned int b = mState[1];
+			unsigned int c = mState[2];
+			unsigned int d = mState[3];
+
+			for(unsigned int i = 0; i < 64; ++i)
+			{
+				unsigned int f;
+				unsigned int g;
+
+				if(i < 16)      { f = (b & c) | (~b & d); g = i;                }
+				else if(i < 32) { f = (d & b) | (~d & c); g = (5 * i + 1) % 16; }
+				else if(i < 48) { f = b ^ c ^ d;          g = (3 * i + 5) % 16; }
+				else            { f = c ^ (b | ~d);       g = (7 * i) % 16;     }
+
+				const unsigned int rotate = a + f + md5Constants[i] + words[g];
+				a = d;
+				d = c;
+				c = b;
+				b = b + ((rotate << md5Shifts[i]) | (rotate >> (32 - md5Shifts[i])));
+			}
+
+			mState[0] += a;
+			mState[1] += b;
+			mState[2] += c;
+			mState[3] += d;
+
+		} // transform
+
+//////////////////////////////////////////////////////////////////////////
+
+		unsigned int crc32(const void* _data, size_t _size, unsigned int _crc)
+		{
+			// built once on first use, function-local statics are thread safe
+			static const struct Table
+			{
+				Table()
+				{
+					for(unsigned int i = 0; i < 256; ++i)
+					{
+						unsigned int value = i;
+						for(int bit = 0; bit < 8; ++bit)
+							value = (value & 1) ? (0xEDB88320 ^ (value >> 1)) : (value >> 1);
+						values[i] = value;
+					}
+				}
+
+				unsigned int values[256];
+
+			} table;
+
+			const unsigned char* data = (const unsigned char*)_data;
+			unsigned int         crc  = ~_crc;
+
+			for(size_t i = 0; i < _size; ++i)
+				crc = table.values[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+
+			return ~crc;
+
+		} // crc32
+
+//////////////////////////////////////////////////////////////////////////
+
+		std::string crc32ToHex(const unsigned int _crc)
+		{
+			char hex[9];
+			snprintf(hex, sizeof(hex), "%08X", _crc);
+
+			return std::string(hex, 8);
+
+		} // crc32ToHex
+
+//////////////////////////////////////////////////////////////////////////
+
+		bool hashFile(const std::string& _path, unsigned int& _crc32, std::string& _md5, unsigned long long& _size)
+		{
+			FILE* file = fopen(_path.c_str(), "rb");
+			if(file == nullptr)
+				return false;
+
+			MD5           md5;
+			unsigned int  crc  = 0;
+			unsigned char buffer[64 * 1024];
+			size_t        read;
+
+			_size = 0;
+
+			while((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+			{
+				crc = crc32(buffer, read, crc);
+				md5.update(buffer, read);
+				_size += read;
+			}
+
+			const bool ok = (ferror(file) == 0);
+			fclose(file);
+
+			if(!ok)
+				return false;
+
+			_crc32 = crc;
+			_md5   = md5.getHex();
+
+			return true;
+
+		} // hashFile
+
+	} // Hash::
+
+} // Utils::
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef ES_CORE_UTILS_HASH_UTIL_H
+#define ES_CORE_UTILS_HASH_UTIL_H
+
+#include <stddef.h>
+#include <string>
+
+namespace Utils
+{
+	namespace Hash
+	{
+		// incremental md5 (RFC 1321), getHex() finishes the digest
+		class MD5
+		{
+		public:
+			MD5();
+
+			void        update(const void* _data, size_t _size);
+			std::string getHex();
+
+		private:
+			void transform(const unsigned char* _block);
+
+			unsigned int       mState[4];
+			unsigned long long mLength;
+			unsigned char      mBuffer[64];
+			bool               mFinished;
+
+		}; // MD5
+
+		unsigned int crc32      (const void* _data, size_t _size, unsigned int _crc = 0);
+		std::string  crc32ToHex (const unsigned int _crc);
+		// reads the file once and computes both hashes, returns false if it can't be read
+		bool         hashFile   (const std::string& _path, unsigned int& _crc32, std::string& _md5, unsigned long long& _size);
+
+	} // Hash::
+
+} // Utils::
+
+#endif // ES_CORE_UTILS_HASH_UTIL_H